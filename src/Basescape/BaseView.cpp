@@ -557,7 +557,7 @@ void BaseView::draw()
 		{
 			if (craftIt != _base->getCrafts()->end())
 			{
-				if ((*craftIt)->getStatus() != "STR_OUT")
+				if ((*craftIt)->getStatus() != CS_OUT)
 				{
 					Surface *frame = _texture->getFrame((*craftIt)->getSkinSprite() + 33);
 					int fx = (fac->getX() * GRID_SIZE + (fac->getRules()->getSize() - 1) * GRID_SIZE / 2 + 2);
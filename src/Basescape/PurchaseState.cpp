@@ -158,6 +158,7 @@ PurchaseState::PurchaseState(Base *base, CannotReequipState *parent) : _base(bas
 	_lstItems->setArrowColumn(227, ARROW_VERTICAL);
 	_lstItems->setColumns(4, 150, 55, 50, 32);
 	_lstItems->setSelectable(true);
+	_lstItems->setVirtual(true);
 	_lstItems->setBackground(_window);
 	_lstItems->setMargin(2);
 	_lstItems->onLeftArrowPress((ActionHandler)&PurchaseState::lstItemsLeftArrowPress);
@@ -761,7 +762,7 @@ void PurchaseState::btnOkClick(Action *)
 					t = new Transfer(rule->getTransferTime());
 					Craft *craft = new Craft(rule, _base, _game->getSavedGame()->getId(rule->getType()));
 					craft->initFixedWeapons(_game->getMod());
-					craft->setStatus("STR_REFUELLING");
+					craft->setStatus(CS_REFUELLING);
 					t->setCraft(craft);
 					_base->getTransfers()->push_back(t);
 				}
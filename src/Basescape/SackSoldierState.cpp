@@ -101,7 +101,7 @@ void SackSoldierState::btnOkClick(Action *)
 	{
 		_base->getStorageItems()->addItem(soldier->getArmor()->getStoreItem()->getType());
 	}
-	_base->getSoldiers()->erase(_base->getSoldiers()->begin() + _soldierId);
+	_base->removeSoldier(_base->getSoldiers()->begin() + _soldierId);
 	delete soldier;
 	_game->popState();
 }
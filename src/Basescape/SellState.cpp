@@ -166,6 +166,7 @@ void SellState::delayedInit()
 	_lstItems->setArrowColumn(182, ARROW_VERTICAL);
 	_lstItems->setColumns(4, 156, 54, 24, 53);
 	_lstItems->setSelectable(true);
+	_lstItems->setVirtual(true);
 	_lstItems->setBackground(_window);
 	_lstItems->setMargin(2);
 	_lstItems->onLeftArrowPress((ActionHandler)&SellState::lstItemsLeftArrowPress);
@@ -195,7 +196,7 @@ void SellState::delayedInit()
 	for (auto* craft : *_base->getCrafts())
 	{
 		if (_debriefingState) break;
-		if (craft->getStatus() != "STR_OUT")
+		if (craft->getStatus() != CS_OUT)
 		{
 			TransferRow row = { TRANSFER_CRAFT, craft, craft->getName(_game->getLanguage()), craft->getRules()->getSellCost(), 1, 0, 0, -3, 0, 0, craft->getRules()->getSellCost() };
 			_items.push_back(row);
@@ -676,7 +677,7 @@ void SellState::btnOkClick(Action *)
 						{
 							_base->getStorageItems()->addItem(tmpSoldier->getArmor()->getStoreItem()->getType());
 						}
-						_base->getSoldiers()->erase(soldierIt);
+						_base->removeSoldier(soldierIt);
 						break;
 					}
 				}
@@ -243,7 +243,7 @@ void SoldierTransformationListState::initList()
 		int eligibleSoldiers = 0;
 		for (const auto* soldier : *_base->getSoldiers())
 		{
-			if (soldier->getCraft() && soldier->getCraft()->getStatus() == "STR_OUT")
+			if (soldier->getCraft() && soldier->getCraft()->getStatus() == CS_OUT)
 			{
 				// soldiers outside of the base are not eligible
 				continue;
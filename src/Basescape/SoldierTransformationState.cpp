@@ -503,7 +503,7 @@ void SoldierTransformationState::performTransformation()
 			auto it = find(_game->getSavedGame()->getDeadSoldiers()->begin(), _game->getSavedGame()->getDeadSoldiers()->end(), _sourceSoldier);
 			if (it != _game->getSavedGame()->getDeadSoldiers()->end())
 			{
-				_game->getSavedGame()->getDeadSoldiers()->erase(it);
+				_game->getSavedGame()->removeDeadSoldier(it);
 			}
 		}
 		else if (_transformationRule->getTransferTime() > 0)
@@ -512,7 +512,7 @@ void SoldierTransformationState::performTransformation()
 			auto it = find(_base->getSoldiers()->begin(), _base->getSoldiers()->end(), _sourceSoldier);
 			if (it != _base->getSoldiers()->end())
 			{
-				_base->getSoldiers()->erase(it);
+				_base->removeSoldier(it);
 			}
 		}
 	}
@@ -538,8 +538,8 @@ void SoldierTransformationState::retire()
 			auto it = find(_game->getSavedGame()->getDeadSoldiers()->begin(), _game->getSavedGame()->getDeadSoldiers()->end(), _sourceSoldier);
 			if (it != _game->getSavedGame()->getDeadSoldiers()->end())
 			{
-				delete (*it);
-				_game->getSavedGame()->getDeadSoldiers()->erase(it);
+				_game->getSavedGame()->removeDeadSoldier(it);
+				delete _sourceSoldier;
 			}
 		}
 		else
@@ -547,8 +547,8 @@ void SoldierTransformationState::retire()
 			auto it = find(_base->getSoldiers()->begin(), _base->getSoldiers()->end(), _sourceSoldier);
 			if (it != _base->getSoldiers()->end())
 			{
-				delete (*it);
-				_base->getSoldiers()->erase(it);
+				_base->removeSoldier(it);
+				delete _sourceSoldier;
 			}
 		}
 	}
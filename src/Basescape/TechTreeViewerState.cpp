@@ -117,18 +117,21 @@ TechTreeViewerState::TechTreeViewerState(const RuleResearch *r, const RuleManufa
 
 	_lstLeft->setColumns(1, 132);
 	_lstLeft->setSelectable(true);
+	_lstLeft->setVirtual(true);
 	_lstLeft->setBackground(_window);
 	_lstLeft->setWordWrap(true);
 	_lstLeft->onMouseClick((ActionHandler)&TechTreeViewerState::onSelectLeftTopic);
 
 	_lstRight->setColumns(1, 132);
 	_lstRight->setSelectable(true);
+	_lstRight->setVirtual(true);
 	_lstRight->setBackground(_window);
 	_lstRight->setWordWrap(true);
 	_lstRight->onMouseClick((ActionHandler)&TechTreeViewerState::onSelectRightTopic);
 
 	_lstFull->setColumns(1, 288);
 	_lstFull->setSelectable(true);
+	_lstFull->setVirtual(true);
 	_lstFull->setBackground(_window);
 	_lstFull->setWordWrap(true);
 	_lstFull->onMouseClick((ActionHandler)&TechTreeViewerState::onSelectFullTopic);
@@ -24,11 +24,14 @@
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/SavedGame.h"
 #include "TileEngine.h"
+#include "AIThreatMap.h"
+#include "../Savegame/UnitGrid.h"
 #include "BattlescapeState.h"
 #include "../Savegame/Tile.h"
 #include "Pathfinding.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Logger.h"
+#include "../Engine/Profiler.h"
 #include "../Engine/Game.h"
 #include "../Mod/Armor.h"
 #include "../Mod/Mod.h"
@@ -64,6 +67,11 @@ AIModule::AIModule(SavedBattleGame *save, BattleUnit *unit, Node *node) :
 	{
 		_targetFaction = FACTION_HOSTILE;
 	}
+	else if (_unit->getFaction() == FACTION_PLAYER && _save->getBattleGame() && _save->getBattleGame()->isPlayerSideAI())
+	{
+		// the AI plays the player side in a headless run
+		_targetFaction = FACTION_HOSTILE;
+	}
 }
 
 /**
@@ -199,6 +207,7 @@ void AIModule::dont_think(BattleAction *action)
  */
 void AIModule::think(BattleAction *action)
 {
+	PROFILE_SCOPE("AIModule::think");
 	action->type = BA_RETHINK;
 	action->actor = _unit;
 	action->weapon = _unit->getMainHandWeapon(false);
@@ -208,6 +217,7 @@ void AIModule::think(BattleAction *action)
 	_attackAction.weapon = action->weapon;
 	_attackAction.number = action->number;
 	_escapeAction.number = action->number;
+	_save->getAIThreatMap()->update();
 	_knownEnemies = countKnownTargets();
 	_visibleEnemies = selectNearestTarget();
 	_spottingEnemies = getSpottingUnits(_unit->getPosition());
@@ -1113,31 +1123,32 @@ int AIModule::countKnownTargets() const
  */
 int AIModule::getSpottingUnits(const Position& pos) const
 {
-	// if we don't actually occupy the position being checked, we need to do a virtual LOF check.
-	bool checking = pos != _unit->getPosition();
 	int tally = 0;
+	// if we don't actually occupy the position being checked, we need to do a virtual LOF check.
+	// those are shared by our whole side, so only filter out the units we don't know about.
+	if (pos != _unit->getPosition())
+	{
+		for (auto* bu : _save->getAIThreatMap()->getSpotters(pos, _unit))
+		{
+			if (validTarget(bu, false, false))
+			{
+				tally++;
+			}
+		}
+		return tally;
+	}
 	for (auto* bu : *_save->getUnits())
 	{
 		if (validTarget(bu, false, false))
 		{
 			int dist = Position::distance2d(pos, bu->getPosition());
-			if (dist > 20) continue;
+			if (dist > AIThreatMap::MAX_DISTANCE) continue;
 			Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(bu);
 			originVoxel.z -= 2;
 			Position targetVoxel;
-			if (checking)
-			{
-				if (_save->getTileEngine()->canTargetUnit(&originVoxel, _save->getTile(pos), &targetVoxel, bu, false, _unit))
-				{
-					tally++;
-				}
-			}
-			else
+			if (_save->getTileEngine()->canTargetUnit(&originVoxel, _save->getTile(pos), &targetVoxel, bu, false))
 			{
-				if (_save->getTileEngine()->canTargetUnit(&originVoxel, _save->getTile(pos), &targetVoxel, bu, false))
-				{
-					tally++;
-				}
+				tally++;
 			}
 		}
 	}
@@ -1155,7 +1166,10 @@ int AIModule::selectNearestTarget()
 	_closestDist= 100;
 	_aggroTarget = 0;
 	Position target;
-	for (auto* bu : *_save->getUnits())
+	// nobody further away than the view distance can be visible
+	std::vector<BattleUnit*> candidates;
+	_save->getUnitGrid()->findInRange(_unit->getPosition(), _save->getBattleGame()->getMod()->getMaxViewDistance(), candidates);
+	for (auto* bu : candidates)
 	{
 		if (validTarget(bu, true, _unit->getFaction() == FACTION_HOSTILE) &&
 			_save->getTileEngine()->visible(_unit, bu->getTile()))
@@ -1209,7 +1223,10 @@ int AIModule::selectNearestTargetLeeroy(bool canRun)
 	int tally = 0;
 	_closestDist = 100;
 	_aggroTarget = 0;
-	for (auto* bu : *_save->getUnits())
+	// nobody further away than the view distance can be visible
+	std::vector<BattleUnit*> candidates;
+	_save->getUnitGrid()->findInRange(_unit->getPosition(), _save->getBattleGame()->getMod()->getMaxViewDistance(), candidates);
+	for (auto* bu : candidates)
 	{
 		if (validTarget(bu, true, _unit->getFaction() == FACTION_HOSTILE) &&
 			_save->getTileEngine()->visible(_unit, bu->getTile()))
@@ -2497,7 +2514,7 @@ bool AIModule::psiAction()
 				// they must be player units
 				bu->getOriginalFaction() == _targetFaction &&
 				(!LOSRequired ||
-				std::find(_unit->getVisibleUnits()->begin(), _unit->getVisibleUnits()->end(), bu) != _unit->getVisibleUnits()->end()))
+				_unit->isOnVisibleUnits(bu)))
 			{
 				BattleUnit *victim = bu;
 				if (item->getRules()->isOutOfRange(_unit->distance3dToUnitSq(victim)))
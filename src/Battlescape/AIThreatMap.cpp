@@ -0,0 +1,207 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "AIThreatMap.h"
+#include <algorithm>
+#include "TileEngine.h"
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Mod/Armor.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty threat map for a battle.
+ * @param save Pointer to the battle.
+ */
+AIThreatMap::AIThreatMap(SavedBattleGame *save) : _save(save), _turn(-1), _side(-1)
+{
+}
+
+/**
+ * Forgets everything calculated so far.
+ */
+void AIThreatMap::clear()
+{
+	_layers.clear();
+	_units.clear();
+}
+
+/**
+ * Starts over when a new turn began, since everyone
+ * else had the chance to move in the meantime.
+ */
+void AIThreatMap::checkTurn()
+{
+	if (_turn != _save->getTurn() || _side != _save->getSide())
+	{
+		clear();
+		_turn = _save->getTurn();
+		_side = _save->getSide();
+	}
+}
+
+/**
+ * Checks all the units for moves and deaths since the last update,
+ * and forgets the tiles each of them could have been a spotter of,
+ * or stood in the line of fire of a spotter for.
+ * Done by the AI before every decision.
+ */
+void AIThreatMap::update()
+{
+	checkTurn();
+	for (auto* bu : *_save->getUnits())
+	{
+		UnitState now = { bu->getPosition(), bu->isOut() };
+		auto i = _units.find(bu);
+		if (i == _units.end())
+		{
+			if (!_layers.empty() && !now.out)
+			{
+				invalidate(now.pos, MAX_DISTANCE);
+			}
+			_units[bu] = now;
+		}
+		else if (i->second.pos != now.pos || i->second.out != now.out)
+		{
+			invalidate(i->second.pos, MAX_DISTANCE);
+			invalidate(now.pos, MAX_DISTANCE);
+			i->second = now;
+		}
+	}
+}
+
+/**
+ * Forgets the tiles near a terrain change, as any line of fire
+ * through it may be different now.
+ * @param pos Center of the change, or TileEngine::invalid for the whole map.
+ * @param radius Radius of the change.
+ */
+void AIThreatMap::terrainChanged(Position pos, int radius)
+{
+	if (pos == TileEngine::invalid)
+	{
+		_layers.clear();
+	}
+	else
+	{
+		invalidate(pos, radius + MAX_DISTANCE);
+	}
+}
+
+/**
+ * Forgets the tiles within range of a position in all the layers.
+ * Even a layer of the unit's own faction changes, as the unit
+ * may block or clear a line of fire from somebody else.
+ * @param pos Center position.
+ * @param radius Radius in tiles.
+ */
+void AIThreatMap::invalidate(Position pos, int radius)
+{
+	const int beginX = std::max(pos.x - radius, 0), endX = std::min(pos.x + radius, _save->getMapSizeX() - 1);
+	const int beginY = std::max(pos.y - radius, 0), endY = std::min(pos.y + radius, _save->getMapSizeY() - 1);
+	for (auto& l : _layers)
+	{
+		Layer &layer = l.second;
+		if (layer.calculated.empty())
+		{
+			continue;
+		}
+		for (int z = 0; z < _save->getMapSizeZ(); ++z)
+		{
+			for (int y = beginY; y <= endY; ++y)
+			{
+				for (int x = beginX; x <= endX; ++x)
+				{
+					int index = _save->getTileIndex(Position(x, y, z));
+					if (layer.calculated[index])
+					{
+						layer.calculated[index] = false;
+						layer.spotters[index].clear();
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Checks which units not on a unit's side could see or fire at
+ * it if it stood on a tile, in the same way AIModule always did.
+ * @param layer Layer to store the result in.
+ * @param pos Position of the tile.
+ * @param index Index of the tile.
+ * @param unit The unit.
+ */
+void AIThreatMap::calculate(Layer &layer, Position pos, int index, BattleUnit *unit)
+{
+	auto& spotters = layer.spotters[index];
+	spotters.clear();
+	for (auto* bu : *_save->getUnits())
+	{
+		if (bu->isOut() ||
+			bu->getFaction() == unit->getFaction() ||
+			(bu->getFaction() != FACTION_PLAYER && bu->isIgnoredByAI()))
+		{
+			continue;
+		}
+		if (Position::distance2d(pos, bu->getPosition()) > MAX_DISTANCE)
+		{
+			continue;
+		}
+		Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(bu);
+		originVoxel.z -= 2;
+		Position targetVoxel;
+		if (_save->getTileEngine()->canTargetUnit(&originVoxel, _save->getTile(pos), &targetVoxel, bu, false, unit))
+		{
+			spotters.push_back(bu);
+		}
+	}
+	layer.calculated[index] = true;
+}
+
+/**
+ * Gets the units not on a unit's side that could see or fire at it
+ * if it stood on a position, calculating it if no unit of the
+ * same faction and shape asked about the position before.
+ * The AI still has to filter out the ones it doesn't know about.
+ * @param pos Position to check.
+ * @param unit The unit.
+ * @return List of units.
+ */
+const std::vector<BattleUnit*> &AIThreatMap::getSpotters(Position pos, BattleUnit *unit)
+{
+	checkTurn();
+	// the line of fire checks depend on the faction and the shape of the unit
+	LayerKey key(unit->getFaction(), unit->getArmor(), unit->getHeight(), unit->getFloatHeight());
+	Layer &layer = _layers[key];
+	if (layer.calculated.empty())
+	{
+		layer.calculated.resize(_save->getMapSizeXYZ(), false);
+		layer.spotters.resize(_save->getMapSizeXYZ());
+	}
+	int index = _save->getTileIndex(pos);
+	if (!layer.calculated[index])
+	{
+		calculate(layer, pos, index, unit);
+	}
+	return layer.spotters[index];
+}
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <SDL_types.h>
+#include "Position.h"
+
+namespace OpenXcom
+{
+
+class SavedBattleGame;
+class BattleUnit;
+class Armor;
+
+/**
+ * Remembers which hostile units could see or fire at each tile,
+ * so all the AI units of a side share the line of fire checks they
+ * use to score positions, instead of repeating them for every unit.
+ * A tile is calculated the first time it's asked about in a turn,
+ * and forgotten again when a possible spotter nearby moves or dies,
+ * or the terrain around it changes.
+ * Units of the same faction and shape share the results, so the
+ * body of the unit that asked first may decide a few lines of fire
+ * for the others too; good enough for an AI heuristic.
+ */
+class AIThreatMap
+{
+private:
+	/// The spotters of each tile for units of one faction and shape.
+	struct Layer
+	{
+		std::vector<bool> calculated;
+		std::vector<std::vector<BattleUnit*> > spotters;
+	};
+	/// Where a unit was when the map was last updated.
+	struct UnitState
+	{
+		Position pos;
+		bool out;
+	};
+
+	SavedBattleGame *_save;
+	int _turn, _side;
+	/// Faction, armor (size and line of fire templates), height and float height.
+	typedef std::tuple<int, const Armor*, int, int> LayerKey;
+	std::map<LayerKey, Layer> _layers;
+	std::unordered_map<const BattleUnit*, UnitState> _units;
+
+	/// Starts over if a new turn began.
+	void checkTurn();
+	/// Forgets the tiles within range of a position.
+	void invalidate(Position pos, int radius);
+	/// Calculates the spotters of a tile.
+	void calculate(Layer &layer, Position pos, int index, BattleUnit *unit);
+public:
+	/// How far away units can be to count as spotters.
+	static const int MAX_DISTANCE = 20;
+	/// Creates an empty threat map.
+	AIThreatMap(SavedBattleGame *save);
+	/// Forgets the tiles affected by units moving or dying since the last update.
+	void update();
+	/// Forgets the tiles affected by a terrain change.
+	void terrainChanged(Position pos, int radius);
+	/// Gets the units that could see or fire at a unit if it stood on a position.
+	const std::vector<BattleUnit*> &getSpotters(Position pos, BattleUnit *unit);
+	/// Forgets everything.
+	void clear();
+};
+
+}
@@ -26,6 +26,7 @@
 #include "../Engine/Action.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "BattlescapeGame.h"
+#include "BattleReplay.h"
 #include "BattlescapeState.h"
 #include "../Engine/Options.h"
 #include "../Mod/AlienDeployment.h"
@@ -215,6 +216,7 @@ void AbortMissionState::btnOkClick(Action *)
 	}
 
 	_game->popState();
+	_battleGame->getBattleGame()->recordCommand(RC_ABORT);
 	_battleGame->setAborted(true);
 	_state->finishBattle(true, _inExit);
 }
@@ -0,0 +1,407 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattleReplay.h"
+#include <yaml-cpp/yaml.h>
+#include "AbortMissionState.h"
+#include "BattlescapeGame.h"
+#include "BattlescapeState.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Game.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Mod/Mod.h"
+#include "../Mod/RuleSkill.h"
+#include "../Savegame/BattleItem.h"
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SavedGame.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+BattleUnit *findUnit(SavedBattleGame *save, int id)
+{
+	for (auto* unit : *save->getUnits())
+	{
+		if (unit->getId() == id)
+			return unit;
+	}
+	return nullptr;
+}
+
+BattleItem *findItem(SavedBattleGame *save, int id)
+{
+	for (auto* item : *save->getItems())
+	{
+		if (item->getId() == id)
+			return item;
+	}
+	return nullptr;
+}
+
+}
+
+/**
+ * Creates an empty replay.
+ */
+BattleReplay::BattleReplay() : _playing(false), _seed(0), _nextCommand(0), _nextChecksum(0)
+{
+}
+
+/**
+ * Starts recording the battle currently being played,
+ * by saving it to the user folder along with the RNG seed.
+ * @param game Pointer to the core game.
+ * @return True if the battle could be saved.
+ */
+bool BattleReplay::startRecording(Game *game)
+{
+	_name = "replay_" + CrossPlatform::now();
+	_seed = RNG::getSeed();
+	try
+	{
+		game->getSavedGame()->save(getSaveName(), game->getMod());
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_WARNING) << "Battle won't be recorded: " << e.what();
+		return false;
+	}
+	Log(LOG_INFO) << "Recording battle to " << _name << ".replay";
+	save();
+	return true;
+}
+
+/**
+ * Loads a recorded battle for playback.
+ * @param name Name of the replay in the user folder, with or without extension.
+ */
+void BattleReplay::load(const std::string &name)
+{
+	_name = CrossPlatform::compareExt(name, "replay") ? CrossPlatform::noExt(name) : name;
+	YAML::Node doc = YAML::Load(*CrossPlatform::readFile(Options::getMasterUserFolder() + _name + ".replay"));
+	_playing = true;
+	_seed = doc["seed"].as<Uint64>();
+	for (const auto& c : doc["commands"])
+	{
+		ReplayCommand cmd;
+		cmd.type = (ReplayCommandType)c["type"].as<int>();
+		cmd.turn = c["turn"].as<int>();
+		cmd.pos = c["pos"].as<Position>(cmd.pos);
+		cmd.dir = c["dir"].as<int>(cmd.dir);
+		cmd.unit = c["unit"].as<int>(cmd.unit);
+		cmd.actor = c["actor"].as<int>(cmd.actor);
+		cmd.weapon = c["weapon"].as<int>(cmd.weapon);
+		cmd.action = (BattleActionType)c["action"].as<int>(cmd.action);
+		cmd.skill = c["skill"].as<std::string>(cmd.skill);
+		cmd.target = c["target"].as<Position>(cmd.target);
+		cmd.waypoints = c["waypoints"].as<std::list<Position> >(cmd.waypoints);
+		if (const YAML::Node &cost = c["cost"])
+		{
+			cmd.cost.Time = cost[0].as<int>();
+			cmd.cost.Energy = cost[1].as<int>();
+			cmd.cost.Morale = cost[2].as<int>();
+			cmd.cost.Health = cost[3].as<int>();
+			cmd.cost.Stun = cost[4].as<int>();
+			cmd.cost.Mana = cost[5].as<int>();
+		}
+		cmd.value = c["value"].as<int>(cmd.value);
+		cmd.targeting = c["targeting"].as<bool>(cmd.targeting);
+		cmd.sprayTargeting = c["sprayTargeting"].as<bool>(cmd.sprayTargeting);
+		cmd.strafe = c["strafe"].as<bool>(cmd.strafe);
+		cmd.run = c["run"].as<bool>(cmd.run);
+		cmd.sneak = c["sneak"].as<bool>(cmd.sneak);
+		cmd.kneel = c["kneel"].as<bool>(cmd.kneel);
+		cmd.reserved = (BattleActionType)c["reserved"].as<int>(cmd.reserved);
+		cmd.kneelReserved = c["kneelReserved"].as<bool>(cmd.kneelReserved);
+		cmd.ctrl = c["ctrl"].as<bool>(cmd.ctrl);
+		cmd.alt = c["alt"].as<bool>(cmd.alt);
+		cmd.shift = c["shift"].as<bool>(cmd.shift);
+		_commands.push_back(cmd);
+	}
+	for (const auto& c : doc["checksums"])
+	{
+		_checksums.push_back(std::make_pair(c["turn"].as<int>(), c["checksum"].as<std::string>()));
+	}
+}
+
+/**
+ * Saves the recorded commands and checksums so far
+ * to the user folder, next to the battle save.
+ */
+void BattleReplay::save() const
+{
+	YAML::Node doc;
+	doc["save"] = getSaveName();
+	doc["seed"] = _seed;
+	for (const auto& cmd : _commands)
+	{
+		// only what differs from the defaults, to keep the file readable
+		const ReplayCommand def;
+		YAML::Node c;
+		c.SetStyle(YAML::EmitterStyle::Flow);
+		c["type"] = (int)cmd.type;
+		c["turn"] = cmd.turn;
+		if (cmd.type == RC_PRIMARY || cmd.type == RC_SECONDARY)
+			c["pos"] = cmd.pos;
+		if (cmd.type == RC_MOVE_UP_DOWN)
+			c["dir"] = cmd.dir;
+		if (cmd.unit != def.unit)
+			c["unit"] = cmd.unit;
+		if (cmd.actor != def.actor)
+			c["actor"] = cmd.actor;
+		if (cmd.weapon != def.weapon)
+			c["weapon"] = cmd.weapon;
+		if (cmd.action != def.action)
+			c["action"] = (int)cmd.action;
+		if (!cmd.skill.empty())
+			c["skill"] = cmd.skill;
+		if (cmd.target != def.target)
+			c["target"] = cmd.target;
+		if (!cmd.waypoints.empty())
+			c["waypoints"] = cmd.waypoints;
+		c["cost"].push_back(cmd.cost.Time);
+		c["cost"].push_back(cmd.cost.Energy);
+		c["cost"].push_back(cmd.cost.Morale);
+		c["cost"].push_back(cmd.cost.Health);
+		c["cost"].push_back(cmd.cost.Stun);
+		c["cost"].push_back(cmd.cost.Mana);
+		if (cmd.value != def.value)
+			c["value"] = cmd.value;
+		if (cmd.targeting)
+			c["targeting"] = true;
+		if (cmd.sprayTargeting)
+			c["sprayTargeting"] = true;
+		if (cmd.strafe)
+			c["strafe"] = true;
+		if (cmd.run)
+			c["run"] = true;
+		if (cmd.sneak)
+			c["sneak"] = true;
+		if (cmd.kneel)
+			c["kneel"] = true;
+		if (cmd.reserved != def.reserved)
+			c["reserved"] = (int)cmd.reserved;
+		if (cmd.kneelReserved)
+			c["kneelReserved"] = true;
+		if (cmd.ctrl)
+			c["ctrl"] = true;
+		if (cmd.alt)
+			c["alt"] = true;
+		if (cmd.shift)
+			c["shift"] = true;
+		doc["commands"].push_back(c);
+	}
+	for (const auto& checksum : _checksums)
+	{
+		YAML::Node c;
+		c["turn"] = checksum.first;
+		c["checksum"] = checksum.second;
+		doc["checksums"].push_back(c);
+	}
+	YAML::Emitter out;
+	out << doc;
+	std::string filepath = Options::getMasterUserFolder() + _name + ".replay";
+	if (!CrossPlatform::writeFile(filepath, out.c_str()))
+	{
+		Log(LOG_WARNING) << "Failed to save " << filepath;
+	}
+}
+
+/**
+ * Records a command given by the player, together with the state
+ * the UI left the current action in. Does nothing during playback.
+ * @param type Type of command.
+ * @param battleGame Pointer to the battlescape game.
+ * @param pos Position clicked on the map, if any.
+ * @param dir Direction to move in, for up/down commands.
+ */
+void BattleReplay::record(ReplayCommandType type, BattlescapeGame *battleGame, Position pos, int dir)
+{
+	if (_playing)
+	{
+		return;
+	}
+	SavedBattleGame *battle = battleGame->getSave();
+	const BattleAction *action = battleGame->getCurrentAction();
+	ReplayCommand cmd;
+	cmd.type = type;
+	cmd.turn = battle->getTurn();
+	cmd.pos = pos;
+	cmd.dir = dir;
+	cmd.unit = battle->getSelectedUnit() ? battle->getSelectedUnit()->getId() : -1;
+	cmd.actor = action->actor ? action->actor->getId() : -1;
+	cmd.weapon = action->weapon ? action->weapon->getId() : -1;
+	cmd.action = action->type;
+	cmd.skill = action->skillRules ? action->skillRules->getType() : "";
+	cmd.target = action->target;
+	cmd.waypoints = action->waypoints;
+	cmd.cost = *action;
+	cmd.value = action->value;
+	cmd.targeting = action->targeting;
+	cmd.sprayTargeting = action->sprayTargeting;
+	cmd.strafe = action->strafe;
+	cmd.run = action->run;
+	cmd.sneak = action->sneak;
+	cmd.kneel = action->kneel;
+	cmd.reserved = battle->getTUReserved();
+	cmd.kneelReserved = battle->getKneelReserved();
+	cmd.ctrl = battle->isCtrlPressed(true);
+	cmd.alt = battle->isAltPressed(true);
+	cmd.shift = battle->isShiftPressed(true);
+	_commands.push_back(cmd);
+}
+
+/**
+ * Takes a checksum of the battle state. When recording it's stored,
+ * during playback it's compared against the recorded one.
+ * @param battle Pointer to the battle.
+ */
+void BattleReplay::checkpoint(SavedBattleGame *battle)
+{
+	std::string checksum = battle->getChecksum();
+	if (!_playing)
+	{
+		_checksums.push_back(std::make_pair(battle->getTurn(), checksum));
+		save();
+		return;
+	}
+	if (!_mismatch.empty())
+	{
+		return;
+	}
+	if (_nextChecksum >= _checksums.size())
+	{
+		_mismatch = "Battle went on past the end of the recording, on turn " + std::to_string(battle->getTurn());
+	}
+	else if (_checksums[_nextChecksum].first != battle->getTurn())
+	{
+		_mismatch = "Expected turn " + std::to_string(_checksums[_nextChecksum].first) + " but reached turn " + std::to_string(battle->getTurn());
+	}
+	else if (_checksums[_nextChecksum].second != checksum)
+	{
+		_mismatch = "Checksum mismatch on turn " + std::to_string(battle->getTurn()) + ": recorded " + _checksums[_nextChecksum].second + ", played " + checksum;
+	}
+	else
+	{
+		_nextChecksum++;
+	}
+}
+
+/**
+ * Gets the next command waiting to be played back.
+ * @return Pointer to the command, or null if there are no more.
+ */
+const ReplayCommand *BattleReplay::getNextCommand() const
+{
+	return _nextCommand < _commands.size() ? &_commands[_nextCommand] : nullptr;
+}
+
+/**
+ * Plays back the next command: puts the UI state back the way
+ * it was when the command was recorded, then calls the same
+ * battlescape code the player's input did.
+ * @param battleGame Pointer to the battlescape game.
+ */
+void BattleReplay::playNextCommand(BattlescapeGame *battleGame)
+{
+	const ReplayCommand &cmd = _commands[_nextCommand++];
+	SavedBattleGame *battle = battleGame->getSave();
+	BattlescapeState *state = battle->getBattleState();
+	Game *game = state->getGame();
+
+	battle->setSelectedUnit(findUnit(battle, cmd.unit));
+	BattleAction *action = battleGame->getCurrentAction();
+	action->type = cmd.action;
+	action->actor = findUnit(battle, cmd.actor);
+	action->weapon = findItem(battle, cmd.weapon);
+	action->skillRules = cmd.skill.empty() ? nullptr : game->getMod()->getSkill(cmd.skill, true);
+	action->target = cmd.target;
+	action->waypoints = cmd.waypoints;
+	static_cast<RuleItemUseCost&>(*action) = cmd.cost;
+	action->value = cmd.value;
+	action->targeting = cmd.targeting;
+	action->sprayTargeting = cmd.sprayTargeting;
+	action->strafe = cmd.strafe;
+	action->run = cmd.run;
+	action->sneak = cmd.sneak;
+	action->kneel = cmd.kneel;
+	battleGame->setTUReserved(cmd.reserved);
+	battleGame->setKneelReserved(cmd.kneelReserved);
+	game->setCtrlPressedFlag(cmd.ctrl);
+	game->setAltPressedFlag(cmd.alt);
+	game->setShiftPressedFlag(cmd.shift);
+
+	switch (cmd.type)
+	{
+	case RC_PRIMARY:
+		battleGame->primaryAction(cmd.pos);
+		break;
+	case RC_SECONDARY:
+		battleGame->secondaryAction(cmd.pos);
+		break;
+	case RC_LAUNCH:
+		battleGame->launchAction();
+		break;
+	case RC_PSI:
+		battleGame->psiButtonAction();
+		break;
+	case RC_NON_TARGET:
+		battleGame->handleNonTargetAction();
+		break;
+	case RC_KNEEL:
+		battleGame->kneel(battle->getSelectedUnit());
+		break;
+	case RC_MOVE_UP_DOWN:
+		battleGame->cancelAllActions();
+		battleGame->moveUpDown(battle->getSelectedUnit(), cmd.dir);
+		break;
+	case RC_END_TURN:
+		battleGame->requestEndTurn(false);
+		break;
+	case RC_ABORT:
+		{
+			AbortMissionState *abort = new AbortMissionState(battle, state);
+			game->pushState(abort);
+			abort->btnOkClick(0);
+		}
+		break;
+	}
+
+	game->setCtrlPressedFlag(false);
+	game->setAltPressedFlag(false);
+	game->setShiftPressedFlag(false);
+}
+
+/**
+ * Checks if every recorded command has been played back
+ * and every recorded checksum verified.
+ * @return True if the replay is over.
+ */
+bool BattleReplay::isFinished() const
+{
+	return _nextCommand >= _commands.size() && _nextChecksum >= _checksums.size();
+}
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <list>
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+#include "Position.h"
+#include "../Mod/RuleItem.h"
+
+namespace OpenXcom
+{
+
+class BattlescapeGame;
+class Game;
+class SavedBattleGame;
+
+enum ReplayCommandType : int { RC_PRIMARY, RC_SECONDARY, RC_LAUNCH, RC_PSI, RC_NON_TARGET, RC_KNEEL, RC_MOVE_UP_DOWN, RC_END_TURN, RC_ABORT };
+
+/**
+ * A command the player gave on the battlescape, along with
+ * everything the UI had set up for it (selected unit, action
+ * chosen in the menus, reserved TUs, modifier keys).
+ */
+struct ReplayCommand
+{
+	ReplayCommandType type = RC_PRIMARY;
+	int turn = 0;
+	Position pos;
+	int dir = 0;
+	int unit = -1, actor = -1, weapon = -1;
+	BattleActionType action = BA_NONE;
+	std::string skill;
+	Position target;
+	std::list<Position> waypoints;
+	RuleItemUseCost cost;
+	int value = 0;
+	bool targeting = false, sprayTargeting = false;
+	bool strafe = false, run = false, sneak = false, kneel = false;
+	BattleActionType reserved = BA_NONE;
+	bool kneelReserved = false;
+	bool ctrl = false, alt = false, shift = false;
+};
+
+/**
+ * Records the commands given by the player during a battle, so it
+ * can be played again later without a display at full speed.
+ * A recording consists of a regular save of the battle's start,
+ * the RNG seed and the commands, plus checksums of the battle state
+ * at the start of every player turn. On playback, the same checksums
+ * must come out, otherwise something in the battle isn't deterministic.
+ */
+class BattleReplay
+{
+private:
+	std::string _name;
+	bool _playing;
+	Uint64 _seed;
+	std::vector<ReplayCommand> _commands;
+	std::vector<std::pair<int, std::string> > _checksums;
+	size_t _nextCommand, _nextChecksum;
+	std::string _mismatch;
+public:
+	/// Creates an empty replay.
+	BattleReplay();
+	/// Starts recording the current battle.
+	bool startRecording(Game *game);
+	/// Loads a replay for playback.
+	void load(const std::string &name);
+	/// Saves the replay.
+	void save() const;
+	/// Is the replay being played back?
+	bool isPlaying() const { return _playing; }
+	/// Gets the name of the battle save the replay starts from.
+	std::string getSaveName() const { return _name + ".sav"; }
+	/// Gets the RNG seed the battle starts with.
+	Uint64 getSeed() const { return _seed; }
+	/// Records a player command.
+	void record(ReplayCommandType type, BattlescapeGame *battleGame, Position pos = Position(), int dir = 0);
+	/// Records or verifies the battle state.
+	void checkpoint(SavedBattleGame *battle);
+	/// Gets the next command to play back.
+	const ReplayCommand *getNextCommand() const;
+	/// Plays back the next command.
+	void playNextCommand(BattlescapeGame *battleGame);
+	/// Has everything recorded been played back?
+	bool isFinished() const;
+	/// Gets the number of commands.
+	size_t getCommandCount() const { return _commands.size(); }
+	/// Gets the number of checksums verified so far.
+	size_t getVerifiedCount() const { return _nextChecksum; }
+	/// Gets the first checksum mismatch found during playback.
+	const std::string &getMismatch() const { return _mismatch; }
+};
+
+}
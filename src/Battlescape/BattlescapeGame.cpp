@@ -18,6 +18,7 @@
  */
 #include <sstream>
 #include "BattlescapeGame.h"
+#include "BattleReplay.h"
 #include "BattlescapeState.h"
 #include "Map.h"
 #include "Camera.h"
@@ -178,7 +179,7 @@ bool BattleActionCost::spendTU(std::string *message)
 BattlescapeGame::BattlescapeGame(SavedBattleGame *save, BattlescapeState *parentState) :
 	_save(save), _parentState(parentState),
 	_playerPanicHandled(true), _AIActionCounter(0), _AISecondMove(false), _playedAggroSound(false),
-	_endTurnRequested(false), _endConfirmationHandled(false), _allEnemiesNeutralized(false)
+	_endTurnRequested(false), _endConfirmationHandled(false), _allEnemiesNeutralized(false), _playerSideAI(false), _replay(0)
 {
 	if (_save->isPreview())
 	{
@@ -209,6 +210,30 @@ BattlescapeGame::~BattlescapeGame()
 	cleanupDeleted();
 }
 
+/**
+ * Sets the recording or playback of this battle.
+ * It's owned by whoever started it.
+ * @param replay Pointer to the replay, or null for none.
+ */
+void BattlescapeGame::setReplay(BattleReplay *replay)
+{
+	_replay = replay;
+}
+
+/**
+ * Records a command given by the player, if the battle is being recorded.
+ * @param type Type of command.
+ * @param pos Position clicked on the map, if any.
+ * @param dir Direction to move in, for up/down commands.
+ */
+void BattlescapeGame::recordCommand(ReplayCommandType type, Position pos, int dir)
+{
+	if (_replay)
+	{
+		_replay->record(type, this, pos, dir);
+	}
+}
+
 /**
  * Checks for units panicking or falling and so on.
  */
@@ -223,8 +248,8 @@ void BattlescapeGame::think()
 			_save->setUnitsFalling(false);
 			return;
 		}
-		// it's a non player side (ALIENS or CIVILIANS)
-		if (_save->getSide() != FACTION_PLAYER)
+		// it's a non player side (ALIENS or CIVILIANS), or the AI plays for the player too
+		if (_save->getSide() != FACTION_PLAYER || _playerSideAI)
 		{
 			_save->resetUnitHitStates();
 			if (!_debugPlay)
@@ -1001,6 +1026,10 @@ void BattlescapeGame::handleNonTargetAction()
 {
 	if (!_currentAction.targeting)
 	{
+		if (_currentAction.result.empty() && (_currentAction.type == BA_PRIME || _currentAction.type == BA_UNPRIME || _currentAction.type == BA_USE || _currentAction.type == BA_HIT))
+		{
+			recordCommand(RC_NON_TARGET);
+		}
 		std::string error;
 		_currentAction.cameraPosition = Position(0,0,-1);
 		if (!_currentAction.result.empty())
@@ -1784,7 +1813,7 @@ void BattlescapeGame::primaryAction(Position pos)
 			{
 				if (!_currentAction.weapon->getRules()->isLOSRequired() ||
 					(_currentAction.actor->getFaction() == FACTION_PLAYER && targetUnit->getFaction() != FACTION_HOSTILE) ||
-					std::find(_currentAction.actor->getVisibleUnits()->begin(), _currentAction.actor->getVisibleUnits()->end(), targetUnit) != _currentAction.actor->getVisibleUnits()->end())
+					_currentAction.actor->isOnVisibleUnits(targetUnit))
 				{
 					std::string error;
 					if (_currentAction.spendTU(&error))
@@ -1830,7 +1859,7 @@ void BattlescapeGame::primaryAction(Position pos)
 					_currentAction.target = pos;
 					if (!_currentAction.weapon->getRules()->isLOSRequired() ||
 						(_currentAction.actor->getFaction() == FACTION_PLAYER && targetFaction != FACTION_HOSTILE) ||
-						std::find(_currentAction.actor->getVisibleUnits()->begin(), _currentAction.actor->getVisibleUnits()->end(), targetUnit) != _currentAction.actor->getVisibleUnits()->end())
+						_currentAction.actor->isOnVisibleUnits(targetUnit))
 					{
 						// get the sound/animation started
 						getMap()->setCursorType(CT_NONE);
@@ -2241,7 +2270,7 @@ void BattlescapeGame::spawnNewUnit(BattleActionAttack attack, Position position)
 	}
 	else
 	{
-		delete newUnit;
+		_save->destroyUnit(newUnit);
 	}
 }
 
@@ -2292,7 +2321,7 @@ void BattlescapeGame::spawnNewItem(BattleActionAttack attack, Position position)
 	}
 	else
 	{
-		delete newItem;
+		_save->destroyItem(newItem);
 	}
 }
 
@@ -2363,14 +2392,14 @@ void BattlescapeGame::removeSummonedPlayerUnits()
 			}
 
 			bu->setTile(nullptr, _save);
-			delete bu;
+			_save->destroyUnit(bu);
 			buIt = _save->getUnits()->erase(buIt);
 		}
 	}
 
 	for (auto* unitType : resummonAsCivilians)
 	{
-		BattleUnit *newUnit = new BattleUnit(getMod(),
+		BattleUnit *newUnit = _save->createUnit(getMod(),
 			unitType,
 			FACTION_NEUTRAL,
 			_save->getUnits()->back()->getId() + 1,
@@ -38,6 +38,9 @@ class Mod;
 class InfoboxOKState;
 class SoldierDiary;
 class RuleSkill;
+class BattleReplay;
+
+enum ReplayCommandType : int;
 
 enum BattleActionMove : char { BAM_NORMAL = 0, BAM_RUN = 1, BAM_STRAFE = 2, BAM_SNEAK = 3, BAM_MISSILE = 4 };
 
@@ -172,6 +175,8 @@ private:
 	bool _endTurnRequested;
 	bool _endConfirmationHandled;
 	bool _allEnemiesNeutralized;
+	bool _playerSideAI;
+	BattleReplay *_replay;
 
 	SingleRun _endTurnProcessed;
 	SingleRun _triggerProcessed;
@@ -277,6 +282,16 @@ public:
 	Mod *getMod();
 	/// Returns whether panic has been handled.
 	bool getPanicHandled() const { return _playerPanicHandled; }
+	/// Lets the AI control the player's units too.
+	void setPlayerSideAI(bool ai) { _playerSideAI = ai; }
+	/// Checks if the AI controls the player's units too.
+	bool isPlayerSideAI() const { return _playerSideAI; }
+	/// Gets the recording or playback of this battle, if any.
+	BattleReplay *getReplay() const { return _replay; }
+	/// Sets the recording or playback of this battle.
+	void setReplay(BattleReplay *replay);
+	/// Records a command given by the player, if the battle is being recorded.
+	void recordCommand(ReplayCommandType type, Position pos = Position(), int dir = 0);
 	/// Tries to find an item and pick it up if possible.
 	bool findItem(BattleAction *action, bool pickUpWeaponsMoreActively, bool& walkToItem);
 	/// Checks through all the items on the ground and picks one.
@@ -46,6 +46,7 @@
 #include "../Engine/Logger.h"
 #include "../Mod/MapBlock.h"
 #include "../Mod/MapDataSet.h"
+#include "../Mod/TerrainCache.h"
 #include "../Mod/RuleUfo.h"
 #include "../Mod/RuleCraft.h"
 #include "../Mod/RuleInventory.h"
@@ -518,7 +519,7 @@ void BattlescapeGenerator::nextStage()
 		// fixed weapons, or anything that's otherwise "equipped" will need to be de-equipped
 		// from their owners to make sure we don't have any null pointers to worry about later
 		bi->moveToOwner(nullptr);
-		delete bi;
+		_save->destroyItem(bi);
 	}
 
 	// rebuild it with only the items we want to keep active in battle for the next stage
@@ -770,6 +771,12 @@ void BattlescapeGenerator::run()
 {
 	bool isPreview = _save->isPreview();
 
+	// get the common battlescape sprites decoding while the map is generated
+	_game->getMod()->prefetchSurfaces({
+		"BIGOBS.PCK", "FLOOROB.PCK", "HANDOB.PCK", "SMOKE.PCK", "HIT.PCK", "X1.PCK",
+		"CURSOR.PCK", "SPICONS.DAT", "SCANG.DAT", "MEDIBITS.DAT", "DETBLOB.DAT",
+		"Projectiles", "UnderwaterProjectiles", "TinyRanks", "Pathfinding", "TAC01.SCR" });
+
 	_save->setAlienCustom(_alienCustomDeploy ? _alienCustomDeploy->getType() : "", _alienCustomMission ? _alienCustomMission->getType() : "");
 
 	// Note: this considers also fake underwater UFO deployment (via _alienCustomMission)
@@ -1043,7 +1050,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		for (auto* soldier : *_base->getSoldiers())
 		{
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != CS_OUT)))
 			{
 				Armor* transformedArmor = nullptr;
 				if (enviro)
@@ -1085,14 +1092,14 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 				continue;
 			}
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != CS_OUT)))
 			{
 				// clear the soldier's equipment layout, we want to start fresh
 				if (_game->getSavedGame()->getDisableSoldierEquipment())
 				{
 					soldier->clearEquipmentLayout();
 				}
-				BattleUnit *unit = addXCOMUnit(new BattleUnit(_game->getMod() , soldier, _save->getDepth(), _save->getStartingCondition()));
+				BattleUnit *unit = addXCOMUnit(_save->createUnit(_game->getMod(), soldier, _save->getDepth(), _save->getStartingCondition()));
 				if (unit && !_save->getSelectedUnit())
 					_save->setSelectedUnit(unit);
 			}
@@ -1131,14 +1138,14 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 				continue;
 			}
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != CS_OUT)))
 			{
 				// clear the soldier's equipment layout, we want to start fresh
 				if (_game->getSavedGame()->getDisableSoldierEquipment())
 				{
 					soldier->clearEquipmentLayout();
 				}
-				BattleUnit *unit = addXCOMUnit(new BattleUnit(_game->getMod(), soldier, _save->getDepth(), _save->getStartingCondition()));
+				BattleUnit *unit = addXCOMUnit(_save->createUnit(_game->getMod(), soldier, _save->getDepth(), _save->getStartingCondition()));
 				if (unit && !_save->getSelectedUnit())
 					_save->setSelectedUnit(unit);
 			}
@@ -1247,7 +1254,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		// add items from crafts in base
 		for (auto* craft : *_base->getCrafts())
 		{
-			if (craft->getStatus() == "STR_OUT")
+			if (craft->getStatus() == CS_OUT)
 				continue;
 			for (const auto& pair : *craft->getItems()->getContents())
 			{
@@ -1414,7 +1421,7 @@ BattleUnit *BattlescapeGenerator::addXCOMUnit(BattleUnit *unit)
 		// base preview, one standard unit is enough
 		if (_save->getUnits()->size() > 0 && !_save->getUnits()->back()->isSummonedPlayerUnit())
 		{
-			delete unit;
+			_save->destroyUnit(unit);
 			return nullptr;
 		}
 	}
@@ -1558,7 +1565,7 @@ BattleUnit *BattlescapeGenerator::addXCOMUnit(BattleUnit *unit)
 			}
 		}
 	}
-	delete unit;
+	_save->destroyUnit(unit);
 	return 0;
 }
 
@@ -1790,7 +1797,7 @@ BattleUnit *BattlescapeGenerator::addAlien(Unit *rules, int alienRank, bool outs
 		}
 		else
 		{
-			delete unit;
+			_save->destroyUnit(unit);
 			unit = 0;
 		}
 	}
@@ -1825,7 +1832,7 @@ BattleUnit *BattlescapeGenerator::addCivilian(Unit *rules, int nodeRank)
 	}
 	else
 	{
-		delete unit;
+		_save->destroyUnit(unit);
 		unit = 0;
 	}
 	return unit;
@@ -2021,18 +2028,15 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 {
 	int sizex, sizey, sizez;
 	int x = xoff, y = yoff, z = zoff;
-	char size[3];
-	unsigned char value[4];
 	std::string filename = "MAPS/" + mapblock->getName() + ".MAP";
 	unsigned int terrainObjectID;
 
 	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	const TerrainCache::MapBlockFile &mapFile = _game->getMod()->getTerrainCache()->getBlockFile(filename);
 
-	mapFile->read((char*)&size, sizeof(size));
-	sizey = (int)size[0];
-	sizex = (int)size[1];
-	sizez = (int)size[2];
+	sizey = mapFile.sizeY;
+	sizex = mapFile.sizeX;
+	sizez = mapFile.sizeZ;
 
 	mapblock->setSizeZ(sizez);
 
@@ -2082,11 +2086,12 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		throw Exception("Something is wrong in your map definitions, craft/ufo map is too tall?");
 	}
 
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (size_t i = 0; i < mapFile.tiles.size(); i += 4)
 	{
+		const Uint8 *value = &mapFile.tiles[i];
 		for (int part = O_FLOOR; part < O_MAX; ++part)
 		{
-			terrainObjectID = ((unsigned char)value[part]);
+			terrainObjectID = value[part];
 			if (terrainObjectID>0)
 			{
 				int mapDataSetID = mapDataSetOffset;
@@ -2117,11 +2122,6 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		}
 	}
 
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid MAP file: " + filename);
-	}
-
 	// Add the craft offset to the positions of the items if we're loading a craft map
 	// But don't do so if loading a verticalLevel, since the z offset of the craft is handled by that code
 	if (craft && zoff == 0)
@@ -2217,34 +2217,33 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
  */
 void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int zoff, int segment)
 {
-	unsigned char value[24];
 	std::string filename = "ROUTES/" + mapblock->getName() +".RMP";
 	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	const TerrainCache::MapBlockFile &routeFile = _game->getMod()->getTerrainCache()->getBlockFile(filename);
 
 	size_t nodeOffset = _save->getNodes()->size();
 	std::vector<int> badNodes;
 	int nodesAdded = 0;
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (const auto& route : routeFile.routes)
 	{
-		int pos_x = value[1];
-		int pos_y = value[0];
-		int pos_z = value[2];
+		int pos_x = route.x;
+		int pos_y = route.y;
+		int pos_z = route.z;
 		Node *node;
 		if (pos_x >= 0 && pos_x < mapblock->getSizeX() &&
 			pos_y >= 0 && pos_y < mapblock->getSizeY() &&
 			pos_z >= 0 && pos_z < mapblock->getSizeZ())
 		{
 			Position pos = Position(xoff + pos_x, yoff + pos_y, mapblock->getSizeZ() - 1 - pos_z + zoff);
-			int type     = value[19];
-			int rank     = value[20];
-			int flags    = value[21];
-			int reserved = value[22];
-			int priority = value[23];
-			node = new Node(_save->getNodes()->size(), pos, segment, type, rank, flags, reserved, priority);
+			int type     = route.type;
+			int rank     = route.rank;
+			int flags    = route.flags;
+			int reserved = route.reserved;
+			int priority = route.priority;
+			node = _save->createNode(_save->getNodes()->size(), pos, segment, type, rank, flags, reserved, priority);
 			for (int j = 0; j < 5; ++j)
 			{
-				int connectID = value[4 + j * 3];
+				int connectID = route.links[j];
 				// don't touch special values
 				if (connectID <= 250)
 				{
@@ -2265,7 +2264,7 @@ void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int z
 			// this is because the "built in" nodeLinks reference each other by number, and it's gonna be implementational hell to try
 			// to adjust those numbers retroactively, post-culling. far better to simply mark these culled nodes as dummies, and discount their use
 			// that way, all the connections will still line up properly in the array.
-			node = new Node();
+			node = _save->createNode();
 			node->setDummy(true);
 			Log(LOG_INFO) << "Bad node in RMP file: " << filename << " Node #" << nodesAdded << " is outside map boundaries at X:" << pos_x << " Y:" << pos_y << " Z:" << pos_z << ". Culling Node.";
 			badNodes.push_back(nodesAdded);
@@ -2293,11 +2292,6 @@ void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int z
 			nodeCounter--;
 		}
 	}
-
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid RMP file: " + filename);
-	}
 }
 
 /**
@@ -2322,7 +2316,7 @@ int BattlescapeGenerator::loadExtraTerrain(RuleTerrain *terrain)
 
 		for (auto* mds : *terrain->getMapDataSets())
 		{
-			mds->loadData(_game->getMod()->getMCDPatch(mds->getName()));
+			_game->getMod()->getTerrainCache()->load(mds);
 			_save->getMapDataSets()->push_back(mds);
 		}
 
@@ -2554,7 +2548,7 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 	// Load in the default terrain data
 	for (auto* mds : *_terrain->getMapDataSets())
 	{
-		mds->loadData(_game->getMod()->getMCDPatch(mds->getName()));
+		_game->getMod()->getTerrainCache()->load(mds);
 		_save->getMapDataSets()->push_back(mds);
 		mapDataSetIDOffset++;
 	}
@@ -2577,6 +2571,14 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 		}
 	}
 
+	// most ground blocks come from the chosen terrain, get their files ready all at once
+	std::vector<std::string> blockFiles;
+	for (auto* block : *_terrain->getMapBlocks())
+	{
+		blockFiles.push_back("MAPS/" + block->getName() + ".MAP");
+	}
+	_game->getMod()->getTerrainCache()->decodeAhead(blockFiles);
+
 	// this mission type is "hard-coded" in terms of map layout
 	uint64_t seed = RNG::getSeed();
 	_baseTerrain = _terrain;
@@ -3001,13 +3003,41 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 	// Put the map data set ID offset to the end of the terrains in the save since we may have loaded more than the default
 	mapDataSetIDOffset = _save->getMapDataSets()->size();
 
+	// everything left to place is known now, so decode the rest of the files at once
+	blockFiles.clear();
+	for (int y = 0; y < _mapsize_y / 10; ++y)
+	{
+		for (int x = 0; x < _mapsize_x / 10; ++x)
+		{
+			if (_blocks[x][y] != 0 && _blocks[x][y] != _dummy)
+			{
+				blockFiles.push_back("ROUTES/" + _blocks[x][y]->getName() + ".RMP");
+			}
+		}
+	}
+	for (const auto& pair : _verticalLevelSegments)
+	{
+		blockFiles.push_back("ROUTES/" + pair.first->getName() + ".RMP");
+	}
+	for (auto* block : ufoMaps)
+	{
+		blockFiles.push_back("MAPS/" + block->getName() + ".MAP");
+		blockFiles.push_back("ROUTES/" + block->getName() + ".RMP");
+	}
+	if (craftMap)
+	{
+		blockFiles.push_back("MAPS/" + craftMap->getName() + ".MAP");
+		blockFiles.push_back("ROUTES/" + craftMap->getName() + ".RMP");
+	}
+	_game->getMod()->getTerrainCache()->decodeAhead(blockFiles);
+
 	loadNodes();
 
 	if (!ufoMaps.empty() && ufoTerrain)
 	{
 		for (auto* mds : *ufoTerrain->getMapDataSets())
 		{
-			mds->loadData(_game->getMod()->getMCDPatch(mds->getName()));
+			_game->getMod()->getTerrainCache()->load(mds);
 			_save->getMapDataSets()->push_back(mds);
 			craftDataSetIDOffset++;
 		}
@@ -3033,7 +3063,7 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 		_craftRules->getBattlescapeTerrainData()->refreshMapDataSets(_craft->getSkinIndex(), _game->getMod()); // change skin if needed
 		for (auto* mds : *_craftRules->getBattlescapeTerrainData()->getMapDataSets())
 		{
-			mds->loadData(_game->getMod()->getMCDPatch(mds->getName()));
+			_game->getMod()->getTerrainCache()->load(mds);
 			_save->getMapDataSets()->push_back(mds);
 		}
 		loadMAP(craftMap, _craftPos.x * 10, _craftPos.y * 10, _craftZ, _craftRules->getBattlescapeTerrainData(), mapDataSetIDOffset + craftDataSetIDOffset, _craftRules->isMapVisible(), true);
@@ -3062,6 +3092,7 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 		}
 	}
 
+	_game->getMod()->getTerrainCache()->forgetDecoded();
 	delete _dummy;
 
 	// special hacks to fill in empty floors on level 0
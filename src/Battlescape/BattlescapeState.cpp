@@ -25,6 +25,7 @@
 #include "Camera.h"
 #include "BattlescapeState.h"
 #include "AbortMissionState.h"
+#include "BattleReplay.h"
 #include "TileEngine.h"
 #include "ActionMenuState.h"
 #include "SkillMenuState.h"
@@ -101,7 +102,7 @@ BattlescapeState::BattlescapeState() :
 	_isMouseScrolling(false), _isMouseScrolled(false),
 	_xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0),
 	_totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(0), _mouseOverIcons(false),
-	_autosave(0),
+	_autosave(0), _recording(0),
 	_numberOfDirectlyVisibleUnits(0), _numberOfEnemiesTotal(0), _numberOfEnemiesTotalPlusWounded(0)
 {
 	std::fill_n(_visibleUnit, 10, (BattleUnit*)(0));
@@ -698,6 +699,9 @@ BattlescapeState::BattlescapeState() :
 		}
 	}
 
+	// the map animations must keep their pace even when the game is idle
+	_minFrameRate = 1000 / DEFAULT_ANIM_SPEED;
+
 	_animTimer = new Timer(DEFAULT_ANIM_SPEED, true);
 	_animTimer->onTimer((StateHandler)&BattlescapeState::animate);
 
@@ -718,6 +722,7 @@ BattlescapeState::~BattlescapeState()
 	delete _animTimer;
 	delete _gameTimer;
 	delete _battleGame;
+	delete _recording;
 
 	resetPalettes();
 }
@@ -812,6 +817,19 @@ void BattlescapeState::init()
 			_battleGame->setupCursor();
 			_map->getCamera()->centerOnPosition(_save->getSelectedUnit()->getPosition());
 		}
+		if (Options::oxceRecordBattles && !Options::headless && !_save->isPreview())
+		{
+			_recording = new BattleReplay();
+			if (_recording->startRecording(_game))
+			{
+				_battleGame->setReplay(_recording);
+			}
+			else
+			{
+				delete _recording;
+				_recording = 0;
+			}
+		}
 		_firstInit = false;
 		_btnReserveNone->setGroup(&_reserve);
 		_btnReserveSnap->setGroup(&_reserve);
@@ -1077,10 +1095,12 @@ void BattlescapeState::mapClick(Action *action)
 	{
 		if (_game->isRightClick(action, true) && playableUnitSelected())
 		{
+			_battleGame->recordCommand(RC_SECONDARY, pos);
 			_battleGame->secondaryAction(pos);
 		}
 		else if (_game->isLeftClick(action, true))
 		{
+			_battleGame->recordCommand(RC_PRIMARY, pos);
 			_battleGame->primaryAction(pos);
 		}
 		else if (_game->isMiddleClick(action, true))
@@ -1121,6 +1141,7 @@ void BattlescapeState::btnUnitUpClick(Action *)
 {
 	if (playableUnitSelected() && _save->getPathfinding()->validateUpDown(_save->getSelectedUnit(), _save->getSelectedUnit()->getPosition(), Pathfinding::DIR_UP))
 	{
+		_battleGame->recordCommand(RC_MOVE_UP_DOWN, Position(), Pathfinding::DIR_UP);
 		_battleGame->cancelAllActions();
 		_battleGame->moveUpDown(_save->getSelectedUnit(), Pathfinding::DIR_UP);
 	}
@@ -1134,6 +1155,7 @@ void BattlescapeState::btnUnitDownClick(Action *)
 {
 	if (playableUnitSelected() && _save->getPathfinding()->validateUpDown(_save->getSelectedUnit(), _save->getSelectedUnit()->getPosition(), Pathfinding::DIR_DOWN))
 	{
+		_battleGame->recordCommand(RC_MOVE_UP_DOWN, Position(), Pathfinding::DIR_DOWN);
 		_battleGame->cancelAllActions();
 		_battleGame->moveUpDown(_save->getSelectedUnit(), Pathfinding::DIR_DOWN);
 	}
@@ -1193,6 +1215,7 @@ void BattlescapeState::btnKneelClick(Action *)
 		BattleUnit *bu = _save->getSelectedUnit();
 		if (bu)
 		{
+			_battleGame->recordCommand(RC_KNEEL);
 			_battleGame->kneel(bu);
 			toggleKneelButton(bu);
 
@@ -1393,6 +1416,7 @@ void BattlescapeState::btnEndTurnClick(Action *)
 		toggleTouchButtons(true, false);
 
 		_txtTooltip->setText("");
+		_battleGame->recordCommand(RC_END_TURN);
 		_battleGame->requestEndTurn(false);
 	}
 }
@@ -1723,6 +1747,7 @@ void BattlescapeState::toggleTouchButtons(bool deactivate, bool tryToReactivate)
  */
 void BattlescapeState::btnLaunchClick(Action *action)
 {
+	_battleGame->recordCommand(RC_LAUNCH);
 	_battleGame->launchAction();
 	action->getDetails()->type = SDL_NOEVENT; // consume the event
 }
@@ -1733,6 +1758,7 @@ void BattlescapeState::btnLaunchClick(Action *action)
  */
 void BattlescapeState::btnPsiClick(Action *action)
 {
+	_battleGame->recordCommand(RC_PSI);
 	_battleGame->psiButtonAction();
 	action->getDetails()->type = SDL_NOEVENT; // consume the event
 }
@@ -3201,6 +3227,11 @@ void BattlescapeState::finishBattle(bool abort, int inExitArea)
 {
 	bool isPreview = _save->isPreview();
 
+	if (BattleReplay *replay = _battleGame->getReplay())
+	{
+		replay->checkpoint(_save);
+	}
+
 	while (!_game->isState(this))
 	{
 		_game->popState();
@@ -40,6 +40,7 @@ class BattleItem;
 class Timer;
 class WarningMessage;
 class BattlescapeGame;
+class BattleReplay;
 
 /**
  * Battlescape screen which shows the tactical battle.
@@ -96,6 +97,7 @@ private:
 	Position _cursorPosition;
 	Uint8 _barHealthColor;
 	int _autosave;
+	BattleReplay *_recording;
 	int _numberOfDirectlyVisibleUnits, _numberOfEnemiesTotal, _numberOfEnemiesTotalPlusWounded;
 	Uint8 _indicatorTextColor, _indicatorGreen, _indicatorBlue, _indicatorPurple;
 	/// Popups a context sensitive list of actions the user can choose from.
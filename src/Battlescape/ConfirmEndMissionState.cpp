@@ -26,6 +26,7 @@
 #include "../Savegame/SavedBattleGame.h"
 #include "BattlescapeState.h"
 #include "BattlescapeGame.h"
+#include "BattleReplay.h"
 #include "../Engine/Options.h"
 
 namespace OpenXcom
@@ -102,6 +103,7 @@ ConfirmEndMissionState::~ConfirmEndMissionState()
 void ConfirmEndMissionState::btnOkClick(Action *)
 {
 	_game->popState();
+	_parent->recordCommand(RC_END_TURN);
 	_parent->requestEndTurn(false);
 }
 
@@ -62,6 +62,7 @@
 #include "../Interface/Cursor.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
+#include "../Engine/Parallel.h"
 #include "../Engine/RNG.h"
 #include "../Basescape/ManageAlienContainmentState.h"
 #include "../Basescape/TransferBaseState.h"
@@ -685,6 +686,7 @@ void DebriefingState::init()
 		}
 	}
 
+	std::vector<BattleUnit*> diaryUnits;
 	for (auto* bu : *battle->getUnits())
 	{
 		if (bu->getGeoscapeSoldier())
@@ -753,15 +755,26 @@ void DebriefingState::init()
 			bu->getStatistics()->delta = *bu->getGeoscapeSoldier()->getCurrentStats() - *bu->getGeoscapeSoldier()->getInitStats();
 
 			bu->getGeoscapeSoldier()->getDiary()->updateDiary(bu->getStatistics(), _game->getSavedGame()->getMissionStatistics(), _game->getMod());
-			if (!bu->getStatistics()->MIA && !bu->getStatistics()->KIA && bu->getGeoscapeSoldier()->getDiary()->manageCommendations(_game->getMod(), _game->getSavedGame()->getMissionStatistics()))
-			{
-				_soldiersCommended.push_back(bu->getGeoscapeSoldier());
-			}
-			else if (bu->getStatistics()->MIA || bu->getStatistics()->KIA)
-			{
-				bu->getGeoscapeSoldier()->getDiary()->manageCommendations(_game->getMod(), _game->getSavedGame()->getMissionStatistics());
-				_deadSoldiersCommended.push_back(bu->getGeoscapeSoldier());
-			}
+			diaryUnits.push_back(bu);
+		}
+	}
+
+	// Commendations only depend on each soldier's own diary, so they can be worked out in parallel
+	std::vector<char> commended(diaryUnits.size(), 0);
+	Parallel::forEach(diaryUnits.size(), [&](size_t i)
+	{
+		commended[i] = diaryUnits[i]->getGeoscapeSoldier()->getDiary()->manageCommendations(_game->getMod(), _game->getSavedGame()->getMissionStatistics());
+	});
+	for (size_t i = 0; i < diaryUnits.size(); ++i)
+	{
+		BattleUnit *bu = diaryUnits[i];
+		if (bu->getStatistics()->MIA || bu->getStatistics()->KIA)
+		{
+			_deadSoldiersCommended.push_back(bu->getGeoscapeSoldier());
+		}
+		else if (commended[i])
+		{
+			_soldiersCommended.push_back(bu->getGeoscapeSoldier());
 		}
 	}
 
@@ -1216,8 +1229,8 @@ void DebriefingState::prepareDebriefing()
 		if (ms->isInBattlescape())
 		{
 			_missionStatistics->alienRace = ms->getAlienRace();
+			save->removeMissionSite(msIt);
 			delete ms;
-			save->getMissionSites()->erase(msIt);
 			break;
 		}
 	}
@@ -1337,8 +1350,8 @@ void DebriefingState::prepareDebriefing()
 						ufo->setDamage(ufo->getCraftStats().damageMax, _game->getMod());
 					}
 				}
+				save->removeUfo(ufoIt);
 				delete ufo;
-				save->getUfos()->erase(ufoIt);
 			}
 			break;
 		}
@@ -2064,7 +2077,7 @@ void DebriefingState::prepareDebriefing()
 			// reequip crafts (only those on the base) after a base defense mission
 			for (auto* xcraft : *base->getCrafts())
 			{
-				if (xcraft->getStatus() != "STR_OUT")
+				if (xcraft->getStatus() != CS_OUT)
 					reequipCraft(base, xcraft, false);
 			}
 		}
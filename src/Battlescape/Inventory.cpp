@@ -1338,7 +1338,7 @@ bool Inventory::isInSearchString(BattleItem *item)
 	}
 	else
 	{
-		itemLocalName = _game->getLanguage()->getString(item->getRules()->getName());
+		itemLocalName = _game->getLanguage()->getString(item->getRules()->getNameId());
 	}
 	Unicode::upperCase(itemLocalName);
 	if (itemLocalName.find(_searchString) != std::string::npos)
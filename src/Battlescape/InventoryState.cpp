@@ -85,7 +85,7 @@ InventoryState::InventoryState(bool tu, BattlescapeState *parent, Base *base, bo
 		for (auto* soldier : *_base->getSoldiers())
 		{
 			_backup[soldier] = soldier->getCraft();
-			if (soldier->getCraft() && soldier->getCraft()->getStatus() != "STR_OUT")
+			if (soldier->getCraft() && soldier->getCraft()->getStatus() != CS_OUT)
 			{
 				soldier->setCraftAndMoveEquipment(0, _base, _game->getSavedGame()->getMonthsPassed() == -1);
 			}
@@ -325,6 +325,88 @@ InventoryState::InventoryState(bool tu, BattlescapeState *parent, Base *base, bo
 	_txtStatLine2->setVisible(Options::showMoreStatsInInventoryView && !_tu);
 	_txtStatLine3->setVisible(Options::showMoreStatsInInventoryView && !_tu);
 	_txtStatLine4->setVisible(Options::showMoreStatsInInventoryView && !_tu);
+
+	prefetchPaperDolls();
+}
+
+/**
+ * Gets the paper doll sprite of a unit without armor layers,
+ * trying the same names in the same order init() always did,
+ * but without loading any of them.
+ * @param unit Pointer to the unit.
+ * @return Sprite name, or empty if a non-soldier unit has none.
+ */
+std::string InventoryState::getPaperDoll(BattleUnit *unit) const
+{
+	const Mod *mod = _game->getMod();
+	Soldier *s = unit->getGeoscapeSoldier();
+	if (s)
+	{
+		const std::string look = s->getArmor()->getSpriteInventory();
+		const std::string gender = s->getGender() == GENDER_MALE ? "M" : "F";
+		std::stringstream ss;
+		for (int i = 0; i <= RuleSoldier::LookVariantBits; ++i)
+		{
+			ss.str("");
+			ss << look;
+			ss << gender;
+			ss << (int)s->getLook() + (s->getLookVariant() & (RuleSoldier::LookVariantMask >> i)) * 4;
+			ss << ".SPK";
+			if (mod->hasSurface(ss.str()))
+			{
+				return ss.str();
+			}
+		}
+		if (mod->hasSurface(look + ".SPK"))
+		{
+			return look + ".SPK";
+		}
+		// reported as missing when drawn, if it isn't there either
+		return look;
+	}
+
+	const std::string look = unit->getArmor()->getSpriteInventory();
+	for (const auto& name : { look, look + ".SPK", look + "M0.SPK" })
+	{
+		if (mod->hasSurface(name))
+		{
+			return name;
+		}
+	}
+	return "";
+}
+
+/**
+ * Starts loading the paper dolls of all the units the player
+ * can switch to, so it doesn't stall on each of them with
+ * lazy loading. Only the sprites init() is going to draw
+ * are listed, and the files are read by the prefetch workers.
+ */
+void InventoryState::prefetchPaperDolls()
+{
+	std::vector<std::string> names;
+	for (auto* unit : *_battleGame->getUnits())
+	{
+		if (unit->getFaction() != FACTION_PLAYER || unit->isOut() || !unit->hasInventory())
+		{
+			continue;
+		}
+		Soldier *s = unit->getGeoscapeSoldier();
+		if (s && s->getArmor()->hasLayersDefinition())
+		{
+			const auto& layers = s->getArmorLayers();
+			names.insert(names.end(), layers.begin(), layers.end());
+		}
+		else
+		{
+			std::string paperDoll = getPaperDoll(unit);
+			if (!paperDoll.empty())
+			{
+				names.push_back(paperDoll);
+			}
+		}
+	}
+	_game->getMod()->prefetchSurfaces(names);
 }
 
 static void _clearInventoryTemplate(std::vector<EquipmentLayoutItem*> &inventoryTemplate)
@@ -480,52 +562,15 @@ void InventoryState::init()
 		}
 		else
 		{
-			const std::string look = s->getArmor()->getSpriteInventory();
-			const std::string gender = s->getGender() == GENDER_MALE ? "M" : "F";
-			Surface *surf = 0;
-			std::stringstream ss;
-
-			for (int i = 0; i <= RuleSoldier::LookVariantBits; ++i)
-			{
-				ss.str("");
-				ss << look;
-				ss << gender;
-				ss << (int)s->getLook() + (s->getLookVariant() & (RuleSoldier::LookVariantMask >> i)) * 4;
-				ss << ".SPK";
-				surf = _game->getMod()->getSurface(ss.str(), false);
-				if (surf)
-				{
-					break;
-				}
-			}
-			if (!surf)
-			{
-				ss.str("");
-				ss << look;
-				ss << ".SPK";
-				surf = _game->getMod()->getSurface(ss.str(), false);
-			}
-			if (!surf)
-			{
-				surf = _game->getMod()->getSurface(look, true);
-			}
-			surf->blitNShade(_soldier, 0, 0);
+			_game->getMod()->getSurface(getPaperDoll(unit), true)->blitNShade(_soldier, 0, 0);
 		}
 	}
 	else
 	{
-		Surface *armorSurface = _game->getMod()->getSurface(unit->getArmor()->getSpriteInventory(), false);
-		if (!armorSurface)
-		{
-			armorSurface = _game->getMod()->getSurface(unit->getArmor()->getSpriteInventory() + ".SPK", false);
-		}
-		if (!armorSurface)
-		{
-			armorSurface = _game->getMod()->getSurface(unit->getArmor()->getSpriteInventory() + "M0.SPK", false);
-		}
-		if (armorSurface)
+		const std::string paperDoll = getPaperDoll(unit);
+		if (!paperDoll.empty())
 		{
-			armorSurface->blitNShade(_soldier, 0, 0);
+			_game->getMod()->getSurface(paperDoll, true)->blitNShade(_soldier, 0, 0);
 		}
 	}
 
@@ -744,7 +789,7 @@ void InventoryState::btnArmorClick(Action *action)
 	BattleUnit *unit = _battleGame->getSelectedUnit();
 	Soldier *s = unit->getGeoscapeSoldier();
 
-	if (!(s->getCraft() && s->getCraft()->getStatus() == "STR_OUT"))
+	if (!(s->getCraft() && s->getCraft()->getStatus() == CS_OUT))
 	{
 		size_t soldierIndex = 0;
 		for (auto soldierIt = _base->getSoldiers()->begin(); soldierIt != _base->getSoldiers()->end(); ++soldierIt)
@@ -782,7 +827,7 @@ void InventoryState::btnArmorClickRight(Action *action)
 	BattleUnit *unit = _battleGame->getSelectedUnit();
 	Soldier *s = unit->getGeoscapeSoldier();
 
-	if (!(s->getCraft() && s->getCraft()->getStatus() == "STR_OUT"))
+	if (!(s->getCraft() && s->getCraft()->getStatus() == CS_OUT))
 	{
 		size_t soldierIndex = 0;
 		for (auto soldierIt = _base->getSoldiers()->begin(); soldierIt != _base->getSoldiers()->end(); ++soldierIt)
@@ -1069,7 +1114,7 @@ void InventoryState::btnOkClick(Action *)
 			for (auto* soldier : *_base->getSoldiers())
 			{
 				Craft* c = _backup[soldier];
-				if (!soldier->getCraft() && c && c->getStatus() != "STR_OUT")
+				if (!soldier->getCraft() && c && c->getStatus() != CS_OUT)
 				{
 					int space = c->getSpaceAvailable();
 					if (c->validateAddingSoldier(space, soldier))
@@ -1806,7 +1851,7 @@ void InventoryState::invMouseOver(Action *)
 			auto* save = _game->getSavedGame();
 			if (save->isResearched(item->getRules()->getRequirements()))
 			{
-				std::string text = tr(item->getRules()->getName());
+				std::string text = tr(item->getRules()->getNameId());
 				for (int slot = 0; slot < RuleItem::AmmoSlotMax; ++slot)
 				{
 					if (!item->needsAmmoForSlot(slot))
@@ -1936,7 +1981,7 @@ void InventoryState::onMoveGroundInventoryToBase(Action *)
 	Soldier *s = unit->getGeoscapeSoldier();
 	Craft *c = s->getCraft();
 
-	if (c == 0 || c->getStatus() == "STR_OUT")
+	if (c == 0 || c->getStatus() == CS_OUT)
 	{
 		// we're either not in a craft or not in a hangar (should not happen, but just in case)
 		return;
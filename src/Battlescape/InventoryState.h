@@ -156,6 +156,10 @@ public:
 	void txtArmorTooltipOut(Action *action);
 
 private:
+	/// Gets the paper doll sprite of a unit without armor layers.
+	std::string getPaperDoll(BattleUnit *unit) const;
+	/// Starts loading the paper dolls of the other units.
+	void prefetchPaperDolls();
 	/// Update the visibility and icons for the template buttons.
 	void updateTemplateButtons(bool isVisible);
 	/// Refresh the hover status of the mouse.
@@ -32,6 +32,7 @@
 #include "../Engine/Timer.h"
 #include "../Engine/Language.h"
 #include "../Engine/Palette.h"
+#include "../Engine/Profiler.h"
 #include "../Engine/Game.h"
 #include "../Engine/Screen.h"
 #include "../Engine/ShaderDraw.h"
@@ -687,6 +688,7 @@ void Map::drawUnit(UnitSprite &unitSprite, Tile *unitTile, Tile *currTile, Posit
  */
 void Map::drawTerrain(Surface *surface)
 {
+	PROFILE_SCOPE("Map::drawTerrain");
 	_isAltPressed = _game->isAltPressed(true);
 	int frameNumber = 0;
 	SurfaceRaw<const Uint8> tmpSurface;
@@ -44,6 +44,7 @@
 #include "AIModule.h"
 #include "BattlescapeState.h"
 #include "BattlescapeGame.h"
+#include "BattleReplay.h"
 #include "BriefingState.h"
 #include "Map.h"
 #include "TileEngine.h"
@@ -528,6 +529,11 @@ void NextTurnState::close()
 		if (_battleGame->getSide() == FACTION_PLAYER)
 		{
 			_state->toggleTouchButtons(false, true);
+
+			if (BattleReplay *replay = _state->getBattleGame()->getReplay())
+			{
+				replay->checkpoint(_battleGame);
+			}
 		}
 
 		// Autosave every set amount of turns
@@ -1068,7 +1074,7 @@ BattleUnit* NextTurnState::addReinforcement(const ReinforcementsData &wave, Unit
 	// 4. dude, seriously?
 	if (!unitPlaced)
 	{
-		delete unit;
+		_battleGame->destroyUnit(unit);
 		unit = nullptr;
 	}
 
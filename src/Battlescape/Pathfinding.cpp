@@ -25,6 +25,7 @@
 #include "../Mod/Armor.h"
 #include "../Savegame/BattleUnit.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "../fmath.h"
 #include "BattlescapeGame.h"
 
@@ -82,6 +83,7 @@ PathfindingNode *Pathfinding::getNode(Position pos)
  */
 void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleActionMove bam, const BattleUnit *missileTarget, int maxTUCost)
 {
+	PROFILE_SCOPE("Pathfinding::calculate");
 	_totalTUCost = {};
 	_path.clear();
 
@@ -284,6 +286,10 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 	const Tile* destinationTile[4] = { };
 	const Tile* aboveDestination[4] = { };
 	const Tile* belowDestination[4] = { };
+	// the terrain levels, fire and smoke are read from the compact copies instead of the tiles
+	const auto& hot = _save->getTileHotData();
+	int startIndex[4] = { };
+	int destinationIndex[4] = { };
 
 	// init variables
 	for (int i = 0; i < numberOfParts; ++i)
@@ -295,6 +301,8 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 			return {{INVALID_MOVE_COST, 0}};
 		}
 		startTile[i] = st;
+		startIndex[i] = _save->getTileIndex(startPosition + offsets[i]);
+		destinationIndex[i] = _save->getTileIndex(pos + offsets[i]);
 		aboveStart[i] = _save->getAboveTile(st);
 		belowStart[i] = _save->getBelowTile(st);
 		destinationTile[i] = dt;
@@ -308,17 +316,17 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		const int maskCurrentPart = 1 << i;
 		const bool checkClimbing = (i == 0) && (numberOfParts == 1) &&  movementType != MT_FLY;
 
-		if (direction < DIR_UP && startTile[i]->getTerrainLevel() > - 16)
+		if (direction < DIR_UP && hot.terrainLevel[startIndex[i]] > - 16)
 		{
 			// check if we can go this way
 			if (isBlockedDirection(unit, startTile[i], direction, bam, missileTarget))
 				return {{INVALID_MOVE_COST, 0}};
-			if (startTile[i]->getTerrainLevel() - destinationTile[i]->getTerrainLevel() > 8)
+			if (hot.terrainLevel[startIndex[i]] - hot.terrainLevel[destinationIndex[i]] > 8)
 				return {{INVALID_MOVE_COST, 0}};
 		}
 
 		// if we are on a stairs try to go up a level
-		if (direction < DIR_UP && startTile[i]->getTerrainLevel() <= -16 && aboveDestination[i] && !aboveDestination[i]->hasNoFloor(_save))
+		if (direction < DIR_UP && hot.terrainLevel[startIndex[i]] <= -16 && aboveDestination[i] && !aboveDestination[i]->hasNoFloor(_save))
 		{
 			maskOfPartsGoingUp |= maskCurrentPart;
 		}
@@ -381,6 +389,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		{
 			destinationTile[i] = belowDestination[i];
 		}
+		destinationIndex[i] = _save->getTileIndex(destinationTile[i]->getPosition());
 
 		// check if the destination tile can be walked over
 		if (isBlocked(unit, destinationTile[i], O_FLOOR, bam, missileTarget) || isBlocked(unit, destinationTile[i], O_OBJECT, bam, missileTarget))
@@ -407,7 +416,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 	{
 		for (int i = 0; i < numberOfParts; ++i)
 		{
-			if (destinationTile[i]->getFire() > 0)
+			if (hot.fire[destinationIndex[i]] > 0)
 			{
 				firePenaltyCost = FIRE_PREVIEW_MOVE_COST; // try to find a better path, but don't exclude this path entirely.
 			}
@@ -511,7 +520,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		cost += wallcost;
 
 		// TFTD thing: underwater tiles on fire or filled with smoke cost 2 TUs more for whatever reason.
-		if (_save->getDepth() > 0 && (destinationTile[i]->getFire() > 0 || destinationTile[i]->getSmoke() > 0))
+		if (_save->getDepth() > 0 && (hot.fire[destinationIndex[i]] > 0 || hot.smoke[destinationIndex[i]] > 0))
 		{
 			cost += 2;
 		}
@@ -791,7 +800,7 @@ bool Pathfinding::isBlocked(const BattleUnit *unit, const Tile *tile, const int
 				if (unit->getFaction() == u->getFaction())
 					return true;
 				if (unit->getFaction() == FACTION_HOSTILE &&
-					std::find(unit->getUnitsSpottedThisTurn().begin(), unit->getUnitsSpottedThisTurn().end(), u) != unit->getUnitsSpottedThisTurn().end())
+					unit->hasSpottedUnit(u))
 					return true;
 			}
 		}
@@ -1364,6 +1373,7 @@ bool Pathfinding::bresenhamPath(Position origin, Position target, BattleActionMo
  */
 std::vector<int> Pathfinding::findReachable(const BattleUnit *unit, const BattleActionCost &cost)
 {
+	PROFILE_SCOPE("Pathfinding::findReachable");
 	const Position start = unit->getPosition();
 	int tuMax = unit->getTimeUnits() - cost.Time;
 	int energyMax = unit->getEnergy() - cost.Energy;
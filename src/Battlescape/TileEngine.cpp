@@ -20,6 +20,8 @@
 #include <set>
 #include "TileEngine.h"
 #include "AIModule.h"
+#include "AIThreatMap.h"
+#include "../Savegame/UnitGrid.h"
 #include "Map.h"
 #include "Camera.h"
 #include "Projectile.h"
@@ -32,6 +34,7 @@
 #include "../Savegame/HitLog.h"
 #include "../Engine/RNG.h"
 #include "../Engine/GraphSubset.h"
+#include "../Engine/Profiler.h"
 #include "BattlescapeState.h"
 #include "../Mod/MapDataSet.h"
 #include "../Mod/Unit.h"
@@ -877,6 +880,77 @@ void iterateTilesLightMaxBound(SavedBattleGame* save, Position position, int eve
 	iterateVolume(Pos{position.x, position.y, position.z}, eventRadius, maxRange, gsMap, save->getMapSizeZ(), callback);
 }
 
+/**
+ * Direction of one of the rays cast by an explosion.
+ */
+struct ExplosionRay
+{
+	int te;
+	double cos_te, sin_te, sin_fi, cos_fi;
+};
+
+/**
+ * Gets the directions of the rays cast by an explosion,
+ * every 5 degrees vertically and every 3 degrees horizontally,
+ * which makes sure we cover all tiles in a circle.
+ * @return List of rays, worked out on the first call.
+ */
+const std::vector<ExplosionRay> &getExplosionRays()
+{
+	static const std::vector<ExplosionRay> rays = []
+	{
+		std::vector<ExplosionRay> r;
+		for (int fi = -90; fi <= 90; fi += 5)
+		{
+			for (int te = 0; te <= 360; te += 3)
+			{
+				r.push_back({ te, cos(Deg2Rad(te)), sin(Deg2Rad(te)), sin(Deg2Rad(fi)), cos(Deg2Rad(fi)) });
+			}
+		}
+		return r;
+	}();
+	return rays;
+}
+
+/**
+ * Gets the explosion rays that go through a different sequence of
+ * tiles than all the rays before them, up to a given radius.
+ * Many rays near the poles and the center go through exactly the
+ * same tiles, and there is no point in following them twice.
+ * @param maxRadius Radius of the explosion.
+ * @return Indexes of the unique rays, worked out once per radius.
+ */
+const std::vector<size_t> &getUniqueExplosionRays(int maxRadius)
+{
+	static std::map<int, std::vector<size_t> > cache;
+	auto it = cache.find(maxRadius);
+	if (it != cache.end())
+	{
+		return it->second;
+	}
+
+	const auto& rays = getExplosionRays();
+	std::vector<size_t> &unique = cache[maxRadius];
+	std::set<std::vector<int> > paths;
+	std::vector<int> path;
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		const auto& ray = rays[i];
+		path.clear();
+		for (int l = 1; l <= maxRadius; ++l)
+		{
+			path.push_back(int(floor(0.5 + l * ray.sin_te * ray.cos_fi)));
+			path.push_back(int(floor(0.5 + l * ray.cos_te * ray.cos_fi)));
+			path.push_back(int(floor(0.5 + l * ray.sin_fi)));
+		}
+		if (paths.insert(path).second)
+		{
+			unique.push_back(i);
+		}
+	}
+	return unique;
+}
+
 } // namespace
 
 constexpr int TileEngine::heightFromCenter[11];
@@ -1112,6 +1186,7 @@ void TileEngine::calculateUnitLighting(MapSubset gs)
 
 void TileEngine::calculateLighting(LightLayers layer, Position position, int eventRadius, bool terrianChanged)
 {
+	PROFILE_SCOPE("TileEngine::calculateLighting");
 	const auto gsMap = MapSubset{ _save->getMapSizeX(), _save->getMapSizeY() };
 	auto gsDynamic = gsMap;
 	auto gsStatic = gsDynamic;
@@ -1124,6 +1199,11 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 
 	if (terrianChanged)
 	{
+		if (_save->getAIThreatMap())
+		{
+			_save->getAIThreatMap()->terrainChanged(position, eventRadius + 1);
+		}
+		const auto& hot = _save->getTileHotData();
 		iterateTiles(
 			_save,
 			position != invalid ? mapArea(position, eventRadius + 1) : gsMap,
@@ -1135,7 +1215,7 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 				auto& cache = _blockVisibility[index];
 
 				cache = {};
-				cache.height = -tile->getTerrainLevel();
+				cache.height = -hot.terrainLevel[index];
 				if (mapData)
 				{
 					if (mapData->getTUCost(MT_WALK) == Pathfinding::INVALID_MOVE_COST)
@@ -1143,8 +1223,8 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 						cache.height = 24;
 					}
 				}
-				addSmoke(cache, tile->getSmoke() > 0);
-				addFire(cache, tile->getFire() > 0);
+				addSmoke(cache, hot.smoke[index] > 0);
+				addFire(cache, hot.fire[index] > 0);
 				addBlockUp(cache, verticalBlockage(tile, _save->getAboveTile(tile), DT_NONE) > 127);
 				addBlockDown(cache, verticalBlockage(tile, _save->getBelowTile(tile), DT_NONE) > 127);
 				for (int dir = 0; dir < 8; ++dir)
@@ -1237,7 +1317,8 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 	const auto items = layer == LL_ITEMS;
 	const auto units = layer == LL_UNITS;
 	const auto ground = items || fire;
-	const auto tileHeight = _save->getTile(center)->getTerrainLevel();
+	const auto& hot = _save->getTileHotData();
+	const auto tileHeight = hot.terrainLevel[_save->getTileIndex(center)];
 	const auto divide = (fire ? 8 : 4);
 	const auto accuracy = TileEngine::voxelTileSize / divide;
 	const auto offsetCenter = (accuracy / 2 + Position(-1, -1, (ground ? 0 : accuracy.z/4) - tileHeight * accuracy.z / 24));
@@ -1256,7 +1337,7 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 			const auto target = tile->getPosition();
 			const auto diff = target - center;
 			const auto distance = (int)Round(Position::distance(target.toVoxel(), center.toVoxel()) / Position::TileXY);
-			const auto targetLight = tile->getLightMulti(layer);
+			const auto targetLight = hot.getLightMulti(idx, layer);
 			auto currLight = power - distance;
 
 			if (currLight <= targetLight)
@@ -1657,6 +1738,7 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 */
 bool TileEngine::calculateFOV(BattleUnit *unit, bool doTileRecalc, bool doUnitRecalc)
 {
+	PROFILE_SCOPE("TileEngine::calculateFOV(unit)");
 	//Force a full FOV recheck for this unit.
 	if (doTileRecalc) calculateTilesInFOV(unit);
 	return doUnitRecalc ? calculateUnitsInFOV(unit) : false;
@@ -1784,7 +1866,8 @@ bool TileEngine::visible(BattleUnit *currentUnit, Tile *tile)
 		int densityOfFire = 0;
 		Position voxelToTile(16, 16, 24);
 		Position trackTile(-1, -1, -1);
-		Tile *t = 0;
+		int trackIndex = 0;
+		const auto& hot = _save->getTileHotData();
 
 		for (int i = 0; i < visibleDistanceVoxels; i++)
 		{
@@ -1792,15 +1875,15 @@ bool TileEngine::visible(BattleUnit *currentUnit, Tile *tile)
 			if (trackTile != _trajectory.at(i))
 			{
 				trackTile = _trajectory.at(i);
-				t = _save->getTile(trackTile);
+				trackIndex = _save->getTileIndex(trackTile);
 			}
-			if (t->getFire() == 0)
+			if (hot.fire[trackIndex] == 0)
 			{
-				densityOfSmoke += t->getSmoke();
+				densityOfSmoke += hot.smoke[trackIndex];
 			}
 			else
 			{
-				densityOfFire += t->getFire();
+				densityOfFire += hot.fire[trackIndex];
 			}
 		}
 		visibleDistanceMaxVoxel = getMaxVoxelViewDistance(); // reset again (because of smoke formula)
@@ -1997,7 +2080,8 @@ bool TileEngine::isTileInLOS(BattleAction *action, Tile *tile)
 		int densityOfFire = 0;
 		Position voxelToTile(16, 16, 24);
 		Position trackTile(-1, -1, -1);
-		Tile *t = 0;
+		int trackIndex = 0;
+		const auto& hot = _save->getTileHotData();
 
 		for (int i = 0; i < visibleDistanceVoxels; i++)
 		{
@@ -2005,15 +2089,15 @@ bool TileEngine::isTileInLOS(BattleAction *action, Tile *tile)
 			if (trackTile != _trajectory.at(i))
 			{
 				trackTile = _trajectory.at(i);
-				t = _save->getTile(trackTile);
+				trackIndex = _save->getTileIndex(trackTile);
 			}
-			if (t->getFire() == 0)
+			if (hot.fire[trackIndex] == 0)
 			{
-				densityOfSmoke += t->getSmoke();
+				densityOfSmoke += hot.smoke[trackIndex];
 			}
 			else
 			{
-				densityOfFire += t->getFire();
+				densityOfFire += hot.fire[trackIndex];
 			}
 		}
 		visibleDistanceMaxVoxel = getMaxVoxelViewDistance(); // reset again (because of smoke formula)
@@ -2387,6 +2471,7 @@ bool TileEngine::canTargetTile(Position *originVoxel, Tile *tile, int part, Posi
  */
 void TileEngine::calculateFOV(Position position, int eventRadius, const bool updateTiles, const bool appendToTileVisibility)
 {
+	PROFILE_SCOPE("TileEngine::calculateFOV(position)");
 	int updateRadius;
 	if (eventRadius == -1)
 	{
@@ -2487,7 +2572,9 @@ std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit*
 	// no reaction on civilian turn.
 	if (_save->getSide() != FACTION_NEUTRAL)
 	{
-		for (auto* bu : *_save->getUnits())
+		std::vector<BattleUnit*> candidates;
+		_save->getUnitGrid()->findInRange(unit->getPosition(), getMaxViewDistance(), candidates);
+		for (auto* bu : candidates)
 		{
 				// not dead/unconscious
 			if (!bu->isOut() &&
@@ -3213,9 +3300,12 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	int hitSide = 0;
 	int diagonalWall = 0;
 	int power_;
-	std::map<Tile*, int> tilesAffected;
 	std::vector<BattleItem*> toRemove;
-	std::pair<std::map<Tile*, int>::iterator, bool> ret;
+
+	if (_explosionDamage.size() != (size_t)_save->getMapSizeXYZ())
+	{
+		_explosionDamage.assign(_save->getMapSizeXYZ(), -1);
+	}
 
 	if (type->FireBlastCalc)
 	{
@@ -3248,157 +3338,170 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 			hitSide = (center.x % 16 + center.y % 16 - 15) > 0 ? 1 : -1;
 	}
 
-	for (int fi = -90; fi <= 90; fi += 5)
+	// rays with the same tiles behave the same, except for the bigwall deflection that depends on the angle
+	const auto& rays = getExplosionRays();
+	const std::vector<size_t> *uniqueRays = (Options::oxceExplosionRayDedup && diagonalWall == 0) ? &getUniqueExplosionRays(maxRadius) : nullptr;
+	const size_t rayCount = uniqueRays ? uniqueRays->size() : rays.size();
+	for (size_t r = 0; r < rayCount; ++r)
 	{
-		// raytrace every 3 degrees makes sure we cover all tiles in a circle.
-		for (int te = 0; te <= 360; te += 3)
-		{
-			double cos_te = cos(Deg2Rad(te));
-			double sin_te = sin(Deg2Rad(te));
-			double sin_fi = sin(Deg2Rad(fi));
-			double cos_fi = cos(Deg2Rad(fi));
+		const ExplosionRay &ray = rays[uniqueRays ? (*uniqueRays)[r] : r];
+		const int te = ray.te;
+		const double cos_te = ray.cos_te;
+		const double sin_te = ray.sin_te;
+		const double sin_fi = ray.sin_fi;
+		const double cos_fi = ray.cos_fi;
 
-			origin = _save->getTile(centetTile);
-			dest = origin;
-			double l = 0;
-			int tileX, tileY, tileZ;
-			power_ = power;
-			while (power_ > 0 && l <= maxRadius)
+		origin = _save->getTile(centetTile);
+		dest = origin;
+		double l = 0;
+		int tileX, tileY, tileZ;
+		power_ = power;
+		while (power_ > 0 && l <= maxRadius)
+		{
+			if (power_ > 0)
 			{
-				if (power_ > 0)
+				// check if we had this tile already affected
+				const int tileIndex = _save->getTileIndex(dest->getPosition());
+				const bool firstHit = _explosionDamage[tileIndex] < 0;
+				if (firstHit)
 				{
-					ret = tilesAffected.insert(std::make_pair(dest, 0)); // check if we had this tile already affected
+					_explosionDamage[tileIndex] = 0;
+					_explosionTouched.push_back(tileIndex);
+				}
 
-					const int tileDmg = type->getTileFinalDamage(power_);
-					if (tileDmg > ret.first->second)
-					{
-						ret.first->second = tileDmg;
-					}
-					if (ret.second)
-					{
-						const int damage = type->getRandomDamage(power_);
-						BattleUnit *bu = dest->getOverlappingUnit(_save);
+				const int tileDmg = type->getTileFinalDamage(power_);
+				if (tileDmg > _explosionDamage[tileIndex])
+				{
+					_explosionDamage[tileIndex] = tileDmg;
+				}
+				if (firstHit)
+				{
+					const int damage = type->getRandomDamage(power_);
+					BattleUnit *bu = dest->getOverlappingUnit(_save);
 
-						toRemove.clear();
-						if (bu)
-						{
-							if (
-									(
-										Position::distance2dSq(dest->getPosition(), centetTile) < 4
-										&& dest->getPosition().z == centetTile.z
-									)
-									|| dest->getPosition().z > centetTile.z
+					toRemove.clear();
+					if (bu)
+					{
+						if (
+								(
+									Position::distance2dSq(dest->getPosition(), centetTile) < 4
+									&& dest->getPosition().z == centetTile.z
 								)
-							{
-								// ground zero effect is in effect, or unit is above explosion
-								hitUnit(attack, bu, Position(0, 0, 0), damage, type, rangeAtack);
-							}
-							else
-							{
-								// directional damage relative to explosion position.
-								// units above the explosion will be hit in the legs, units lateral to or below will be hit in the torso
-								hitUnit(attack, bu, centetTile + Position(0, 0, 5) - dest->getPosition(), damage, type, rangeAtack);
-							}
+								|| dest->getPosition().z > centetTile.z
+							)
+						{
+							// ground zero effect is in effect, or unit is above explosion
+							hitUnit(attack, bu, Position(0, 0, 0), damage, type, rangeAtack);
+						}
+						else
+						{
+							// directional damage relative to explosion position.
+							// units above the explosion will be hit in the legs, units lateral to or below will be hit in the torso
+							hitUnit(attack, bu, centetTile + Position(0, 0, 5) - dest->getPosition(), damage, type, rangeAtack);
+						}
 
-							// Affect all items and units in inventory
-							const int itemDamage = bu->getOverKillDamage();
-							if (itemDamage > 0)
+						// Affect all items and units in inventory
+						const int itemDamage = bu->getOverKillDamage();
+						if (itemDamage > 0)
+						{
+							for (auto* bi : *bu->getInventory())
 							{
-								for (auto* bi : *bu->getInventory())
+								if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), itemDamage, type, rangeAtack) && type->getItemFinalDamage(itemDamage) > bi->getRules()->getArmor())
 								{
-									if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), itemDamage, type, rangeAtack) && type->getItemFinalDamage(itemDamage) > bi->getRules()->getArmor())
-									{
-										toRemove.push_back(bi);
-									}
+									toRemove.push_back(bi);
 								}
 							}
 						}
-						// Affect all items and units on ground
-						for (auto* bi : *dest->getInventory())
-						{
-							if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), damage, type) && type->getItemFinalDamage(damage) > bi->getRules()->getArmor())
-							{
-								toRemove.push_back(bi);
-							}
-						}
-						for (auto* bi : toRemove)
+					}
+					// Affect all items and units on ground
+					for (auto* bi : *dest->getInventory())
+					{
+						if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), damage, type) && type->getItemFinalDamage(damage) > bi->getRules()->getArmor())
 						{
-							_save->removeItem(bi);
+							toRemove.push_back(bi);
 						}
-
-						hitTile(dest, damage, type);
 					}
+					for (auto* bi : toRemove)
+					{
+						_save->removeItem(bi);
+					}
+
+					hitTile(dest, damage, type);
 				}
+			}
 
-				l += 1.0;
+			l += 1.0;
 
-				tileX = int(floor(centetTile.x + 0.5 + l * sin_te * cos_fi));
-				tileY = int(floor(centetTile.y + 0.5 + l * cos_te * cos_fi));
-				tileZ = int(floor(centetTile.z + 0.5 + l * sin_fi));
+			tileX = int(floor(centetTile.x + 0.5 + l * sin_te * cos_fi));
+			tileY = int(floor(centetTile.y + 0.5 + l * cos_te * cos_fi));
+			tileZ = int(floor(centetTile.z + 0.5 + l * sin_fi));
 
-				origin = dest;
-				dest = _save->getTile(Position(tileX, tileY, tileZ));
+			origin = dest;
+			dest = _save->getTile(Position(tileX, tileY, tileZ));
 
-				if (!dest) break; // out of map!
+			if (!dest) break; // out of map!
 
-				// blockage by terrain is deducted from the explosion power
-				power_ -= type->RadiusReduction; // explosive damage decreases by 10 per tile
-				if (origin->getPosition().z != tileZ)
-					power_ -= vertdec; //3d explosion factor
+			// blockage by terrain is deducted from the explosion power
+			power_ -= type->RadiusReduction; // explosive damage decreases by 10 per tile
+			if (origin->getPosition().z != tileZ)
+				power_ -= vertdec; //3d explosion factor
 
-				if (type->FireBlastCalc)
+			if (type->FireBlastCalc)
+			{
+				int dir;
+				Pathfinding::vectorToDirection(origin->getPosition() - dest->getPosition(), dir);
+				if (dir != -1 && dir %2) power_ -= 0.5f * type->RadiusReduction; // diagonal movement costs an extra 50% for fire.
+			}
+			if (l > 0.5) {
+				if ( l > 1.5)
 				{
-					int dir;
-					Pathfinding::vectorToDirection(origin->getPosition() - dest->getPosition(), dir);
-					if (dir != -1 && dir %2) power_ -= 0.5f * type->RadiusReduction; // diagonal movement costs an extra 50% for fire.
+					power_ -= verticalBlockage(origin, dest, type->ResistType, false) * 2;
+					power_ -= horizontalBlockage(origin, dest, type->ResistType, false) * 2;
 				}
-				if (l > 0.5) {
-					if ( l > 1.5)
+				else //tricky bigwall deflection /Volutar
+				{
+					bool skipObject = diagonalWall == 0;
+					if (diagonalWall == Pathfinding::BIGWALLNESW) // --
 					{
-						power_ -= verticalBlockage(origin, dest, type->ResistType, false) * 2;
-						power_ -= horizontalBlockage(origin, dest, type->ResistType, false) * 2;
+						if (hitSide<0 && te >= 135 && te < 315)
+							skipObject = true;
+						if (hitSide>0 && ( te < 135 || te > 315))
+							skipObject = true;
 					}
-					else //tricky bigwall deflection /Volutar
+					if (diagonalWall == Pathfinding::BIGWALLNWSE) // |
 					{
-						bool skipObject = diagonalWall == 0;
-						if (diagonalWall == Pathfinding::BIGWALLNESW) // --
-						{
-							if (hitSide<0 && te >= 135 && te < 315)
-								skipObject = true;
-							if (hitSide>0 && ( te < 135 || te > 315))
-								skipObject = true;
-						}
-						if (diagonalWall == Pathfinding::BIGWALLNWSE) // |
-						{
-							if (hitSide>0 && te >= 45 && te < 225)
-								skipObject = true;
-							if (hitSide<0 && ( te < 45 || te > 225))
-								skipObject = true;
-						}
-						power_ -= verticalBlockage(origin, dest, type->ResistType, skipObject) * 2;
-						power_ -= horizontalBlockage(origin, dest, type->ResistType, skipObject) * 2;
-
+						if (hitSide>0 && te >= 45 && te < 225)
+							skipObject = true;
+						if (hitSide<0 && ( te < 45 || te > 225))
+							skipObject = true;
 					}
+					power_ -= verticalBlockage(origin, dest, type->ResistType, skipObject) * 2;
+					power_ -= horizontalBlockage(origin, dest, type->ResistType, skipObject) * 2;
+
 				}
 			}
 		}
 	}
 
-	// now detonate the tiles affected by explosion
-	if (type->ToTile > 0.0f)
+	// now detonate the tiles affected by explosion, in map order
+	std::sort(_explosionTouched.begin(), _explosionTouched.end());
+	for (int tileIndex : _explosionTouched)
 	{
-		for (auto& pair : tilesAffected)
+		if (type->ToTile > 0.0f)
 		{
-			if (detonate(pair.first, pair.second))
+			Tile *tile = _save->getTile(tileIndex);
+			if (detonate(tile, _explosionDamage[tileIndex]))
 			{
 				_save->addDestroyedObjective();
 			}
-			applyGravity(pair.first);
-			Tile *j = _save->getTile(pair.first->getPosition() + Position(0,0,1));
+			applyGravity(tile);
+			Tile *j = _save->getTile(tile->getPosition() + Position(0,0,1));
 			if (j)
 				applyGravity(j);
 		}
+		_explosionDamage[tileIndex] = -1;
 	}
+	_explosionTouched.clear();
 	calculateLighting(LL_AMBIENT, centetTile, maxRadius + 1, true); // roofs could have been destroyed and fires could have been started
 	calculateFOV(centetTile, maxRadius + 1, true, true);
 	if (attack.attacker && Position::distance2d(centetTile, attack.attacker->getPosition()) > maxRadius + 1)
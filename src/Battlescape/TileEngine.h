@@ -111,6 +111,10 @@ private:
 	Position _eventVisibilitySectorL, _eventVisibilitySectorR, _eventVisibilityObserverPos;
 	std::vector<BattleUnit*> _movingUnitPrev;
 	BattleUnit* _movingUnit = nullptr;
+	/// Highest damage each tile got from the current explosion, -1 for tiles it didn't reach.
+	std::vector<int> _explosionDamage;
+	/// Tiles reached by the current explosion.
+	std::vector<int> _explosionTouched;
 
 	/// Add light source.
 	void addLight(MapSubset gs, Position center, int power, LightLayers layer);
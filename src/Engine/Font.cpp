@@ -25,6 +25,12 @@
 namespace OpenXcom
 {
 
+namespace
+{
+/// Characters with a direct lookup table instead of the hash map.
+const UCode LATIN_CHARS = 256;
+}
+
 const SDL_Color Font::TerminalColors[2] = {{0, 0, 0, 0}, {185, 185, 185, 255}};
 
 /**
@@ -163,6 +169,35 @@ void Font::init(size_t index, const UString &str)
 		}
 	}
 	surface->unlock();
+
+	// Most text is Latin-1, so skip hashing for those characters
+	// (map elements never move, so the pointers stay valid)
+	_latinChars.clear();
+	_latinChars.resize(LATIN_CHARS);
+	for (UCode c = 0; c < LATIN_CHARS; ++c)
+	{
+		auto f = _chars.find(c);
+		if (f != _chars.end())
+		{
+			_latinChars[c] = &f->second;
+		}
+	}
+}
+
+/**
+ * Looks up where a character is in the font images,
+ * falling back to '?' for missing characters.
+ * @param c Character to look up.
+ * @return Image index and rectangle of the character.
+ */
+const std::pair<size_t, SDL_Rect> &Font::findChar(UCode c) const
+{
+	if (c < _latinChars.size() && _latinChars[c] != 0)
+		return *_latinChars[c];
+	auto f = _chars.find(c);
+	if (f == _chars.end())
+		f = _chars.find('?');
+	return f->second;
 }
 
 /**
@@ -173,11 +208,9 @@ void Font::init(size_t index, const UString &str)
  */
 SurfaceCrop Font::getChar(UCode c) const
 {
-	auto f = _chars.find(c);
-	if (f == _chars.end())
-		f = _chars.find('?');
-	auto surfaceCrop = _images[f->second.first].surface->getCrop();
-	*surfaceCrop.getCrop() = f->second.second;
+	const auto &f = findChar(c);
+	auto surfaceCrop = _images[f.first].surface->getCrop();
+	*surfaceCrop.getCrop() = f.second;
 	return surfaceCrop;
 }
 
@@ -220,13 +253,10 @@ SDL_Rect Font::getCharSize(UCode c) const
 	SDL_Rect size = { 0, 0, 0, 0 };
 	if (Unicode::isPrintable(c))
 	{
-		auto f = _chars.find(c);
-		if (f == _chars.end())
-			f = _chars.find('?');
-
-		const FontImage *image = &_images[f->second.first];
-		size.w = f->second.second.w + image->spacing;
-		size.h = f->second.second.h + image->spacing;
+		const auto &f = findChar(c);
+		const FontImage *image = &_images[f.first];
+		size.w = f.second.w + image->spacing;
+		size.h = f.second.h + image->spacing;
 	}
 	else
 	{
@@ -49,9 +49,12 @@ class Font
 private:
 	std::vector<FontImage> _images;
 	std::unordered_map< UCode, std::pair<size_t, SDL_Rect> > _chars;
+	std::vector<const std::pair<size_t, SDL_Rect>*> _latinChars;
 	bool _monospace;
 	/// Determines the size and position of each character in the font.
 	void init(size_t index, const UString &str);
+	/// Gets the image index and rectangle of a character.
+	const std::pair<size_t, SDL_Rect> &findChar(UCode c) const;
 public:
 
 	/// Default palette for terminal text.
@@ -30,12 +30,16 @@
 #include "Logger.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/ProfilerOverlay.h"
+#include "../Interface/Text.h"
 #include "../Mod/Mod.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "Action.h"
 #include "Exception.h"
 #include "Options.h"
+#include "Profiler.h"
+#include "Timer.h"
 #include "CrossPlatform.h"
 #include "FileMap.h"
 #include "Unicode.h"
@@ -59,7 +63,13 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	_ctrl(false), _alt(false), _shift(false), _rmb(false), _mmb(false)
 {
 	Options::reload = false;
-	Options::mute = false;
+	Options::mute = Options::headless;
+
+	// Render into memory only, without opening a window
+	if (Options::headless)
+	{
+		SDL_putenv((char *)"SDL_VIDEODRIVER=dummy");
+	}
 
 	// Initialize SDL
 	if (SDL_Init(SDL_INIT_VIDEO) < 0)
@@ -71,7 +81,10 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	Log(LOG_INFO) << "SDL initialized successfully.";
 
 	// Initialize SDL_mixer
-	initAudio();
+	if (!Options::headless)
+	{
+		initAudio();
+	}
 
 	// trap the mouse inside the window
 	SDL_WM_GrabInput(Options::captureMouse);
@@ -100,6 +113,13 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	// Create fps counter
 	_fpsCounter = new FpsCounter(15, 5, 0, 0);
 
+	// Create profiler overlay
+	_profilerOverlay = new ProfilerOverlay(Screen::ORIGINAL_WIDTH, 80, 0, 6);
+	if (Options::oxceProfilerTrace || Options::oxceProfilerOverlay)
+	{
+		Profiler::start(Options::oxceProfilerTrace);
+	}
+
 	// Create blank language
 	_lang = new Language();
 
@@ -127,6 +147,7 @@ Game::~Game()
 	delete _mod;
 	delete _screen;
 	delete _fpsCounter;
+	delete _profilerOverlay;
 
 	Mix_CloseAudio();
 
@@ -148,9 +169,13 @@ void Game::run()
 	Uint32 lastMouseMoveEvent = 0;
 	Sint16 xrel = 0;
 	Sint16 yrel = 0;
+	bool framePending = true;
 
 	while (!_quit)
 	{
+		// Only the timers running from here on decide when to wake up
+		Timer::resetNextTick();
+
 		// Clean up states
 		while (!_deleted.empty())
 		{
@@ -179,6 +204,7 @@ void Game::run()
 		}
 
 		// Process events
+		ProfilerScope eventsScope("Game::handle");
 		while (SDL_PollEvent(&_event))
 		{
 			if (CrossPlatform::isQuitShortcut(_event))
@@ -188,10 +214,15 @@ void Game::run()
 				case SDL_QUIT:
 					quit();
 					break;
+				case SDL_VIDEOEXPOSE:
+					// the window contents were lost, so only updating what changed isn't enough
+					_screen->invalidate();
+					break;
 				case SDL_ACTIVEEVENT:
 					// An event other than SDL_APPMOUSEFOCUS change happened.
 					if (reinterpret_cast<SDL_ActiveEvent*>(&_event)->state & ~SDL_APPMOUSEFOCUS)
 					{
+						_screen->invalidate();
 						Uint8 currentState = SDL_GetAppState();
 						// Game is minimized
 						if (!(currentState & SDL_APPACTIVE))
@@ -326,13 +357,18 @@ void Game::run()
 				break;
 			}
 		}
+		eventsScope.finish();
 
 		// Process rendering
 		if (runningState != PAUSED)
 		{
 			// Process logic
-			_states.back()->think();
+			{
+				PROFILE_SCOPE("Game::think");
+				_states.back()->think();
+			}
 			_fpsCounter->think();
+			_profilerOverlay->think();
 			if (Options::FPS > 0 && !(Options::useOpenGL && Options::vSyncForOpenGL))
 			{
 				// Update our FPS delay time based on the time of the last draw.
@@ -349,7 +385,9 @@ void Game::run()
 			{
 				// make a note of when this frame update occurred.
 				_timeOfLastFrame = SDL_GetTicks();
+				framePending = false;
 				_fpsCounter->addFrame();
+				ProfilerScope blitScope("Game::blit");
 				_screen->clear();
 				std::list<State*>::iterator i = _states.end();
 				do
@@ -363,7 +401,10 @@ void Game::run()
 					(*i)->blit();
 				}
 				_fpsCounter->blit(_screen->getSurface());
+				_profilerOverlay->blit(_screen->getSurface());
 				_cursor->blit(_screen->getSurface());
+				blitScope.finish();
+				PROFILE_SCOPE("Screen::flip");
 				_screen->flip();
 			}
 		}
@@ -372,16 +413,117 @@ void Game::run()
 		switch (runningState)
 		{
 			case RUNNING:
-				SDL_Delay(1); //Save CPU from going 100%
+				if (Options::oxceIdleThrottle && _init && !_quit)
+				{
+					// sleep until a timer or the next frame needs us, or the player does something
+					waitForEvents(getIdleTime(framePending));
+					framePending = true;
+				}
+				else
+				{
+					SDL_Delay(1); //Save CPU from going 100%
+				}
 				break;
 			case SLOWED: case PAUSED:
 				SDL_Delay(100); break; //More slowing down.
 		}
 	}
 
+	if (Options::oxceProfilerTrace)
+	{
+		Profiler::writeTrace(Options::getMasterUserFolder() + "profile.json");
+	}
 	Options::save();
 }
 
+/**
+ * Works out how long the game can sleep between cycles without
+ * missing anything: the next tick of the running timers, the
+ * minimum frame rate of the active state and, if something may
+ * have changed since the last frame, the time until the next frame.
+ * @param framePending Is there possibly something new to draw?
+ * @return Time in milliseconds.
+ */
+int Game::getIdleTime(bool framePending) const
+{
+	if (Options::useOpenGL && Options::vSyncForOpenGL)
+	{
+		// the frame rate is set by the flip
+		return 1;
+	}
+	int wait = IDLE_MAX_WAIT;
+	int tick = Timer::getTimeUntilNextTick();
+	if (tick >= 0)
+	{
+		wait = std::min(wait, tick);
+	}
+	int fps = _states.back()->getMinFrameRate();
+	if (fps > 0)
+	{
+		wait = std::min(wait, 1000 / fps - (int)(SDL_GetTicks() - _timeOfLastFrame));
+	}
+	if (framePending)
+	{
+		wait = std::min(wait, _timeUntilNextFrame);
+	}
+	return std::max(wait, 1);
+}
+
+/**
+ * Sleeps for a while, waking up early as soon as
+ * there are any new events to handle.
+ * @param wait Time in milliseconds.
+ */
+void Game::waitForEvents(int wait)
+{
+	Uint32 end = SDL_GetTicks() + wait;
+	SDL_Event event;
+	while (true)
+	{
+		SDL_PumpEvents();
+		if (SDL_PeepEvents(&event, 1, SDL_PEEKEVENT, SDL_ALLEVENTS) > 0)
+		{
+			break;
+		}
+		int left = (int)(end - SDL_GetTicks());
+		if (left <= 0)
+		{
+			break;
+		}
+		SDL_Delay(std::min(left, (int)IDLE_POLL_INTERVAL));
+	}
+}
+
+/**
+ * Runs a single cycle of the state machine without processing
+ * any input or rendering anything. Used by the headless tools,
+ * which drive the game logic at maximum speed.
+ */
+void Game::runHeadlessCycle()
+{
+	// Clean up states
+	while (!_deleted.empty())
+	{
+		delete _deleted.back();
+		_deleted.pop_back();
+	}
+
+	if (_states.empty())
+	{
+		return;
+	}
+
+	// Initialize active state
+	if (!_init)
+	{
+		_init = true;
+		_states.back()->init();
+	}
+
+	PROFILE_SCOPE("Game::think");
+	_states.back()->think();
+}
+
 /**
  * Stops the state machine and the game is shut down.
  */
@@ -445,7 +587,8 @@ double Game::volumeExponent(int volume)
 /**
  * Pops all the states currently in stack and pushes in the new state.
  * A shortcut for cleaning up all the old states when they're not necessary
- * like in one-way transitions.
+ * like in one-way transitions. With nothing left of the old states,
+ * it's also when the mod can free the surfaces they were using.
  * @param state Pointer to the new state.
  */
 void Game::setState(State *state)
@@ -454,6 +597,10 @@ void Game::setState(State *state)
 	{
 		popState();
 	}
+	if (_mod)
+	{
+		_mod->trimSurfaces();
+	}
 	pushState(state);
 	_init = false;
 }
@@ -498,6 +645,8 @@ void Game::setSavedGame(SavedGame *save)
 void Game::loadMods()
 {
 	Mod::resetGlobalStatics();
+	_profilerOverlay->initText(0, 0, 0);
+	Text::clearLayoutCache();
 	delete _mod;
 	_mod = new Mod();
 	_mod->loadAll();
@@ -708,7 +857,8 @@ void Game::initAudio()
  */
 bool Game::isCtrlPressed(bool considerTouchButtons) const
 {
-	if (considerTouchButtons && _ctrl)
+	// headless there's no keyboard, the flags are all there is (used by battle replays)
+	if ((considerTouchButtons || Options::headless) && _ctrl)
 	{
 		return true;
 	}
@@ -720,7 +870,7 @@ bool Game::isCtrlPressed(bool considerTouchButtons) const
  */
 bool Game::isAltPressed(bool considerTouchButtons) const
 {
-	if (considerTouchButtons && _alt)
+	if ((considerTouchButtons || Options::headless) && _alt)
 	{
 		return true;
 	}
@@ -732,7 +882,7 @@ bool Game::isAltPressed(bool considerTouchButtons) const
  */
 bool Game::isShiftPressed(bool considerTouchButtons) const
 {
-	if (considerTouchButtons && _shift)
+	if ((considerTouchButtons || Options::headless) && _shift)
 	{
 		return true;
 	}
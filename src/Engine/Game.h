@@ -32,6 +32,7 @@ class SavedGame;
 class Mod;
 class ModInfo;
 class FpsCounter;
+class ProfilerOverlay;
 class Action;
 
 /**
@@ -52,12 +53,18 @@ private:
 	Mod *_mod;
 	bool _quit, _init, _update;
 	FpsCounter *_fpsCounter;
+	ProfilerOverlay *_profilerOverlay;
 	bool _mouseActive;
 	unsigned int _timeOfLastFrame;
 	int _timeUntilNextFrame;
 	bool _ctrl, _alt, _shift, _rmb, _mmb;
 	static const double VOLUME_GRADIENT;
+	static const int IDLE_MAX_WAIT = 250, IDLE_POLL_INTERVAL = 5;
 
+	/// Gets how long the game can sleep before it needs to run again.
+	int getIdleTime(bool framePending) const;
+	/// Sleeps until input arrives or the time runs out.
+	void waitForEvents(int wait);
 public:
 	/// Creates a new game and initializes SDL.
 	Game(const std::string &title);
@@ -65,6 +72,8 @@ public:
 	~Game();
 	/// Starts the game's state machine.
 	void run();
+	/// Runs one cycle of the state machine without input or rendering.
+	void runHeadlessCycle();
 	/// Quits the game.
 	void quit();
 	/// Sets the game's audio volume.
@@ -77,6 +86,8 @@ public:
 	Cursor *getCursor() const { return _cursor; }
 	/// Gets the FpsCounter.
 	FpsCounter *getFpsCounter() const { return _fpsCounter; }
+	/// Gets the ProfilerOverlay.
+	ProfilerOverlay *getProfilerOverlay() const { return _profilerOverlay; }
 	/// Resets the state stack to a new state.
 	void setState(State *state);
 	/// Pushes a new state into the state stack.
@@ -97,6 +108,8 @@ public:
 	void setMouseActive(bool active);
 	/// Returns whether current state is the param state
 	bool isState(State *state) const;
+	/// Gets the state on top of the stack.
+	State *getTopState() const { return _states.empty() ? 0 : _states.back(); }
 	/// Returns whether a UfopaediaStartState is in the background.
 	bool containsUfopaediaStartState() const;
 	/// Returns whether a NotesState is in the background.
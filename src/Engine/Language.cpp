@@ -206,7 +206,7 @@ void Language::loadFile(const FileMap::FileRecord *frec)
 			if (!value.empty())
 			{
 				std::string key = i->first.as<std::string>();
-				_strings[key] = loadString(value);
+				setString(key, value);
 			}
 		}
 		// Strings with plurality
@@ -218,7 +218,7 @@ void Language::loadFile(const FileMap::FileRecord *frec)
 				if (!value.empty())
 				{
 					std::string key = i->first.as<std::string>() + "_" + j->first.as<std::string>();
-					_strings[key] = loadString(value);
+					setString(key, value);
 				}
 			}
 		}
@@ -237,7 +237,7 @@ void Language::loadRule(const std::map<std::string, ExtraStrings*> &extraStrings
 	{
 		for (const auto& pair : *it->second->getStrings())
 		{
-			_strings[pair.first] = loadString(pair.second);
+			setString(pair.first, pair.second);
 		}
 	}
 }
@@ -256,6 +256,77 @@ std::string Language::loadString(const std::string &string) const
 	return s;
 }
 
+/**
+ * Stores a translation, interning its ID.
+ * @param id ID of the string.
+ * @param s Text as written in the file.
+ */
+void Language::setString(const std::string &id, const std::string &s)
+{
+	StringId sid(id);
+	if (sid.getIndex() >= _strings.size())
+	{
+		_strings.resize(StringId::count());
+	}
+	_strings[sid.getIndex()] = std::make_shared<const std::string>(loadString(s));
+	_plurals.clear();
+}
+
+/**
+ * Gets the translation stored for an ID.
+ * @param id ID of the string.
+ * @return Pointer to the shared text, or null if there's none.
+ */
+const std::shared_ptr<const std::string> *Language::findString(StringId id) const
+{
+	if (id.getIndex() < _strings.size() && _strings[id.getIndex()])
+	{
+		return &_strings[id.getIndex()];
+	}
+	return 0;
+}
+
+/**
+ * Finds which form of a plural string to use for a number.
+ * The answer only depends on the language rules for the number,
+ * so it's cached for each ID and suffix (or zero). IDs without
+ * any form aren't cached, since they can be any text.
+ * @param id ID of the string, without any suffix.
+ * @param n Number to use to decide the proper form.
+ * @return ID of the form to use, or the empty ID if there's none.
+ */
+StringId Language::findPlural(const std::string &id, unsigned n) const
+{
+	const char *suffix = _handler->getSuffix(n);
+	// suffixes are interned too, so they make a compact key
+	unsigned form = n == 0 ? 0 : StringId(suffix).getIndex();
+	StringId base;
+	if (StringId::find(id, base))
+	{
+		auto cached = _plurals.find(((Uint64)base.getIndex() << 32) | form);
+		if (cached != _plurals.end())
+		{
+			return cached->second;
+		}
+	}
+
+	StringId found;
+	bool exists =
+		// Try specialized form.
+		(n == 0 && StringId::find(id + "_zero", found) && findString(found)) ||
+		// Try proper form by language
+		(StringId::find(id + suffix, found) && findString(found)) ||
+		// Try default form
+		(StringId::find(id + "_other", found) && findString(found));
+	if (!exists)
+	{
+		return StringId();
+	}
+	base = StringId(id);
+	_plurals[((Uint64)base.getIndex() << 32) | form] = found;
+	return found;
+}
+
 /**
  * Returns the localized text with the specified ID.
  * If it's not found, just returns the ID.
@@ -268,16 +339,35 @@ LocalizedText Language::getString(const std::string &id) const
 	{
 		return id;
 	}
-	auto s = _strings.find(id);
-	// Check if translation strings recently learned pluralization.
-	if (s == _strings.end())
+	StringId sid;
+	if (StringId::find(id, sid))
 	{
-		return getString(id, UINT_MAX);
+		return getString(sid);
 	}
-	else
+	// Not interned so not translated, but it could have a plural form
+	return getString(id, UINT_MAX);
+}
+
+/**
+ * Returns the localized text with the specified interned ID,
+ * sharing it instead of copying it. If it's not found, just
+ * returns the ID.
+ * @param id ID of the string.
+ * @return String with the requested ID.
+ */
+LocalizedText Language::getString(StringId id) const
+{
+	if (id.empty())
 	{
-		return s->second;
+		return LocalizedText();
 	}
+	const auto *s = findString(id);
+	// Check if translation strings recently learned pluralization.
+	if (s == 0)
+	{
+		return getString(id.str(), UINT_MAX);
+	}
+	return *s;
 }
 
 /**
@@ -292,24 +382,9 @@ LocalizedText Language::getString(const std::string &id, unsigned n) const
 {
 	assert(!id.empty());
 	static std::set<std::string> notFoundIds;
-	auto s = _strings.end();
-	// Try specialized form.
-	if (n == 0)
-	{
-		s = _strings.find(id + "_zero");
-	}
-	// Try proper form by language
-	if (s == _strings.end())
-	{
-		s = _strings.find(id + _handler->getSuffix(n));
-	}
-	// Try default form
-	if (s == _strings.end())
-	{
-		s = _strings.find(id + "_other");
-	}
+	StringId form = findPlural(id, n);
 	// Give up
-	if (s == _strings.end())
+	if (form.empty())
 	{
 		if (notFoundIds.end() == notFoundIds.find(id))
 		{
@@ -318,6 +393,7 @@ LocalizedText Language::getString(const std::string &id, unsigned n) const
 		}
 		return id;
 	}
+	const auto &s = *findString(form);
 	if (n == UINT_MAX) // Special case
 	{
 		if (notFoundIds.end() == notFoundIds.find(id))
@@ -326,13 +402,13 @@ LocalizedText Language::getString(const std::string &id, unsigned n) const
 			Log(LOG_WARNING) << id << " has plural format in ``" << Options::language << "``. Code assumes singular format.";
 //		Hint: Change ``getstring(ID).arg(value)`` to ``getString(ID, value)`` in appropriate files.
 		}
-		return s->second;
+		return s;
 	}
 	else
 	{
 		std::ostringstream ss;
 		ss << n;
-		std::string marker("{N}"), val(ss.str()), txt(s->second);
+		std::string marker("{N}"), val(ss.str()), txt(*s);
 		Unicode::replace(txt, marker, val);
 		return txt;
 	}
@@ -370,10 +446,18 @@ void Language::toHtml(const std::string &filename) const
 	std::stringstream htmlFile;
 	htmlFile << "<table border=\"1\" width=\"100%\">" << std::endl;
 	htmlFile << "<tr><th>ID String</th><th>English String</th></tr>" << std::endl;
-	for (auto& pair : _strings)
+	std::map<std::string, std::shared_ptr<const std::string> > sorted;
+	for (size_t i = 0; i < _strings.size(); ++i)
+	{
+		if (_strings[i])
+		{
+			sorted[StringId::fromIndex(i).str()] = _strings[i];
+		}
+	}
+	for (auto& pair : sorted)
 	{
 		htmlFile << "<tr><td>" << pair.first << "</td><td>";
-		std::string s = pair.second;
+		std::string s = *pair.second;
 		for (std::string::const_iterator j = s.begin(); j != s.end(); ++j)
 		{
 			if (*j == Unicode::TOK_NL_SMALL || *j == '\n')
@@ -18,9 +18,13 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
+#include <SDL_types.h>
 #include "LocalizedText.h"
+#include "StringId.h"
 #include "FileMap.h"
 
 namespace OpenXcom
@@ -37,11 +41,14 @@ enum SoldierGender : char;
 /**
  * Contains strings used throughout the game for localization.
  * Languages are just a set of strings identified by an ID string.
+ * The IDs are interned, so the strings are stored in a table
+ * indexed by StringId and looking one up by id is an array read.
  */
 class Language
 {
 private:
-	std::map<std::string, LocalizedText> _strings;
+	std::vector<std::shared_ptr<const std::string> > _strings;
+	mutable std::unordered_map<Uint64, StringId> _plurals;
 	LanguagePlurality *_handler;
 	TextDirection _direction;
 	TextWrapping _wrap;
@@ -51,6 +58,12 @@ private:
 
 	/// Parses a text string loaded from an external file.
 	std::string loadString(const std::string &s) const;
+	/// Stores a translation.
+	void setString(const std::string &id, const std::string &s);
+	/// Gets a stored translation, if any.
+	const std::shared_ptr<const std::string> *findString(StringId id) const;
+	/// Finds the proper plural form of a string ID.
+	StringId findPlural(const std::string &id, unsigned n) const;
 public:
 	/// Creates a blank language.
 	Language();
@@ -68,6 +81,8 @@ public:
 	void toHtml(const std::string &filename) const;
 	/// Get a localized text.
 	LocalizedText getString(const std::string &id) const;
+	/// Get a localized text by interned ID.
+	LocalizedText getString(StringId id) const;
 	/// Get a quantity-depended localized text.
 	LocalizedText getString(const std::string &id, unsigned n) const;
 	/// Get a gender-depended localized text.
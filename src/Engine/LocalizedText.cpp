@@ -32,10 +32,10 @@ LocalizedText LocalizedText::arg(const std::string &val) const
 	std::ostringstream os;
 	os << '{' << _nextArg << '}';
 	std::string marker(os.str());
-	size_t pos = _text.find(marker);
+	size_t pos = text().find(marker);
 	if (std::string::npos == pos)
 		return *this;
-	std::string ntext(_text);
+	std::string ntext(text());
 	for (/*empty*/ ; std::string::npos != pos; pos = ntext.find(marker, pos + val.length()))
 	{
 		ntext.replace(pos, marker.length(), val);
@@ -53,13 +53,15 @@ LocalizedText &LocalizedText::arg(const std::string &val)
 	std::ostringstream os;
 	os << '{' << _nextArg << '}';
 	std::string marker(os.str());
-	size_t pos = _text.find(marker);
+	size_t pos = text().find(marker);
 	if (std::string::npos != pos)
 	{
-		for (/*empty*/ ; std::string::npos != pos; pos = _text.find(marker, pos + val.length()))
+		std::string ntext(text());
+		for (/*empty*/ ; std::string::npos != pos; pos = ntext.find(marker, pos + val.length()))
 		{
-			_text.replace(pos, marker.length(), val);
+			ntext.replace(pos, marker.length(), val);
 		}
+		replaceText(std::move(ntext));
 		++_nextArg;
 	}
 	return *this;
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <memory>
 #include <string>
 #include <sstream>
 
@@ -39,18 +40,22 @@ namespace OpenXcom
 /**
  * A string that is already translated.
  * Using this class allows argument substitution in the translated strings.
+ * The text is shared with the language it came from until an
+ * argument is substituted, so getting a translation doesn't copy it.
  */
 class LocalizedText
 {
 public:
 	/// Create from existing string.
 	LocalizedText(const std::string &);
+	/// Create from a stored translation, sharing it.
+	LocalizedText(const std::shared_ptr<const std::string> &);
 	/// Create the empty string.
 	LocalizedText() : _nextArg(1) { /* Empty by design. */ }
 	/// Return constant string.
 	operator std::string const&() const OX_REQUIRED_RESULT;
 	/// Get a pointer to underlying char data.
-	const char *c_str() const OX_REQUIRED_RESULT { return _text.c_str(); }
+	const char *c_str() const OX_REQUIRED_RESULT { return text().c_str(); }
 
 	// Argument substitution.
 	/// Replace next argument.
@@ -59,15 +64,28 @@ public:
 	template <typename T> LocalizedText arg(T) const OX_REQUIRED_RESULT;
 	template <typename T> LocalizedText &arg(T) OX_REQUIRED_RESULT;
 private:
-	std::string _text; ///< The actual localized text.
+	std::shared_ptr<const std::string> _text; ///< The actual localized text, null if empty.
 	unsigned _nextArg; ///< The next argument ID.
 	LocalizedText(const std::string &, unsigned);
+	/// Get the text, even if there's none.
+	const std::string &text() const;
+	/// Replace the text with one that had an argument substituted.
+	void replaceText(std::string &&);
 };
 
 /**
  * Create a LocalizedText from a localized std::string.
  */
 inline LocalizedText::LocalizedText(const std::string &text)
+  : _text(std::make_shared<const std::string>(text)), _nextArg(0)
+{
+	// Empty by design.
+}
+
+/**
+ * Create a LocalizedText sharing a translation stored in a Language.
+ */
+inline LocalizedText::LocalizedText(const std::shared_ptr<const std::string> &text)
   : _text(text), _nextArg(0)
 {
 	// Empty by design.
@@ -77,18 +95,35 @@ inline LocalizedText::LocalizedText(const std::string &text)
  * Create a LocalizedText with some arguments already replaced.
  */
 inline LocalizedText::LocalizedText(const std::string &text, unsigned replaced)
-  : _text(text), _nextArg(replaced + 1)
+  : _text(std::make_shared<const std::string>(text)), _nextArg(replaced + 1)
 {
 	// Empty by design.
 }
 
+/**
+ * Get the text, or an empty string for texts created empty.
+ */
+inline const std::string &LocalizedText::text() const
+{
+	static const std::string empty;
+	return _text ? *_text : empty;
+}
+
+/**
+ * Replace the shared text with a new one, leaving the original alone.
+ */
+inline void LocalizedText::replaceText(std::string &&text)
+{
+	_text = std::make_shared<const std::string>(std::move(text));
+}
+
 /**
  * Typecast to constant std::string reference.
  * This is used to avoid copying when the string will not change.
  */
 inline LocalizedText::operator std::string const&() const
 {
-	return _text;
+	return text();
 }
 
 /**
@@ -103,10 +138,10 @@ LocalizedText LocalizedText::arg(T val) const
 	std::ostringstream os;
 	os << '{' << _nextArg << '}';
 	std::string marker(os.str());
-	size_t pos = _text.find(marker);
+	size_t pos = text().find(marker);
 	if (std::string::npos == pos)
 		return *this;
-	std::string ntext(_text);
+	std::string ntext(text());
 	os.str("");
 	os << val;
 	std::string tval(os.str());
@@ -129,16 +164,18 @@ LocalizedText &LocalizedText::arg(T val)
 	std::ostringstream os;
 	os << '{' << _nextArg << '}';
 	std::string marker(os.str());
-	size_t pos = _text.find(marker);
+	size_t pos = text().find(marker);
 	if (std::string::npos != pos)
 	{
 		os.str("");
 		os << val;
 		std::string tval(os.str());
-		for (/*empty*/ ; std::string::npos != pos; pos = _text.find(marker, pos + tval.length()))
+		std::string ntext(text());
+		for (/*empty*/ ; std::string::npos != pos; pos = ntext.find(marker, pos + tval.length()))
 		{
-			_text.replace(pos, marker.length(), tval);
+			ntext.replace(pos, marker.length(), tval);
 		}
+		replaceText(std::move(ntext));
 		++_nextArg;
 	}
 	return *this;
@@ -255,6 +255,15 @@ void create()
 	_info.push_back(OptionInfo("oxceRawScreenShots", &oxceRawScreenShots, false));
 	_info.push_back(OptionInfo("oxceFirstPersonViewFisheyeProjection", &oxceFirstPersonViewFisheyeProjection, false));
 	_info.push_back(OptionInfo("oxceThumbButtons", &oxceThumbButtons, true));
+	_info.push_back(OptionInfo("oxceProfilerTrace", &oxceProfilerTrace, false));
+	_info.push_back(OptionInfo("oxceProfilerOverlay", &oxceProfilerOverlay, false));
+	_info.push_back(OptionInfo("oxceRecordBattles", &oxceRecordBattles, false));
+	_info.push_back(OptionInfo("oxceWorkerThreads", &oxceWorkerThreads, 0)); // 0 = one per CPU core
+	_info.push_back(OptionInfo("oxceExplosionRayDedup", &oxceExplosionRayDedup, false));
+	_info.push_back(OptionInfo("oxceDirtyRectangles", &oxceDirtyRectangles, true));
+	_info.push_back(OptionInfo("oxceIdleThrottle", &oxceIdleThrottle, true));
+	_info.push_back(OptionInfo("oxceTerrainCacheSize", &oxceTerrainCacheSize, 64));
+	_info.push_back(OptionInfo("oxceResourceBudget", &oxceResourceBudget, 0)); // in MB, 0 = no limit
 
 	_info.push_back(OptionInfo("oxceRecommendedOptionsWereSet", &oxceRecommendedOptionsWereSet, false));
 	_info.push_back(OptionInfo("password", &password, "secret"));
@@ -107,6 +107,15 @@ OPT bool oxceListVFSContents;
 OPT bool oxceRawScreenShots;
 OPT bool oxceFirstPersonViewFisheyeProjection;
 OPT bool oxceThumbButtons;
+OPT bool oxceProfilerTrace;
+OPT bool oxceProfilerOverlay;
+OPT bool oxceRecordBattles;
+OPT int oxceWorkerThreads;
+OPT bool oxceExplosionRayDedup;
+OPT bool oxceDirtyRectangles;
+OPT bool oxceIdleThrottle;
+OPT int oxceTerrainCacheSize;
+OPT int oxceResourceBudget;
 
 OPT bool oxceRecommendedOptionsWereSet;
 OPT std::string password;
@@ -133,3 +142,4 @@ OPT int newDisplayWidth, newDisplayHeight, newBattlescapeScale, newGeoscapeScale
 OPT std::string newOpenGLShader;
 OPT std::vector< std::pair<std::string, bool> > mods; // ordered list of available mods (lowest priority to highest) and whether they are active
 OPT SoundFormat currentSound;
+OPT bool headless; // running without display, audio or input, see the openxcom-headless tools
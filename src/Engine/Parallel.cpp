@@ -0,0 +1,151 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
+#include "Options.h"
+
+namespace OpenXcom
+{
+
+namespace Parallel
+{
+
+namespace
+{
+
+/// Shared state of one forEach call.
+struct Job
+{
+	const std::function<void(size_t)> *func;
+	size_t count;
+	std::atomic<size_t> next;
+	std::atomic<bool> failed;
+	std::exception_ptr error;
+	SDL_mutex *mutex;
+};
+
+/**
+ * Takes indexes from the job until there are none left.
+ * The first exception stops the job and is kept for the caller.
+ * @param data Pointer to the job.
+ * @return Always 0.
+ */
+int work(void *data)
+{
+	Job *job = (Job*)data;
+	while (!job->failed)
+	{
+		size_t i = job->next++;
+		if (i >= job->count)
+		{
+			break;
+		}
+		try
+		{
+			(*job->func)(i);
+		}
+		catch (...)
+		{
+			SDL_LockMutex(job->mutex);
+			if (!job->error)
+			{
+				job->error = std::current_exception();
+			}
+			SDL_UnlockMutex(job->mutex);
+			job->failed = true;
+		}
+	}
+	return 0;
+}
+
+}
+
+/**
+ * Gets the number of threads used for parallel work,
+ * one per CPU core unless set with the oxceWorkerThreads option.
+ * @return Number of threads, including the calling one.
+ */
+int getThreadCount()
+{
+	if (Options::oxceWorkerThreads > 0)
+	{
+		return Options::oxceWorkerThreads;
+	}
+	return std::max((int)std::thread::hardware_concurrency(), 1);
+}
+
+/**
+ * Calls a function for every index in a range, spread over several threads.
+ * The calling thread takes part too, and it only returns once all
+ * the calls have finished. If any call throws, the remaining ones
+ * are skipped and the exception is rethrown here.
+ * @param count Number of indexes.
+ * @param func Function to call with each index.
+ */
+void forEach(size_t count, const std::function<void(size_t)> &func)
+{
+	size_t threads = std::min((size_t)getThreadCount(), count);
+	if (threads <= 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			func(i);
+		}
+		return;
+	}
+
+	Job job;
+	job.func = &func;
+	job.count = count;
+	job.next = 0;
+	job.failed = false;
+	job.mutex = SDL_CreateMutex();
+
+	std::vector<SDL_Thread*> workers;
+	for (size_t t = 1; t < threads; ++t)
+	{
+		// if a thread can't be created, the others just get more work
+		SDL_Thread *thread = SDL_CreateThread(work, &job);
+		if (thread != 0)
+		{
+			workers.push_back(thread);
+		}
+	}
+	work(&job);
+	for (auto* thread : workers)
+	{
+		SDL_WaitThread(thread, 0);
+	}
+	SDL_DestroyMutex(job.mutex);
+
+	if (job.error)
+	{
+		std::rethrow_exception(job.error);
+	}
+}
+
+}
+
+}
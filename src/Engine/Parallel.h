@@ -0,0 +1,39 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <functional>
+
+namespace OpenXcom
+{
+
+/**
+ * Runs independent pieces of work on several threads at once.
+ * The work must not touch anything shared that is being changed,
+ * like the UI, the logger or the random number generator.
+ */
+namespace Parallel
+{
+	/// Gets the number of threads used for parallel work.
+	int getThreadCount();
+	/// Calls a function for every index from 0 to count - 1, spread over several threads.
+	void forEach(size_t count, const std::function<void(size_t)> &func);
+}
+
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <unordered_map>
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
+#include "CrossPlatform.h"
+#include "Logger.h"
+
+namespace OpenXcom
+{
+
+namespace Profiler
+{
+
+std::atomic<bool> enabled(false);
+
+namespace
+{
+
+/// Upper limit of kept trace events, about 24MB of memory.
+const size_t MAX_TRACE_EVENTS = 1 << 20;
+
+struct TraceEvent
+{
+	const char *name;
+	Uint64 start;
+	Uint64 duration;
+	Uint32 thread;
+};
+
+struct Section
+{
+	int calls = 0;
+	Uint64 totalUs = 0;
+	Uint64 maxUs = 0;
+};
+
+bool _trace = false;
+bool _traceFull = false;
+SDL_mutex *_mutex = 0;
+std::vector<TraceEvent> _events;
+std::unordered_map<const char*, Section> _sections;
+
+}
+
+/**
+ * Starts collecting samples from all profiler scopes.
+ * @param trace Keep every sample for a Chrome trace dump?
+ */
+void start(bool trace)
+{
+	if (!_mutex)
+	{
+		_mutex = SDL_CreateMutex();
+	}
+	SDL_mutexP(_mutex);
+	_trace = trace;
+	SDL_mutexV(_mutex);
+	enabled = true;
+}
+
+/**
+ * Stops collecting samples. Already collected data is kept.
+ */
+void stop()
+{
+	enabled = false;
+}
+
+/**
+ * Gets a monotonic timestamp with microsecond resolution.
+ * @return Microseconds since an arbitrary point in the past.
+ */
+Uint64 now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Adds a finished section to the aggregated stats and the trace.
+ * Can be called from any thread.
+ * @param name Section name.
+ * @param start Start timestamp.
+ * @param end End timestamp.
+ */
+void record(const char *name, Uint64 start, Uint64 end)
+{
+	if (!enabled)
+	{
+		return;
+	}
+	Uint64 duration = end - start;
+	SDL_mutexP(_mutex);
+	Section &section = _sections[name];
+	section.calls++;
+	section.totalUs += duration;
+	section.maxUs = std::max(section.maxUs, duration);
+	if (_trace)
+	{
+		if (_events.size() < MAX_TRACE_EVENTS)
+		{
+			_events.push_back({ name, start, duration, SDL_ThreadID() });
+		}
+		else if (!_traceFull)
+		{
+			_traceFull = true;
+			Log(LOG_WARNING) << "Profiler trace buffer is full, further events are dropped.";
+		}
+	}
+	SDL_mutexV(_mutex);
+}
+
+/**
+ * Gets the aggregated timings of every section
+ * and resets them for the next interval.
+ * Sections sharing a name are merged.
+ * @return Section stats, the most expensive first.
+ */
+std::vector<SectionStats> collectStats()
+{
+	std::vector<SectionStats> stats;
+	if (!_mutex)
+	{
+		return stats;
+	}
+	SDL_mutexP(_mutex);
+	for (const auto& pair : _sections)
+	{
+		auto it = std::find_if(stats.begin(), stats.end(), [&](const SectionStats &s) { return s.name == pair.first; });
+		if (it == stats.end())
+		{
+			it = stats.insert(stats.end(), SectionStats());
+			it->name = pair.first;
+		}
+		it->calls += pair.second.calls;
+		it->totalUs += pair.second.totalUs;
+		it->maxUs = std::max(it->maxUs, pair.second.maxUs);
+	}
+	_sections.clear();
+	SDL_mutexV(_mutex);
+	std::sort(stats.begin(), stats.end(), [](const SectionStats &a, const SectionStats &b) { return a.totalUs > b.totalUs; });
+	return stats;
+}
+
+/**
+ * Saves the recorded events in the Chrome trace event format,
+ * viewable in chrome://tracing or Perfetto.
+ * @param filename Full path of the output file.
+ * @return True if the file was written.
+ */
+bool writeTrace(const std::string &filename)
+{
+	if (!_mutex || !_trace)
+	{
+		return false;
+	}
+	std::ostringstream out;
+	SDL_mutexP(_mutex);
+	Uint64 origin = _events.empty() ? 0 : _events.front().start;
+	for (const auto &e : _events)
+	{
+		origin = std::min(origin, e.start);
+	}
+	out << "{\"traceEvents\":[";
+	for (size_t i = 0; i < _events.size(); ++i)
+	{
+		const TraceEvent &e = _events[i];
+		if (i > 0)
+		{
+			out << ",";
+		}
+		out << "\n{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+			<< ",\"ts\":" << (e.start - origin) << ",\"dur\":" << e.duration << "}";
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	size_t count = _events.size();
+	SDL_mutexV(_mutex);
+
+	if (!CrossPlatform::writeFile(filename, out.str()))
+	{
+		Log(LOG_ERROR) << "Failed to save profiler trace to " << filename;
+		return false;
+	}
+	Log(LOG_INFO) << "Profiler trace with " << count << " events saved to " << filename;
+	return true;
+}
+
+}
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Lightweight instrumenting profiler.
+ * Named scopes report their wall-clock duration, which is aggregated
+ * per section for the on-screen overlay and optionally recorded
+ * as events that can be saved in the Chrome trace format.
+ * When disabled, a scope costs a single flag check.
+ */
+namespace Profiler
+{
+	/// Aggregated timings of one named section.
+	struct SectionStats
+	{
+		std::string name;
+		int calls = 0;
+		Uint64 totalUs = 0;
+		Uint64 maxUs = 0;
+	};
+
+	/// Is the profiler collecting samples? Read by every scope, on any thread.
+	extern std::atomic<bool> enabled;
+
+	/// Starts collecting samples, optionally keeping trace events.
+	void start(bool trace);
+	/// Stops collecting samples.
+	void stop();
+	/// Gets the current time in microseconds.
+	Uint64 now();
+	/// Records a finished section.
+	void record(const char *name, Uint64 start, Uint64 end);
+	/// Gets the section timings collected since the last call, sorted by total time.
+	std::vector<SectionStats> collectStats();
+	/// Saves all recorded trace events as Chrome trace JSON.
+	bool writeTrace(const std::string &filename);
+}
+
+/**
+ * Measures the time spent until the end of the enclosing scope
+ * and reports it to the profiler under the given name.
+ * @note The name must be a string literal, it's stored by pointer.
+ */
+class ProfilerScope
+{
+private:
+	const char *_name;
+	Uint64 _start;
+public:
+	/// Starts timing a section.
+	explicit ProfilerScope(const char *name) : _name(name), _start(Profiler::enabled ? Profiler::now() : 0) { }
+	/// Reports the timed section.
+	~ProfilerScope() { finish(); }
+	/// Reports the timed section before the end of the scope.
+	void finish() { if (_start) { Profiler::record(_name, _start, Profiler::now()); _start = 0; } }
+	ProfilerScope(const ProfilerScope&) = delete;
+	ProfilerScope& operator=(const ProfilerScope&) = delete;
+};
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+/// Times the rest of the current scope as a profiler section.
+#define PROFILE_SCOPE(name) ProfilerScope PROFILER_CONCAT(profilerScope, __LINE__)(name)
+
+}
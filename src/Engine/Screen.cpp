@@ -23,6 +23,7 @@
 #include <iomanip>
 #include <climits>
 #include <cstdio>
+#include <cstring>
 #include "../lodepng.h"
 #include "Exception.h"
 #include "Surface.h"
@@ -112,7 +113,7 @@ void Screen::makeVideoFlags()
  * Initializes a new display screen for the game to render contents to.
  * The screen is set up based on the current options.
  */
-Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false)
+Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false), _fullUpdate(true)
 {
 	_flickerFix = Options::oxceEnablePaletteFlickerFix;
 
@@ -201,7 +202,34 @@ void Screen::flip()
 		_pushPalette = false;
 	}
 
-	if (getWidth() != _baseWidth || getHeight() != _baseHeight || useOpenGL())
+	// Most screens sit idle for seconds at a time, so only the parts that
+	// changed are sent to the window, or nothing at all. The whole window
+	// is still updated after palette changes (the same pixels look different),
+	// and when scaling or with OpenGL as soon as anything changed, since
+	// those redraw the whole window every time anyway.
+	bool full = _fullUpdate || !Options::oxceDirtyRectangles;
+	_fullUpdate = false;
+	findDamage();
+	if (!full && _damage.empty())
+	{
+		return;
+	}
+	bool scaled = getWidth() != _baseWidth || getHeight() != _baseHeight || useOpenGL();
+	// with real page flipping the back buffer is a frame behind, so it all has to be redrawn
+	bool pageFlip = (_screen->flags & (SDL_HWSURFACE | SDL_DOUBLEBUF)) == (SDL_HWSURFACE | SDL_DOUBLEBUF);
+	if (!full && !scaled && !pageFlip)
+	{
+		for (auto& rect : _damage)
+		{
+			SDL_Rect dst = rect;
+			SDL_BlitSurface(_surface.get(), &rect, _screen, &dst);
+		}
+		SDL_UpdateRects(_screen, (int)_damage.size(), _damage.data());
+		return;
+	}
+
+	Surface::CleanSdlSurface(_screen);
+	if (scaled)
 	{
 		Zoom::flipWithZoom(_surface.get(), _screen, _topBlackBand, _bottomBlackBand, _leftBlackBand, _rightBlackBand, &glOutput);
 	}
@@ -229,13 +257,69 @@ void Screen::flip()
 	}
 }
 
+/**
+ * Compares the buffer with the last frame in bands of rows,
+ * collecting the changed bands (merged together when next to
+ * each other) and remembering them for the next frame.
+ */
+void Screen::findDamage()
+{
+	const int BAND = 8;
+	_damage.clear();
+	int rowBytes = _surface->w * _surface->format->BytesPerPixel;
+	size_t frameSize = (size_t)rowBytes * _surface->h;
+	if (_lastFrame.size() != frameSize)
+	{
+		_lastFrame.assign(frameSize, 0);
+	}
+
+	const Uint8 *pixels = (const Uint8*)_surface->pixels;
+	for (int y = 0; y < _surface->h; y += BAND)
+	{
+		int rows = std::min(BAND, _surface->h - y);
+		bool changed = false;
+		for (int row = y; row < y + rows; ++row)
+		{
+			const Uint8 *src = pixels + (size_t)row * _surface->pitch;
+			Uint8 *last = &_lastFrame[(size_t)row * rowBytes];
+			if (changed || memcmp(src, last, rowBytes) != 0)
+			{
+				memcpy(last, src, rowBytes);
+				changed = true;
+			}
+		}
+		if (!changed)
+		{
+			continue;
+		}
+		if (!_damage.empty() && _damage.back().y + _damage.back().h == y)
+		{
+			_damage.back().h += rows;
+		}
+		else
+		{
+			SDL_Rect rect = { 0, (Sint16)y, (Uint16)_surface->w, (Uint16)rows };
+			_damage.push_back(rect);
+		}
+	}
+}
+
 /**
  * Clears all the contents out of the internal buffer.
+ * The window itself is cleared on the next full update.
  */
 void Screen::clear()
 {
 	Surface::CleanSdlSurface(_surface.get());
-	Surface::CleanSdlSurface(_screen);
+}
+
+/**
+ * Makes the next flip redraw the whole window instead of just
+ * what changed, for when the window contents were lost.
+ */
+void Screen::invalidate()
+{
+	_fullUpdate = true;
 }
 
 /**
@@ -263,6 +347,8 @@ void Screen::setPalette(const SDL_Color* colors, int firstcolor, int ncolors, bo
 	}
 
 	SDL_SetColors(_surface.get(), const_cast<SDL_Color *>(colors), firstcolor, ncolors);
+	// the same pixels look different now, so they all have to be shown again
+	_fullUpdate = true;
 
 	// defer actual update of screen until SDL_Flip()
 	if (immediately && _screen->format->BitsPerPixel == 8 && SDL_SetColors(_screen, const_cast<SDL_Color *>(colors), firstcolor, ncolors) == 0)
@@ -392,6 +478,7 @@ void Screen::resetDisplay(bool resetVideo, bool noShaders)
 
 	Options::displayWidth = getWidth();
 	Options::displayHeight = getHeight();
+	_fullUpdate = true;
 	_scaleX = getWidth() / (double)_baseWidth;
 	_scaleY = getHeight() / (double)_baseHeight;
 
@@ -19,6 +19,7 @@
  */
 #include <SDL.h>
 #include <string>
+#include <vector>
 #include "OpenGL.h"
 #include "Surface.h"
 
@@ -52,8 +53,13 @@ private:
 	OpenGL glOutput;
 	Surface::UniqueBufferPtr _buffer;
 	Surface::UniqueSurfacePtr _surface;
+	std::vector<Uint8> _lastFrame;
+	std::vector<SDL_Rect> _damage;
+	bool _fullUpdate;
 	/// Sets the _flags and _bpp variables based on game options; needed in more than one place now
 	void makeVideoFlags();
+	/// Finds the parts of the buffer that changed since the last frame.
+	void findDamage();
 public:
 	static const int ORIGINAL_WIDTH;
 	static const int ORIGINAL_HEIGHT;
@@ -74,6 +80,8 @@ public:
 	void flip();
 	/// Clears the screen.
 	void clear();
+	/// Makes the next flip update the whole window.
+	void invalidate();
 	/// Sets the screen's 8bpp palette.
 	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256, bool immediately = false);
 	/// Gets the screen's 8bpp palette.
@@ -129,4 +129,13 @@ void Sound::stopLoop()
 	}
 }
 
+/**
+ * Returns the size of the decoded sound data.
+ * @return Size in bytes, 0 if nothing is loaded.
+ */
+size_t Sound::getSize() const
+{
+	return _sound ? _sound->alen : 0;
+}
+
 }
@@ -67,6 +67,8 @@ public:
 	void loop();
 	/// Stops the looping sound effect.
 	void stopLoop();
+	/// Gets the size of the sound data.
+	size_t getSize() const;
 };
 
 }
@@ -157,6 +157,21 @@ size_t SoundSet::getTotalSounds() const
 	return _sounds.size();
 }
 
+/**
+ * Returns the memory taken by the decoded
+ * sounds stored in the set.
+ * @return Size in bytes.
+ */
+size_t SoundSet::getTotalSize() const
+{
+	size_t size = 0;
+	for (const auto& pair : _sounds)
+	{
+		size += pair.second.getSize();
+	}
+	return size;
+}
+
 /**
  * Loads individual contents of a sound CAT file by index.
  * a set of sound files. The CAT starts with an index of the offset
@@ -59,6 +59,8 @@ public:
 
 	/// Gets the total sounds in the set.
 	size_t getTotalSounds() const;
+	/// Gets the memory taken by the sounds in the set.
+	size_t getTotalSize() const;
 	/// Loads a specific entry from a CAT file into the soundset.
 	void loadCatByIndex(CatFile &sndFile, int index, bool tftd = false);
 };
@@ -35,6 +35,7 @@
 #include "../Interface/ComboBox.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/ProfilerOverlay.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Mod/RuleInterface.h"
 
@@ -49,7 +50,7 @@ Game* State::_game = 0;
  * By default states are full-screen.
  * @param game Pointer to the core game.
  */
-State::State() : _screen(true), _soundPlayed(false), _modal(0), _ruleInterface(0), _ruleInterfaceParent(0), _customSound(nullptr)
+State::State() : _screen(true), _minFrameRate(0), _soundPlayed(false), _modal(0), _ruleInterface(0), _ruleInterfaceParent(0), _customSound(nullptr)
 {
 	// initialize palette to all black
 	memset(_palette, 0, sizeof(_palette));
@@ -127,7 +128,7 @@ void State::setInterface(const std::string& category, bool alterPal, SavedBattle
 void State::setWindowBackground(Window *window, const std::string &s)
 {
 	auto& bgImageName = _game->getMod()->getInterface(s)->getBackgroundImage();
-	auto* bgImage = _game->getMod()->getSurface(bgImageName);
+	auto* bgImage = _game->getMod()->getStateSurface(bgImageName);
 	window->setBackground(bgImage);
 }
 
@@ -246,6 +247,18 @@ void State::toggleScreen()
 	_screen = !_screen;
 }
 
+/**
+ * Returns the lowest rate the state must be run at
+ * when the game is idle. Most states only change on input
+ * or on their timers, so they don't need one, but states
+ * animating on their own can set it to keep running smoothly.
+ * @return Frames per second, 0 for none.
+ */
+int State::getMinFrameRate() const
+{
+	return _minFrameRate;
+}
+
 /**
  * Initializes the state and its child elements. This is
  * used for settings that have to be reset every time the
@@ -263,6 +276,12 @@ void State::init()
 	_game->getFpsCounter()->setPalette(_palette);
 	_game->getFpsCounter()->setColor(_cursorColor);
 	_game->getFpsCounter()->draw();
+	_game->getProfilerOverlay()->setPalette(_palette);
+	_game->getProfilerOverlay()->setColor(_cursorColor);
+	if (_game->getMod())
+	{
+		_game->getProfilerOverlay()->initText(_game->getMod()->getFont("FONT_BIG", false), _game->getMod()->getFont("FONT_SMALL", false), _game->getLanguage());
+	}
 
 	// Highest priority: custom sound set explicitly in the code
 	// Medium priority: sound defined by the interface ruleset
@@ -396,6 +415,17 @@ LocalizedText State::tr(const std::string &id) const
 	return _game->getLanguage()->getString(id);
 }
 
+/**
+ * Get the localized text for an interned dictionary key @a id.
+ * This function forwards the call to Language::getString(StringId).
+ * @param id The dictionary key to search for.
+ * @return The localized text.
+ */
+LocalizedText State::tr(StringId id) const
+{
+	return _game->getLanguage()->getString(id);
+}
+
 /**
 * Get the localized text from dictionary.
 * This function forwards the call to Language::getString(const std::string &).
@@ -549,6 +579,7 @@ void State::setModPalette()
 		_game->getCursor()->draw();
 		_game->getFpsCounter()->setPalette(_palette);
 		_game->getFpsCounter()->draw();
+		_game->getProfilerOverlay()->setPalette(_palette);
 	}
 }
 
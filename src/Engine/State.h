@@ -21,6 +21,7 @@
 #include <string>
 #include <SDL.h>
 #include "LocalizedText.h"
+#include "StringId.h"
 
 namespace OpenXcom
 {
@@ -52,6 +53,7 @@ protected:
 	static Game *_game;
 	std::vector<Surface*> _surfaces;
 	bool _screen;
+	int _minFrameRate;
 	bool _soundPlayed;
 	InteractiveSurface *_modal;
 	RuleInterface *_ruleInterface;
@@ -77,6 +79,8 @@ public:
 	bool isScreen() const;
 	/// Toggles whether the state is a full-screen.
 	void toggleScreen();
+	/// Gets how many times per second the state must run at least.
+	int getMinFrameRate() const;
 	/// Initializes the state.
 	virtual void init();
 	/// Handles any events.
@@ -94,6 +98,8 @@ public:
 	/// Get the localized text.
 	LocalizedText tr(const std::string &id) const;
 	/// Get the localized text.
+	LocalizedText tr(StringId id) const;
+	/// Get the localized text.
 	LocalizedText trAlt(const std::string &id, int alt) const;
 	/// Get the localized text.
 	LocalizedText tr(const std::string &id, unsigned n) const;
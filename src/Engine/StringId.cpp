@@ -0,0 +1,108 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "StringId.h"
+#include <unordered_map>
+#include <vector>
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// All the interned strings, by number and by content.
+struct StringTable
+{
+	std::unordered_map<std::string, unsigned> index;
+	std::vector<const std::string*> strings;
+
+	StringTable()
+	{
+		strings.push_back(&index.emplace(std::string(), 0).first->first);
+	}
+};
+
+/**
+ * Gets the string table, created on first use so
+ * ids can be interned during static initialization.
+ * @return The string table.
+ */
+StringTable &getTable()
+{
+	static StringTable table;
+	return table;
+}
+
+}
+
+/**
+ * Interns a string, giving it a new number if it's not known yet.
+ * @param str String to intern.
+ */
+StringId::StringId(const std::string &str)
+{
+	StringTable &table = getTable();
+	auto i = table.index.emplace(str, (unsigned)table.strings.size());
+	if (i.second)
+	{
+		// map keys never move, so they can be pointed to
+		table.strings.push_back(&i.first->first);
+	}
+	_index = i.first->second;
+}
+
+/**
+ * Looks up a string without interning it, for strings
+ * from outside that would just fill the table.
+ * @param str String to look up.
+ * @param id Set to the id of the string, if found.
+ * @return True if the string was interned before.
+ */
+bool StringId::find(const std::string &str, StringId &id)
+{
+	StringTable &table = getTable();
+	auto i = table.index.find(str);
+	if (i == table.index.end())
+	{
+		return false;
+	}
+	id = StringId(i->second);
+	return true;
+}
+
+/**
+ * Gets the number of strings interned so far,
+ * which is one more than the highest id.
+ * @return Number of strings.
+ */
+size_t StringId::count()
+{
+	return getTable().strings.size();
+}
+
+/**
+ * Gets the string this id stands for.
+ * @return Reference to the interned string.
+ */
+const std::string &StringId::str() const
+{
+	return *getTable().strings[_index];
+}
+
+}
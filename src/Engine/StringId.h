@@ -0,0 +1,71 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <functional>
+
+namespace OpenXcom
+{
+
+/**
+ * An interned string, usually a string ID like "STR_RIFLE".
+ * Every distinct string gets a small number for the whole session,
+ * so ids can be resolved once (e.g. when rules load) and then
+ * compared, hashed or used as array indexes without touching the
+ * characters. Id 0 is the empty string.
+ * @note Interning isn't thread-safe, it should only be done on the main thread.
+ */
+class StringId
+{
+private:
+	unsigned _index;
+	explicit StringId(unsigned index) : _index(index) { }
+public:
+	/// Creates the id of the empty string.
+	StringId() : _index(0) { }
+	/// Interns a string.
+	explicit StringId(const std::string &str);
+	/// Gets the id of a string only if it was interned before.
+	static bool find(const std::string &str, StringId &id);
+	/// Gets the number of interned strings.
+	static size_t count();
+	/// Gets the id with a given number.
+	static StringId fromIndex(unsigned index) { return StringId(index); }
+	/// Gets the interned string.
+	const std::string &str() const;
+	/// Gets the number of the string.
+	unsigned getIndex() const { return _index; }
+	/// Is this the empty string?
+	bool empty() const { return _index == 0; }
+
+	bool operator==(StringId other) const { return _index == other._index; }
+	bool operator!=(StringId other) const { return _index != other._index; }
+	bool operator<(StringId other) const { return _index < other._index; }
+};
+
+}
+
+namespace std
+{
+	template<>
+	struct hash<OpenXcom::StringId>
+	{
+		size_t operator()(OpenXcom::StringId id) const { return id.getIndex(); }
+	};
+}
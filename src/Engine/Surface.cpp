@@ -21,6 +21,7 @@
 #include "ShaderMove.h"
 #include <vector>
 #include <algorithm>
+#include <sstream>
 #include <SDL_gfxPrimitives.h>
 #include <SDL_image.h>
 #include "../lodepng.h"
@@ -351,6 +352,67 @@ void Surface::loadScr(const std::string& filename)
 	std::vector<char> buffer((std::istreambuf_iterator<char>(*(istream))), (std::istreambuf_iterator<char>()));
 	loadRaw(buffer);
 }
+/**
+ * Decodes an 8bpp PNG image already read into memory,
+ * replacing the surface. Doesn't use any shared state,
+ * so different surfaces can be decoded at the same time.
+ * @param data Contents of the PNG file.
+ * @param size Size of the file in bytes.
+ * @param message Set to a description of any problem found.
+ * @return True if the image was loaded, false if it's not
+ * a valid 8bpp PNG (message explains why, if it is a PNG).
+ */
+bool Surface::loadPng(const void *data, size_t size, std::string &message)
+{
+	// minimal PNG file size: header and two empty chunks
+	if (size <= 8 + 12 + 12)
+	{
+		return false;
+	}
+
+	std::vector<unsigned char> image;
+	unsigned width, height;
+	lodepng::State state;
+	state.decoder.color_convert = 0;
+	unsigned error = lodepng::decode(image, width, height, state, (const unsigned char*)data, size);
+	if (error)
+	{
+		message = std::string(" lodepng failed:") + lodepng_error_text(error);
+		return false;
+	}
+
+	LodePNGColorMode *color = &state.info_png.color;
+	if (lodepng_get_bpp(color) != 8)
+	{
+		return false;
+	}
+
+	*this = Surface(width, height, 0, 0);
+	setPalette((SDL_Color*)color->palette, 0, color->palettesize);
+	lock();
+	rawCopy(image);
+	unlock();
+
+	int transparent = 0;
+	for (int c = 0; c < _surface->format->palette->ncolors; ++c)
+	{
+		SDL_Color *palColor = _surface->format->palette->colors + c;
+		if (palColor->unused == 0)
+		{
+			transparent = c;
+			break;
+		}
+	}
+	FixTransparent(_surface, transparent);
+	if (transparent != 0)
+	{
+		std::ostringstream ss;
+		ss << " (from lodepng) has incorrect transparent color index " << transparent << " (instead of 0).";
+		message = ss.str();
+	}
+	return true;
+}
+
 /**
  * Loads the contents of an image file of a
  * known format into the surface.
@@ -371,55 +433,22 @@ void Surface::loadImage(const std::string &filename)
 	{
 		size_t size;
 		void *data = SDL_LoadFile_RW(rw, &size, SDL_FALSE);
-		if ((data != NULL) && (size > 8 + 12 + 12)) // minimal PNG file size: header and two empty chunks
+		if (data != NULL)
 		{
-			std::vector<unsigned char> png;
-			png.resize(size);
-			memcpy(&png[0], data, size);
-
-			std::vector<unsigned char> image;
-			unsigned width, height;
-			lodepng::State state;
-			state.decoder.color_convert = 0;
-			unsigned error = lodepng::decode(image, width, height, state, png);
-			if (!error)
+			std::string message;
+			if (loadPng(data, size, message))
 			{
-				LodePNGColorMode *color = &state.info_png.color;
-				unsigned bpp = lodepng_get_bpp(color);
-				if (bpp == 8)
+				if (!message.empty())
 				{
-					*this = Surface(width, height, 0, 0);
-					setPalette((SDL_Color*)color->palette, 0, color->palettesize);
-
-					ShaderDrawFunc(
-						[](Uint8& dest, unsigned char& src)
-						{
-							dest = src;
-						},
-						ShaderSurface(this),
-						ShaderSurface(SurfaceRaw<unsigned char>(image, width, height))
-					);
-					int transparent = 0;
-					for (int c = 0; c < _surface->format->palette->ncolors; ++c)
-					{
-						SDL_Color *palColor = _surface->format->palette->colors + c;
-						if (palColor->unused == 0)
-						{
-							transparent = c;
-							break;
-						}
-					}
-					FixTransparent(_surface, transparent);
-					if (transparent != 0)
-					{
-						Log(LOG_WARNING) << "Image " << filename << " (from lodepng) has incorrect transparent color index " << transparent << " (instead of 0).";
-					}
+					Log(LOG_WARNING) << "Image " << filename << message;
 				}
-			} else {
-				Log(LOG_ERROR) << "Image " << filename << " lodepng failed:" << lodepng_error_text(error);
 			}
+			else if (!message.empty())
+			{
+				Log(LOG_ERROR) << "Image " << filename << message;
+			}
+			SDL_free(data);
 		}
-		if (data) { SDL_free(data); }
 	}
 	if (_surface)
 	{
@@ -129,6 +129,8 @@ public:
 	void loadBdy(const std::string &filename);
 	/// Loads a general image file.
 	void loadImage(const std::string &filename);
+	/// Decodes a PNG image already in memory into the surface.
+	bool loadPng(const void *data, size_t size, std::string &message);
 	/// Clears the surface's contents with a specified colour.
 	void clear();
 	/// Offsets the surface's colors by a set amount.
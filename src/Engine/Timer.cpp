@@ -27,8 +27,15 @@ namespace
 {
 
 const Uint32 accurate = 4;
+Uint32 headlessTime = 0;
+Uint32 nextTick = 0;
+bool nextTickSet = false;
 Uint32 slowTick()
 {
+	if (Options::headless)
+	{
+		return headlessTime;
+	}
 	static Uint32 old_time = SDL_GetTicks();
 	static Uint64 false_time = static_cast<Uint64>(old_time) << accurate;
 	Uint64 new_time = ((Uint64)SDL_GetTicks()) << accurate;
@@ -37,6 +44,20 @@ Uint32 slowTick()
 	return false_time >> accurate;
 }
 
+/**
+ * Keeps track of the earliest tick of the running timers,
+ * so the game knows how long it can sleep.
+ * @param tick Time of the tick, in timer ticks.
+ */
+void noteTick(Uint32 tick)
+{
+	if (!nextTickSet || (Sint32)(tick - nextTick) < 0)
+	{
+		nextTick = tick;
+		nextTickSet = true;
+	}
+}
+
 }//namespace
 
 Uint32 Timer::gameSlowSpeed = 1;
@@ -67,6 +88,7 @@ void Timer::start()
 {
 	_frameSkipStart = _start = slowTick();
 	_running = true;
+	noteTick(_frameSkipStart + _interval);
 }
 
 /**
@@ -134,7 +156,49 @@ void Timer::think(State* state, Surface* surface)
 			_start = slowTick();
 			if (_start > _frameSkipStart) _frameSkipStart = _start; // don't play animations in ffwd to catch up :P
 		}
+		if (_running)
+		{
+			noteTick(_frameSkipStart + _interval);
+		}
+	}
+}
+
+/**
+ * Forgets the ticks noted so far, so only the timers
+ * that run after this count towards the next tick.
+ */
+void Timer::resetNextTick()
+{
+	nextTickSet = false;
+}
+
+/**
+ * Gets how long until the earliest tick of all the timers
+ * that were started or advanced since the last reset.
+ * @return Real time in milliseconds (0 if already due), or -1 if no timer is running.
+ */
+int Timer::getTimeUntilNextTick()
+{
+	if (!nextTickSet)
+	{
+		return -1;
 	}
+	Sint32 wait = (Sint32)(nextTick - slowTick());
+	if (wait <= 0)
+	{
+		return 0;
+	}
+	return wait * (int)gameSlowSpeed;
+}
+
+/**
+ * Moves the clock used by all timers forward when running headless,
+ * where no real time is involved so the game logic can run at full speed.
+ * @param time Time in milliseconds.
+ */
+void Timer::advanceHeadlessTime(Uint32 time)
+{
+	headlessTime += time;
 }
 
 /**
@@ -67,6 +67,12 @@ public:
 	void onTimer(StateHandler handler);
 	/// Hooks a surface action handler to the timer interval.
 	void onTimer(SurfaceHandler handler);
+	/// Forgets the next tick noted by the running timers.
+	static void resetNextTick();
+	/// Gets the real time until the next tick of the running timers.
+	static int getTimeUntilNextTick();
+	/// Advances the clock of all timers in headless mode.
+	static void advanceHeadlessTime(Uint32 time);
 };
 
 }
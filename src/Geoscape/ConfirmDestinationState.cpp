@@ -320,7 +320,7 @@ void ConfirmDestinationState::btnOkClick(Action *)
 			craft->setIsAutoPatrolling(false);
 		}
 
-		craft->setStatus("STR_OUT");
+		craft->setStatus(CS_OUT);
 	}
 
 	_game->popState();
@@ -368,8 +368,8 @@ void ConfirmDestinationState::btnTransferClick(Action *)
 			{
 				soldier->setPsiTraining(false);
 				soldier->setTraining(false);
-				targetBase->getSoldiers()->push_back(soldier);
-				soldierIt = currentBase->getSoldiers()->erase(soldierIt);
+				targetBase->addSoldier(soldier);
+				soldierIt = currentBase->removeSoldier(soldierIt);
 			}
 			else
 			{
@@ -379,10 +379,10 @@ void ConfirmDestinationState::btnTransferClick(Action *)
 
 		// Transfer craft
 		currentBase->removeCraft(_crafts.front(), false);
-		targetBase->getCrafts()->push_back(_crafts.front());
+		targetBase->addCraft(_crafts.front());
 		_crafts.front()->setBase(targetBase, false);
 		_crafts.front()->returnToBase();
-		_crafts.front()->setStatus("STR_OUT");
+		_crafts.front()->setStatus(CS_OUT);
 		if (_crafts.front()->getFuel() <= _crafts.front()->getFuelLimit(targetBase))
 		{
 			_crafts.front()->setLowFuel(true);
@@ -0,0 +1,1402 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Dogfight.h"
+#include <algorithm>
+#include "GeoscapeState.h"
+#include "Globe.h"
+#include "../Engine/Collections.h"
+#include "../Engine/Game.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Mod/AlienRace.h"
+#include "../Mod/Mod.h"
+#include "../Mod/RuleCountry.h"
+#include "../Mod/RuleCraftWeapon.h"
+#include "../Mod/RuleRegion.h"
+#include "../Mod/RuleSoldier.h"
+#include "../Mod/RuleUfo.h"
+#include "../Savegame/AlienMission.h"
+#include "../Savegame/Base.h"
+#include "../Savegame/Country.h"
+#include "../Savegame/Craft.h"
+#include "../Savegame/CraftWeapon.h"
+#include "../Savegame/CraftWeaponProjectile.h"
+#include "../Savegame/Region.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/Soldier.h"
+#include "../Savegame/Ufo.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Sets up the dogfight and takes the craft into it.
+ * @param game Pointer to the core game.
+ * @param state Pointer to the Geoscape, or 0 to fight without one (the UFO is then
+ * always over land, and no retaliation or pilot experience comes out of it).
+ * @param craft Pointer to the craft intercepting.
+ * @param ufo Pointer to the UFO being intercepted.
+ * @param ufoIsAttacking Is UFO the aggressor?
+ */
+Dogfight::Dogfight(Game *game, GeoscapeState *state, Craft *craft, Ufo *ufo, bool ufoIsAttacking) :
+	_game(game), _state(state), _craft(craft), _ufo(ufo), _mode(ufoIsAttacking ? DM_AGGRESSIVE : DM_STANDOFF),
+	_ufoIsAttacking(ufoIsAttacking), _disableDisengage(false), _disableCautious(false), _craftIsDefenseless(false), _selfDestructPressed(false),
+	_timeout(50), _currentDist(640), _targetDist(560),
+	_end(false), _endUfoHandled(false), _endCraftHandled(false), _ufoBreakingOff(false), _destroyUfo(false), _destroyCraft(false),
+	_minimized(false), _endDogfight(false), _animatingHit(false), _ufoSize(0), _interceptionNumber(0),
+	_firedAtLeastOnce(false), _experienceAwarded(false),
+	_feedback(true), _status(ufoIsAttacking ? "STR_AGGRESSIVE_ATTACK" : "STR_STANDOFF"),
+	_statusChanged(true), _ammoChanged(true), _craftShieldChanged(true), _craftDamageChanged(true)
+{
+	_craft->setInDogfight(true);
+	_weaponNum = _craft->getRules()->getWeapons();
+	if (_weaponNum > RuleCraft::WeaponMax)
+		_weaponNum = RuleCraft::WeaponMax;
+
+	for (int i = 0; i < _weaponNum; ++i)
+	{
+		_weaponEnabled[i] = true;
+		_weaponFireInterval[i] = 0;
+		_weaponFireCountdown[i] = 0;
+		_tractorLockedOn[i] = false;
+
+		CraftWeapon* w = _craft->getWeapons()->at(i);
+		if (w)
+		{
+			_weaponEnabled[i] = !w->isDisabled();
+		}
+	}
+
+	// pilot modifiers
+	const std::vector<Soldier*> pilots = _craft->getPilotList(false);
+
+	for (auto* pilot : pilots)
+	{
+		pilot->prepareStatsWithBonuses(_game->getMod()); // refresh soldier bonuses
+	}
+	_pilotAccuracyBonus = _craft->getPilotAccuracyBonus(pilots, _game->getMod());
+	_pilotDodgeBonus = _craft->getPilotDodgeBonus(pilots, _game->getMod());
+	_pilotApproachSpeedModifier = _craft->getPilotApproachSpeedModifier(pilots, _game->getMod());
+
+	_craftAccelerationBonus = 2; // vanilla
+	if (!pilots.empty())
+	{
+		_craftAccelerationBonus = std::min(4, (_craft->getCraftStats().accel / 3) + 1);
+	}
+
+	// HK options
+	if (_ufoIsAttacking)
+	{
+		if (_ufo->getCraftStats().speedMax >= _craft->getCraftStats().speedMax)
+		{
+			_disableDisengage = true;
+		}
+		if (_weaponNum == 0)
+		{
+			_disableCautious = true;
+		}
+		// make sure the HK attacks its primary target first!
+		{
+			Craft* target = dynamic_cast<Craft*>(_ufo->getDestination());
+			if (target)
+			{
+				if (_craft != target)
+				{
+					// push secondary targets a tiny bit away from the HK
+					_currentDist += 16;
+				}
+				else
+				{
+					// approach primary target at maximum approach speed
+					_pilotApproachSpeedModifier = 4;
+				}
+			}
+		}
+		setMode(DM_AGGRESSIVE);
+	}
+
+	// don't set these variables if the ufo is already engaged in a dogfight
+	if (!_ufo->getEscapeCountdown())
+	{
+		_ufo->setFireCountdown(0);
+		int escapeCountdown = _ufo->getRules()->getBreakOffTime() + RNG::generate(0, _ufo->getRules()->getBreakOffTime()) - 30 * _game->getSavedGame()->getDifficultyCoefficient();
+		{
+			int diff = _game->getSavedGame()->getDifficulty();
+			auto& custom = _game->getMod()->getUfoEscapeCountdownCoefficients();
+			if (custom.size() > (size_t)diff)
+			{
+				escapeCountdown = _ufo->getRules()->getBreakOffTime() + RNG::generate(0, _ufo->getRules()->getBreakOffTime());
+				escapeCountdown = escapeCountdown * custom[diff] / 100;
+			}
+		}
+		_ufo->setEscapeCountdown(std::max(1, escapeCountdown));
+	}
+
+	for (int i = 0; i < _weaponNum; ++i)
+	{
+		if (_craft->getWeapons()->at(i))
+		{
+			if (!_ufoIsAttacking)
+			{
+				_weaponFireInterval[i] = _craft->getWeapons()->at(i)->getRules()->getStandardReload();
+			}
+			else
+			{
+				_weaponFireInterval[i] = _craft->getWeapons()->at(i)->getRules()->getAggressiveReload();
+			}
+		}
+	}
+
+	// Set UFO size - going to be moved to Ufo class to implement simultaneous dogfights.
+	std::string ufoSize = _ufo->getRules()->getSize();
+	if (ufoSize.compare("STR_VERY_SMALL") == 0)
+	{
+		_ufoSize = 0;
+	}
+	else if (ufoSize.compare("STR_SMALL") == 0)
+	{
+		_ufoSize = 1;
+	}
+	else if (ufoSize.compare("STR_MEDIUM_UC") == 0)
+	{
+		_ufoSize = 2;
+	}
+	else if (ufoSize.compare("STR_LARGE") == 0)
+	{
+		_ufoSize = 3;
+	}
+	else
+	{
+		_ufoSize = 4;
+	}
+
+	// Set this as the interception handling UFO shield recharge if no other is doing it
+	if (_ufo->getShieldRechargeHandle() == 0)
+	{
+		_ufo->setShieldRechargeHandle(_interceptionNumber);
+	}
+}
+
+/**
+ * Cleans up the dogfight.
+ */
+Dogfight::~Dogfight()
+{
+	Collections::deleteAll(_projectiles);
+}
+
+/**
+ * Advances the dogfight by one tick, and ends it if
+ * the craft has been sent elsewhere or the UFO has landed.
+ */
+void Dogfight::step()
+{
+	if (!_endDogfight)
+	{
+		update();
+	}
+	if (!_ufoIsAttacking || _ufo->getStatus() == Ufo::LANDED)
+	{
+		if (!_craft->isInDogfight() || _craft->getDestination() != _ufo || _ufo->getStatus() == Ufo::LANDED)
+		{
+			end();
+		}
+	}
+}
+
+/**
+ * Steps the dogfight as fast as possible until it's over,
+ * without waiting for any timers. A minimized dogfight
+ * is maximized first, since it wouldn't fight otherwise.
+ * @param maxTicks Maximum number of ticks to step.
+ * @return Number of ticks stepped.
+ */
+int Dogfight::resolve(int maxTicks)
+{
+	_minimized = false;
+	int ticks = 0;
+	while (!_endDogfight && ticks < maxTicks)
+	{
+		// nothing else frees the UFO for the next tick here
+		_ufo->setInterceptionProcessed(false);
+		step();
+		clearFeedback();
+		ticks++;
+	}
+	return ticks;
+}
+
+/**
+ * Counts down the status text timeout and plays
+ * the UFO hit and crash landing animation.
+ */
+void Dogfight::animate()
+{
+	if (_timeout > 0)
+	{
+		_timeout--;
+	}
+
+	// Animate UFO hit.
+	bool lastHitAnimFrame = false;
+	if (_animatingHit && _ufo->getHitFrame() > 0)
+	{
+		_ufo->setHitFrame(_ufo->getHitFrame() - 1);
+		if (_ufo->getHitFrame() == 0)
+		{
+			_animatingHit = false;
+			lastHitAnimFrame = true;
+		}
+	}
+
+	// Animate UFO crash landing.
+	if (_ufo->isCrashed() && _ufo->getHitFrame() == 0 && !lastHitAnimFrame)
+	{
+		--_ufoSize;
+	}
+}
+
+/**
+ * Updates all the elements in the dogfight, including ufo movement,
+ * weapons fire, projectile movement, ufo escape conditions,
+ * craft and ufo destruction conditions, and retaliation mission generation, as applicable.
+ */
+void Dogfight::update()
+{
+	bool finalRun = false;
+	// Check if craft is not low on fuel when window minimized, and
+	// Check if crafts destination hasn't been changed when window minimized.
+	if (!_ufoIsAttacking)
+	{
+		Ufo* u = dynamic_cast<Ufo*>(_craft->getDestination());
+		if (u != _ufo || !_craft->isInDogfight() || _craft->getLowFuel() || (_minimized && _ufo->isCrashed()))
+		{
+			end();
+			return;
+		}
+	}
+
+	if (!_minimized)
+	{
+		animate();
+		if (!_ufo->isCrashed() && !_ufo->isDestroyed() && !_craft->isDestroyed() && !_ufo->getInterceptionProcessed())
+		{
+			_ufo->setInterceptionProcessed(true);
+			int escapeCounter = _ufo->getEscapeCountdown();
+			if (_ufoIsAttacking)
+			{
+				if (_disableDisengage && _ufo->getSoftlockShotCounter() >= _ufo->getRules()->getSoftlockThreshold())
+				{
+					escapeCounter = 1; // game is in softlock, stop being a hunter-killer and disengage!
+				}
+				else if (_ufo->getDamage() > _ufo->getCraftStats().damageMax / 3 && _ufo->getHuntBehavior() != 1)
+				{
+					// TODO: rethink: unhardcode run away thresholds?
+					if (_craft->getDamage() > _craft->getDamageMax() / 2)
+					{
+						escapeCounter = 999; // it's gonna be tight, continue shooting...
+					}
+					else
+					{
+						escapeCounter = 1; // we're badly hurt and xcom isn't, abort immediately!
+					}
+				}
+				else
+				{
+					escapeCounter = 999; // we're still ok, continue shooting...
+				}
+			}
+
+			if (escapeCounter > 0)
+			{
+				escapeCounter--;
+				_ufo->setEscapeCountdown(escapeCounter);
+				// Check if UFO is breaking off.
+				if (escapeCounter == 0)
+				{
+					_ufo->setSpeed(_ufo->getCraftStats().speedMax);
+					if (_ufoIsAttacking && _ufo->isHunterKiller())
+					{
+						// stop being a hunter-killer and run away!
+						_ufo->resetOriginalDestination(_craft);
+						_ufo->setHunterKiller(false);
+					}
+				}
+			}
+			if (_ufo->getFireCountdown() > 0)
+			{
+				_ufo->setFireCountdown(_ufo->getFireCountdown() - 1);
+			}
+		}
+	}
+	// Crappy craft is chasing UFO.
+	int speedMinusTractors = std::max(0, _ufo->getSpeed() - _ufo->getTractorBeamSlowdown());
+	if (speedMinusTractors > _craft->getCraftStats().speedMax)
+	{
+		if (!_ufoIsAttacking || !_ufo->isHunterKiller())
+		{
+			_ufoBreakingOff = true;
+			finalRun = true;
+			setStatus("STR_UFO_OUTRUNNING_INTERCEPTOR");
+		}
+	}
+	else
+	{
+		_ufoBreakingOff = false;
+	}
+
+	bool projectileInFlight = false;
+	if (!_minimized)
+	{
+		int distanceChange = 0;
+
+		// Update distance
+		if (!_ufoBreakingOff)
+		{
+			if (_currentDist < _targetDist && !_ufo->isCrashed() && !_craft->isDestroyed())
+			{
+				distanceChange = 2 * _craftAccelerationBonus; // disengage speed
+				if (_currentDist + distanceChange >_targetDist)
+				{
+					distanceChange = _targetDist - _currentDist;
+				}
+			}
+			else if (_currentDist > _targetDist && !_ufo->isCrashed() && !_craft->isDestroyed())
+			{
+				distanceChange = -1 * _pilotApproachSpeedModifier; // engage speed
+			}
+
+			// don't let the interceptor mystically push or pull its fired projectiles
+			for (auto* cwp : _projectiles)
+			{
+				if (cwp->getGlobalType() != CWPGT_BEAM && cwp->getDirection() == D_UP)
+				{
+					cwp->setPosition(cwp->getPosition() + distanceChange);
+				}
+			}
+		}
+		else
+		{
+			distanceChange = 4; // ufo breaking off speed
+
+			// UFOs can try to outrun our missiles, don't adjust projectile positions here
+			// If UFOs ever fire anything but beams, those positions need to be adjust here though.
+		}
+
+		_currentDist += distanceChange;
+
+		// Check and recharge craft shields
+		// Check if the UFO's shields are being handled by an interception window
+		if (_ufo->getShieldRechargeHandle() == 0)
+		{
+			_ufo->setShieldRechargeHandle(_interceptionNumber);
+		}
+
+		// UFO shields
+		if ((_ufo->getShield() != 0) && (_interceptionNumber == _ufo->getShieldRechargeHandle()))
+		{
+			int total = _ufo->getCraftStats().shieldRecharge / 100;
+			if (RNG::percent(_ufo->getCraftStats().shieldRecharge % 100))
+				total++;
+			_ufo->setShield(_ufo->getShield() + total);
+		}
+
+		// Player craft shields
+		if (_craft->getShield() != 0)
+		{
+			int total = _craft->getCraftStats().shieldRecharge / 100;
+			if (RNG::percent(_craft->getCraftStats().shieldRecharge % 100))
+				total++;
+			if (total != 0)
+			{
+				_craft->setShield(_craft->getShield() + total);
+				_craftShieldChanged = true;
+			}
+		}
+
+		// Move projectiles and check for hits.
+		for (auto* p : _projectiles)
+		{
+			p->move();
+			// Projectiles fired by interceptor.
+			if (p->getDirection() == D_UP)
+			{
+				// Projectile reached the UFO - determine if it's been hit.
+				if (((p->getPosition() >= _currentDist) || (p->getGlobalType() == CWPGT_BEAM && p->toBeRemoved())) && !_ufo->isCrashed() && !p->getMissed())
+				{
+					// UFO hit.
+					int chanceToHit = (p->getAccuracy() * (100 + 300 / (5 - _ufoSize)) + 100) / 200; // vanilla xcom
+					chanceToHit -= _ufo->getCraftStats().avoidBonus;
+					chanceToHit += _craft->getCraftStats().hitBonus;
+					chanceToHit += _pilotAccuracyBonus;
+					if (RNG::percent(chanceToHit))
+					{
+						// Formula delivered by Volutar, altered by Extended version.
+						int power = p->getDamage() * (_craft->getCraftStats().powerBonus + 100) / 100;
+
+						// Handle UFO shields
+						int damage = RNG::generate(power / 2, power);
+						int shieldDamage = 0;
+						if (_ufo->getShield() != 0)
+						{
+							shieldDamage = damage * p->getShieldDamageModifier() / 100;
+							if (p->getShieldDamageModifier() == 0)
+							{
+								damage = 0;
+							}
+							else
+							{
+								// scale down by bleed-through factor and scale up by shield-effectiveness factor
+								damage = std::max(0, shieldDamage - _ufo->getShield()) * _ufo->getCraftStats().shieldBleedThrough / p->getShieldDamageModifier();
+							}
+							_ufo->setShield(_ufo->getShield() - shieldDamage);
+						}
+
+						damage = std::max(0, damage - _ufo->getCraftStats().armor);
+						_ufo->setDamage(_ufo->getDamage() + damage, _game->getMod());
+						if (_state)
+						{
+							_state->handleDogfightExperience(); // called after setDamage
+						}
+						if (_ufo->isCrashed())
+						{
+							_ufo->setShotDownByCraftId(_craft->getUniqueId());
+							_ufo->setSpeed(0);
+							_ufo->setDestination(0);
+							// if the ufo got destroyed here, these no longer apply
+							_ufoBreakingOff = false;
+							finalRun = false;
+							_end = false;
+						}
+						if (_ufo->getHitFrame() == 0)
+						{
+							_animatingHit = true;
+							_ufo->setHitFrame(3);
+						}
+
+						// How hard was the ufo hit?
+						if (_ufo->getShield() != 0)
+						{
+							setStatus("STR_UFO_SHIELD_HIT");
+						}
+						else
+						{
+							if (damage == 0)
+							{
+								if (shieldDamage == 0)
+								{
+									setStatus("STR_UFO_HIT_NO_DAMAGE");
+								}
+								else
+								{
+									setStatus("STR_UFO_SHIELD_DOWN");
+								}
+							}
+							else
+							{
+								if (damage < _ufo->getCraftStats().damageMax / 2 * _game->getMod()->getUfoGlancingHitThreshold() / 100)
+								{
+									setStatus("STR_UFO_HIT_GLANCING");
+								}
+								else
+								{
+									setStatus("STR_UFO_HIT");
+								}
+							}
+						}
+
+						playSound(Mod::UFO_HIT);
+						p->remove();
+					}
+					// Missed.
+					else
+					{
+						if (p->getGlobalType() == CWPGT_BEAM)
+						{
+							p->remove();
+						}
+						else
+						{
+							p->setMissed(true);
+						}
+					}
+				}
+				// Check if projectile passed it's maximum range.
+				if (p->getGlobalType() == CWPGT_MISSILE && p->getPosition() / 8 >= p->getRange())
+				{
+					p->remove();
+				}
+				else if (!_ufo->isCrashed())
+				{
+					projectileInFlight = true;
+				}
+			}
+			// Projectiles fired by UFO.
+			else if (p->getDirection() == D_DOWN)
+			{
+				if (p->getGlobalType() == CWPGT_MISSILE || (p->getGlobalType() == CWPGT_BEAM && p->toBeRemoved()))
+				{
+					int chancetoHit = p->getAccuracy(); // vanilla xcom
+					chancetoHit -= _craft->getCraftStats().avoidBonus;
+					chancetoHit += _ufo->getCraftStats().hitBonus;
+					chancetoHit -= _pilotDodgeBonus;
+					// evasive maneuvers
+					if (_ufoIsAttacking && _mode == DM_CAUTIOUS)
+					{
+						// HK's chance to hit is halved, but craft's reload time is doubled too
+						chancetoHit = chancetoHit / 2;
+					}
+					if (RNG::percent(chancetoHit) || _selfDestructPressed)
+					{
+						// Formula delivered by Volutar, altered by Extended version.
+						int power = p->getDamage() * (_ufo->getCraftStats().powerBonus + 100) / 100;
+						int damage = RNG::generate(0, power);
+
+						if (_craft->getShield() != 0)
+						{
+							int shieldBleedThroughDamage = std::max(0, damage - _craft->getShield()) * _craft->getCraftStats().shieldBleedThrough / 100;
+							_craft->setShield(_craft->getShield() - damage);
+							damage = shieldBleedThroughDamage;
+							_craftShieldChanged = true;
+							setStatus("STR_INTERCEPTOR_SHIELD_HIT");
+						}
+
+						damage = std::max(0, damage - _craft->getCraftStats().armor);
+
+						// if a totally crappy HK is attacking a completely defenseless craft, avoid endless fight
+						if (_selfDestructPressed)
+						{
+							damage = _craft->getCraftStats().damageMax;
+						}
+
+						if (damage)
+						{
+							_craft->setDamage(_craft->getDamage() + damage);
+							_craftDamageChanged = true;
+							setStatus("STR_INTERCEPTOR_DAMAGED");
+							playSound(Mod::INTERCEPTOR_HIT); //10
+							if (_mode == DM_CAUTIOUS && _craft->getDamagePercentage() >= 50 && !_ufoIsAttacking)
+							{
+								_targetDist = STANDOFF_DIST;
+							}
+						}
+					}
+					p->remove();
+				}
+			}
+		}
+
+		// Remove projectiles that hit or missed their target.
+		Collections::deleteIf(_projectiles, _projectiles.size(),
+			[&](CraftWeaponProjectile* cwp)
+			{
+				return cwp->toBeRemoved() == true || (cwp->getMissed() == true && cwp->getPosition() <= 0);
+			}
+		);
+
+		checkDefenseless();
+
+		// Handle weapons and craft distance.
+		for (int i = 0; i < _weaponNum; ++i)
+		{
+			CraftWeapon *w = _craft->getWeapons()->at(i);
+			if (w == 0)
+			{
+				continue;
+			}
+			int wTimer = _weaponFireCountdown[i];
+
+			// Handle weapon firing
+			if (wTimer == 0 && _currentDist <= w->getRules()->getRange() * 8 && w->getAmmo() > 0 && _mode != DM_STANDOFF
+				&& _mode != DM_DISENGAGE && !_ufo->isCrashed() && !_craft->isDestroyed())
+			{
+				if (_weaponEnabled[i])
+				{
+					fireWeapon(i);
+					projectileInFlight = true;
+				}
+			}
+			else if (wTimer > 0)
+			{
+				--_weaponFireCountdown[i];
+			}
+
+			// Handle craft tractor beams
+			if (w->getRules()->getTractorBeamPower() != 0)
+			{
+				if (_currentDist <= w->getRules()->getRange() * 8 && _mode != DM_STANDOFF
+					&& _mode != DM_DISENGAGE && !_ufo->isCrashed() && !_craft->isDestroyed()
+					&& _weaponEnabled[i])
+				{
+					if (!_tractorLockedOn[i])
+					{
+						_tractorLockedOn[i] = true;
+						int tractorBeamSlowdown = _ufo->getTractorBeamSlowdown();
+						tractorBeamSlowdown += w->getRules()->getTractorBeamPower() * _game->getMod()->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
+						_ufo->setTractorBeamSlowdown(tractorBeamSlowdown);
+						setStatus("STR_TRACTOR_BEAM_ENGAGED");
+					}
+				}
+				else
+				{
+					if (_tractorLockedOn[i])
+					{
+						_tractorLockedOn[i] = false;
+						int tractorBeamSlowdown = _ufo->getTractorBeamSlowdown();
+						tractorBeamSlowdown -= w->getRules()->getTractorBeamPower() * _game->getMod()->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
+						_ufo->setTractorBeamSlowdown(tractorBeamSlowdown);
+						setStatus("STR_TRACTOR_BEAM_DISENGAGED");
+					}
+				}
+			}
+
+			if (w->getAmmo() == 0 && !projectileInFlight && !_craft->isDestroyed())
+			{
+				// Handle craft distance according to option set by user and available ammo.
+				if (_mode == DM_CAUTIOUS && !_ufoIsAttacking)
+				{
+					minimumDistance();
+				}
+				else if (_mode == DM_STANDARD)
+				{
+					maximumDistance();
+				}
+			}
+		}
+
+		// Handle UFO firing.
+		if (_currentDist <= _ufo->getRules()->getWeaponRange() * 8 && !_ufo->isCrashed() && !_craft->isDestroyed())
+		{
+			if (_ufo->getShootingAt() == 0)
+			{
+				_ufo->setShootingAt(_interceptionNumber);
+			}
+			if (_ufo->getShootingAt() == _interceptionNumber)
+			{
+				if (_ufo->getFireCountdown() == 0)
+				{
+					ufoFireWeapon();
+				}
+			}
+		}
+		else if (_ufo->getShootingAt() == _interceptionNumber)
+		{
+			_ufo->setShootingAt(0);
+		}
+	}
+
+	// Check when battle is over.
+	if (_end == true && (((_currentDist > 640 || _minimized) && (_mode == DM_DISENGAGE || _ufoBreakingOff == true)) || (_timeout == 0 && (_ufo->isCrashed() || _craft->isDestroyed()))))
+	{
+		if (_ufoBreakingOff)
+		{
+			_ufo->move();
+			// TODO: rethink: give hunter-killers opportunity to escape?
+			if (!_ufoIsAttacking)
+			{
+				_craft->setDestination(_ufo);
+			}
+		}
+		if (!_destroyCraft && (_destroyUfo || _mode == DM_DISENGAGE))
+		{
+			// keep original target if attacked by a HK (and didn't disengage manually)
+			bool keepOriginalTarget = _ufoIsAttacking && _craft->getDestination() != _ufo;
+			if (!keepOriginalTarget || _mode == DM_DISENGAGE)
+			{
+				_craft->returnToBase();
+			}
+
+			// Need to give the craft at least one step advantage over the hunter-killer (to be able to escape)
+			if (_ufoIsAttacking)
+			{
+				bool returnedToBase = _craft->think();
+				if (returnedToBase)
+				{
+					_game->getSavedGame()->stopHuntingXcomCraft(_craft); // hiding in the base is good enough, obviously
+				}
+			}
+		}
+		if (_ufo->isCrashed())
+		{
+			for (auto* follower : _ufo->getCraftFollowers())
+			{
+				if (follower->getNumTotalUnits() == 0 || !follower->getRules()->getAllowLanding())
+				{
+					follower->returnToBase();
+				}
+			}
+		}
+		end();
+	}
+
+	if (_currentDist > 640 && _ufoBreakingOff)
+	{
+		finalRun = true;
+	}
+
+	if (!_end)
+	{
+		if (_endCraftHandled)
+		{
+			finalRun = true;
+		}
+		else if (_craft->isDestroyed())
+		{
+			// End dogfight if craft is destroyed.
+			setStatus("STR_INTERCEPTOR_DESTROYED");
+			if (_ufoIsAttacking)
+			{
+				_craft->evacuateCrew(_game->getMod());
+			}
+			_timeout += 30;
+			playSound(Mod::INTERCEPTOR_EXPLODE);
+			finalRun = true;
+			_destroyCraft = true;
+			_endCraftHandled = true;
+			_ufo->setShootingAt(0);
+		}
+
+		if (_endUfoHandled)
+		{
+			finalRun = true;
+		}
+		else if (_ufo->isCrashed())
+		{
+			handleUfoShotDown(finalRun);
+		}
+		else if (_ufo->getCraftStats().speedMax - _ufo->getTractorBeamSlowdown() == 0) // UFO brought down by tractor beam
+		{
+			handleUfoTractored(finalRun);
+		}
+	}
+
+	if (!projectileInFlight && finalRun)
+	{
+		_end = true;
+	}
+}
+
+/**
+ * Checks if the situation is hopeless for a craft
+ * that can't disengage: no projectiles in the air
+ * and no ammo left, so it can only self-destruct.
+ */
+void Dogfight::checkDefenseless()
+{
+	if (_disableDisengage && !_craftIsDefenseless && _projectiles.empty())
+	{
+		for (auto* cw : *_craft->getWeapons())
+		{
+			if (cw && cw->getAmmo() > 0)
+			{
+				return;
+			}
+		}
+		_craftIsDefenseless = true;
+	}
+}
+
+/**
+ * Handles an UFO that just crashed or got destroyed: triggers
+ * the retaliation, scores it, and checks if it survived the splashdown.
+ * @param finalRun Set when the dogfight is ready to end.
+ */
+void Dogfight::handleUfoShotDown(bool &finalRun)
+{
+	// End dogfight if UFO is crashed or destroyed.
+	_endUfoHandled = true;
+
+	if (_ufo->getShotDownByCraftId() == _craft->getUniqueId() && _state)
+	{
+		AlienRace *race = _game->getMod()->getAlienRace(_ufo->getAlienRace());
+		AlienMission *mission = _ufo->getMission();
+		mission->ufoShotDown(*_ufo);
+		// Check for retaliation trigger.
+		int retaliationOdds = mission->getRules().getRetaliationOdds();
+		if (retaliationOdds == -1)
+		{
+			retaliationOdds = 100 - (4 * (24 - _game->getSavedGame()->getDifficultyCoefficient()) - race->getRetaliationAggression());
+			{
+				int diff = _game->getSavedGame()->getDifficulty();
+				auto& custom = _game->getMod()->getRetaliationTriggerOdds();
+				if (custom.size() > (size_t)diff)
+				{
+					retaliationOdds = custom[diff] + race->getRetaliationAggression();
+				}
+			}
+		}
+		// Have mercy on beginners
+		if (_game->getSavedGame()->getMonthsPassed() < Mod::DIFFICULTY_BASED_RETAL_DELAY[_game->getSavedGame()->getDifficulty()])
+		{
+			retaliationOdds = 0;
+		}
+
+		if (RNG::percent(retaliationOdds))
+		{
+			// Spawn retaliation mission.
+			std::string targetRegion;
+			int retaliationUfoMissionRegionOdds = 50 - 6 * _game->getSavedGame()->getDifficultyCoefficient();
+			{
+				int diff = _game->getSavedGame()->getDifficulty();
+				auto& custom = _game->getMod()->getRetaliationBaseRegionOdds();
+				if (custom.size() > (size_t)diff)
+				{
+					retaliationUfoMissionRegionOdds = 100 - custom[diff];
+				}
+			}
+			if (RNG::percent(retaliationUfoMissionRegionOdds))
+			{
+				// Attack on UFO's mission region
+				targetRegion = _ufo->getMission()->getRegion();
+			}
+			else
+			{
+				// Try to find and attack the originating base.
+				targetRegion = _game->getSavedGame()->locateRegion(*_craft->getBase())->getRules()->getType();
+				// TODO: If the base is removed, the mission is canceled.
+			}
+			// Difference from original: No retaliation until final UFO lands (Original: Is spawned).
+			if (!_game->getSavedGame()->findAlienMission(targetRegion, OBJECTIVE_RETALIATION, race))
+			{
+				auto* retalWeights = race->retaliationMissionWeights(_game->getSavedGame()->getMonthsPassed());
+				std::string retalMission = retalWeights ? retalWeights->choose() : "";
+				const RuleAlienMission *rule = _game->getMod()->getAlienMission(retalMission, false);
+				if (!rule)
+				{
+					rule = _game->getMod()->getRandomMission(OBJECTIVE_RETALIATION, _game->getSavedGame()->getMonthsPassed());
+				}
+
+				if (rule)
+				{
+					AlienMission *newMission = new AlienMission(*rule);
+					newMission->setId(_game->getSavedGame()->getId("ALIEN_MISSIONS"));
+					newMission->setRegion(targetRegion, *_game->getMod());
+					newMission->setRace(_ufo->getAlienRace());
+					newMission->start(*_game, *_state->getGlobe(), newMission->getRules().getWave(0).spawnTimer); // fixed delay for first scout
+					_game->getSavedGame()->getAlienMissions().push_back(newMission);
+				}
+			}
+		}
+	}
+
+	if (_ufo->isDestroyed())
+	{
+		if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
+		{
+			addActivity(_ufo->getRules()->getScore()*2);
+			setStatus("STR_UFO_DESTROYED");
+			playSound(Mod::UFO_EXPLODE); //11
+		}
+		_destroyUfo = true;
+	}
+	else
+	{
+		if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
+		{
+			setStatus("STR_UFO_CRASH_LANDS");
+			playSound(Mod::UFO_CRASH); //10
+			addActivity(_ufo->getRules()->getScore());
+		}
+		bool survived = true;
+		if (!isUfoOverLand())
+		{
+			survived = false; // destroyed on real water
+		}
+		else if (isUfoOverFakeWater())
+		{
+			if (RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
+			{
+				setStatus("STR_UFO_SURVIVED_SPLASHDOWN");
+			}
+			else
+			{
+				survived = false; // destroyed on fake water
+				setStatus("STR_UFO_DESTROYED_BY_SPLASHDOWN");
+			}
+		}
+		if (!survived)
+		{
+			_ufo->setStatus(Ufo::DESTROYED);
+			_destroyUfo = true;
+		}
+		else
+		{
+			_ufo->setSecondsRemaining(RNG::generate(24, 96)*3600);
+			_ufo->setAltitude("STR_GROUND");
+			if (_ufo->getCrashId() == 0)
+			{
+				_ufo->setCrashId(_game->getSavedGame()->getId("STR_CRASH_SITE"));
+				if (_ufo->isHunterKiller())
+				{
+					// stop being a hunter-killer
+					_ufo->resetOriginalDestination(_craft);
+					_ufo->setHunterKiller(false);
+				}
+			}
+		}
+	}
+	_timeout += 30;
+	if (_ufo->getShotDownByCraftId() != _craft->getUniqueId())
+	{
+		_timeout += 50;
+		_ufo->setHitFrame(3);
+	}
+	finalRun = true;
+
+	if (_ufo->getStatus() == Ufo::LANDED)
+	{
+		_timeout += 30;
+		finalRun = true;
+		_ufo->setShootingAt(0);
+	}
+}
+
+/**
+ * Handles an UFO slowed down to a halt by tractor beams:
+ * it's forced to land, or destroyed if it comes down on water.
+ * @param finalRun Set when the dogfight is ready to end.
+ */
+void Dogfight::handleUfoTractored(bool &finalRun)
+{
+	_endUfoHandled = true;
+
+	bool survived = true;
+	if (!isUfoOverLand())
+	{
+		survived = false; // destroyed on real water
+	}
+	else
+	{
+		if (isUfoOverFakeWater() && !RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
+		{
+			survived = false; // destroyed on fake water
+		}
+	}
+	if (_ufo->getRules()->isUnmanned())
+	{
+		survived = false; // unmanned UFOs (drones, missiles, etc.) can't be forced to land
+	}
+	if (!survived) // Brought it down over water (and didn't survive splashdown)
+	{
+		finalRun = true;
+		_ufo->setDamage(_ufo->getCraftStats().damageMax, _game->getMod());
+		if (_state)
+		{
+			_state->handleDogfightExperience(); // called after setDamage
+		}
+		_ufo->setShotDownByCraftId(_craft->getUniqueId());
+		_ufo->setSpeed(0);
+		_ufo->setStatus(Ufo::DESTROYED);
+		_destroyUfo = true;
+		addActivity(_ufo->getRules()->getScore());
+	}
+	else // Brought it down over land (or survived splashdown)
+	{
+		finalRun = true;
+		_ufo->setSecondsRemaining(RNG::generate(30, 120)*60);
+		_ufo->setShootingAt(0);
+		_ufo->setStatus(Ufo::LANDED);
+		_ufo->setAltitude("STR_GROUND");
+		_ufo->setSpeed(0);
+		_ufo->setTractorBeamSlowdown(0);
+		if (_ufo->getLandId() == 0)
+		{
+			_ufo->setLandId(_game->getSavedGame()->getId("STR_LANDING_SITE"));
+		}
+	}
+}
+
+/**
+ * Adds XCom activity to the country and region the UFO is over.
+ * @param score Activity points.
+ */
+void Dogfight::addActivity(int score)
+{
+	for (auto* country : *_game->getSavedGame()->getCountries())
+	{
+		if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
+		{
+			country->addActivityXcom(score);
+			break;
+		}
+	}
+	for (auto* region : *_game->getSavedGame()->getRegions())
+	{
+		if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
+		{
+			region->addActivityXcom(score);
+			break;
+		}
+	}
+}
+
+/**
+ * Checks if the UFO is over land, so it can crash land
+ * instead of sinking. Without a geoscape, it always is.
+ * @return True if over land.
+ */
+bool Dogfight::isUfoOverLand() const
+{
+	return !_state || _state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude());
+}
+
+/**
+ * Checks if the UFO is over a texture that counts as water
+ * for splashdowns. Without a geoscape, it never is.
+ * @return True if over fake water.
+ */
+bool Dogfight::isUfoOverFakeWater() const
+{
+	return _state && _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
+}
+
+/**
+ * Fires a shot from the given weapon
+ * equipped on the craft.
+ * @param i Weapon slot.
+ */
+void Dogfight::fireWeapon(int i)
+{
+	CraftWeapon *w1 = _craft->getWeapons()->at(i);
+	if (w1->setAmmo(w1->getAmmo() - 1))
+	{
+		_weaponFireCountdown[i] = _weaponFireInterval[i];
+		_ammoChanged = true;
+
+		CraftWeaponProjectile *p = w1->fire();
+		p->setDirection(D_UP);
+		p->setHorizontalPosition((i % 2 ? HP_RIGHT : HP_LEFT) * (1 + 2 * (i / 2)));
+		_projectiles.push_back(p);
+
+		playSound(w1->getRules()->getSound());
+		_firedAtLeastOnce = true;
+	}
+}
+
+/**
+ *	Each time a UFO will try to fire it's cannons
+ *	a calculation is made. There's only 10% chance
+ *	that it will actually fire.
+ */
+void Dogfight::ufoFireWeapon()
+{
+	int fireCountdown = std::max(1, (_ufo->getRules()->getWeaponReload() - 2 * _game->getSavedGame()->getDifficultyCoefficient()));
+	{
+		int diff = _game->getSavedGame()->getDifficulty();
+		auto& custom = _game->getMod()->getUfoFiringRateCoefficients();
+		if (custom.size() > (size_t)diff)
+		{
+			fireCountdown = std::max(1, _ufo->getRules()->getWeaponReload() * custom[diff] / 100);
+		}
+	}
+	_ufo->setFireCountdown(RNG::generate(0, fireCountdown) + fireCountdown);
+
+	setStatus("STR_UFO_RETURN_FIRE");
+	CraftWeaponProjectile *p = new CraftWeaponProjectile();
+	p->setType(CWPT_PLASMA_BEAM);
+	p->setAccuracy(60);
+	p->setDamage(_ufo->getRules()->getWeaponPower());
+	p->setDirection(D_DOWN);
+	p->setHorizontalPosition(HP_CENTER);
+	p->setPosition(_currentDist - (_ufo->getRules()->getRadius() / 2));
+	_projectiles.push_back(p);
+	if (_ufoIsAttacking && _disableDisengage)
+	{
+		_ufo->increaseSoftlockShotCounter();
+	}
+
+	if (_ufo->getRules()->getFireSound() == -1)
+	{
+		playSound(Mod::UFO_FIRE);
+	}
+	else
+	{
+		playSound(_ufo->getRules()->getFireSound());
+	}
+}
+
+/**
+ * Sets the craft to the minimum distance
+ * required to fire a weapon.
+ */
+void Dogfight::minimumDistance()
+{
+	int max = 0;
+	for (auto* cw : *_craft->getWeapons())
+	{
+		if (cw == 0)
+			continue;
+		if (cw->getRules()->getRange() > max && cw->getAmmo() > 0)
+		{
+			max = cw->getRules()->getRange();
+		}
+	}
+	if (max == 0)
+	{
+		_targetDist = STANDOFF_DIST;
+	}
+	else
+	{
+		_targetDist = max * 8;
+	}
+}
+
+/**
+ * Sets the craft to the maximum distance
+ * required to fire a weapon.
+ */
+void Dogfight::maximumDistance()
+{
+	int min = 1000;
+	for (auto* cw : *_craft->getWeapons())
+	{
+		if (cw == 0)
+			continue;
+		if (cw->getRules()->getRange() < min && cw->getAmmo() > 0)
+		{
+			min = cw->getRules()->getRange();
+		}
+	}
+	if (_ufoIsAttacking)
+	{
+		// If the UFO is actively hunting us, consider its weapon range too
+		if (_ufo->getRules()->getWeaponRange() > 0 && _ufo->getRules()->getWeaponRange() < min)
+		{
+			min = _ufo->getRules()->getWeaponRange();
+		}
+	}
+	if (min == 1000)
+	{
+		_targetDist = STANDOFF_DIST;
+	}
+	else
+	{
+		_targetDist = min * 8;
+	}
+}
+
+/**
+ * Sets the craft to the distance relevant for aggressive attack.
+ */
+void Dogfight::aggressiveDistance()
+{
+	maximumDistance();
+	if (_targetDist > AGGRESSIVE_DIST)
+	{
+		_targetDist = AGGRESSIVE_DIST;
+	}
+}
+
+/**
+ * Changes the attack mode, which sets the distance the craft
+ * tries to keep and the reload time of its weapons.
+ * Nothing but the mode changes once the fight is decided.
+ * @param mode New attack mode.
+ */
+void Dogfight::setMode(DogfightMode mode)
+{
+	_mode = mode;
+	if (_ufo->isCrashed() || _craft->isDestroyed() || _ufoBreakingOff)
+	{
+		return;
+	}
+	switch (mode)
+	{
+	case DM_STANDOFF:
+		_end = false;
+		setStatus("STR_STANDOFF");
+		_targetDist = STANDOFF_DIST;
+		break;
+	case DM_CAUTIOUS:
+		_end = false;
+		if (!_ufoIsAttacking)
+		{
+			setStatus("STR_CAUTIOUS_ATTACK");
+			for (int i = 0; i < _weaponNum; ++i)
+			{
+				CraftWeapon* w = _craft->getWeapons()->at(i);
+				if (w != 0)
+				{
+					_weaponFireInterval[i] = w->getRules()->getCautiousReload();
+				}
+			}
+			minimumDistance();
+		}
+		else
+		{
+			setStatus("STR_EVASIVE_MANEUVERS");
+			for (int i = 0; i < _weaponNum; ++i)
+			{
+				CraftWeapon* w = _craft->getWeapons()->at(i);
+				if (w != 0)
+				{
+					// double the craft's reload time to balance halving the HK's chance to hit
+					_weaponFireInterval[i] = w->getRules()->getAggressiveReload() * 2;
+				}
+			}
+			// same distance as aggressive (by design)
+			aggressiveDistance();
+		}
+		break;
+	case DM_STANDARD:
+		_end = false;
+		setStatus("STR_STANDARD_ATTACK");
+		for (int i = 0; i < _weaponNum; ++i)
+		{
+			CraftWeapon* w = _craft->getWeapons()->at(i);
+			if (w != 0)
+			{
+				_weaponFireInterval[i] = w->getRules()->getStandardReload();
+			}
+		}
+		maximumDistance();
+		break;
+	case DM_AGGRESSIVE:
+		_end = false;
+		setStatus("STR_AGGRESSIVE_ATTACK");
+		for (int i = 0; i < _weaponNum; ++i)
+		{
+			CraftWeapon* w = _craft->getWeapons()->at(i);
+			if (w != 0)
+			{
+				_weaponFireInterval[i] = w->getRules()->getAggressiveReload();
+			}
+		}
+		aggressiveDistance();
+		break;
+	case DM_DISENGAGE:
+		_end = true;
+		setStatus("STR_DISENGAGING");
+		_targetDist = 800;
+		break;
+	}
+}
+
+/**
+ * Activates or cancels the self-destruct of a craft
+ * that can neither escape nor fight back.
+ */
+void Dogfight::toggleSelfDestruct()
+{
+	_selfDestructPressed = !_selfDestructPressed;
+	if (_selfDestructPressed)
+		setStatus("STR_SELF_DESTRUCT_ACTIVATED");
+	else
+		setStatus("STR_SELF_DESTRUCT_CANCELLED");
+}
+
+/**
+ * Ends the dogfight.
+ */
+void Dogfight::end()
+{
+	if (_endDogfight)
+		return;
+	if (_craft)
+	{
+		_craft->setInDogfight(false);
+		_craft->setInterceptionOrder(0);
+	}
+	// set the ufo as "free" for the next engagement (as applicable)
+	if (_ufo)
+	{
+		_ufo->setInterceptionProcessed(false);
+		_ufo->setShieldRechargeHandle(0);
+	}
+	_endDogfight = true;
+}
+
+/**
+ * Awards experience to the pilots once the UFO is down,
+ * if the craft took part in the fight.
+ */
+void Dogfight::awardExperienceToPilots()
+{
+	if (_firedAtLeastOnce && !_experienceAwarded && _craft && _ufo && (_ufo->isCrashed() || _ufo->isDestroyed()))
+	{
+		bool psiStrengthEval = (Options::psiStrengthEval && _game->getSavedGame()->isResearched(_game->getMod()->getPsiRequirements()));
+		for (auto* pilot : _craft->getPilotList(false))
+		{
+			if (pilot->getCurrentStats()->firing < pilot->getRules()->getStatCaps().firing)
+			{
+				if (RNG::percent(pilot->getRules()->getDogfightExperience().firing))
+				{
+					pilot->getCurrentStats()->firing++;
+					pilot->getDailyDogfightExperienceCache()->firing++;
+				}
+			}
+			if (pilot->getCurrentStats()->reactions < pilot->getRules()->getStatCaps().reactions)
+			{
+				if (RNG::percent(pilot->getRules()->getDogfightExperience().reactions))
+				{
+					pilot->getCurrentStats()->reactions++;
+					pilot->getDailyDogfightExperienceCache()->reactions++;
+				}
+			}
+			if (pilot->getCurrentStats()->bravery < pilot->getRules()->getStatCaps().bravery)
+			{
+				if (RNG::percent(pilot->getRules()->getDogfightExperience().bravery))
+				{
+					pilot->getCurrentStats()->bravery += 10; // increase by 10 to keep OCD at bay
+					pilot->getDailyDogfightExperienceCache()->bravery += 10;
+				}
+			}
+			pilot->calcStatString(_game->getMod()->getStatStrings(), psiStrengthEval);
+		}
+		_experienceAwarded = true;
+	}
+}
+
+/**
+ * Updates the status text and restarts
+ * the text timeout counter.
+ * @param status New status text.
+ */
+void Dogfight::setStatus(const std::string &status)
+{
+	_status = status;
+	_statusChanged = true;
+	_timeout = 50;
+}
+
+/**
+ * Queues a sound for the dogfight window to play.
+ * @param sound Sound index in GEO.CAT.
+ */
+void Dogfight::playSound(int sound)
+{
+	if (_feedback)
+	{
+		_sounds.push_back(sound);
+	}
+}
+
+/**
+ * Forgets the changes the dogfight window has been told about.
+ */
+void Dogfight::clearFeedback()
+{
+	_sounds.clear();
+	_statusChanged = false;
+	_ammoChanged = false;
+	_craftShieldChanged = false;
+	_craftDamageChanged = false;
+}
+
+}
@@ -0,0 +1,181 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include "../Mod/RuleCraft.h"
+
+namespace OpenXcom
+{
+
+const int STANDOFF_DIST = 560;
+const int AGGRESSIVE_DIST = 64;
+enum DogfightMode : int { DM_STANDOFF, DM_CAUTIOUS, DM_STANDARD, DM_AGGRESSIVE, DM_DISENGAGE };
+
+class Game;
+class GeoscapeState;
+class Craft;
+class Ufo;
+class CraftWeaponProjectile;
+
+/**
+ * The combat model of an interception between a player craft and an UFO,
+ * advanced one tick at a time. It doesn't draw or play anything itself,
+ * the dogfight window reads the status, sounds and changes it leaves
+ * behind after each step. Without a geoscape, it can be stepped on its
+ * own to resolve a whole interception at once.
+ */
+class Dogfight
+{
+private:
+	Game *_game;
+	GeoscapeState *_state;
+	Craft *_craft;
+	Ufo *_ufo;
+	DogfightMode _mode;
+	bool _ufoIsAttacking, _disableDisengage, _disableCautious, _craftIsDefenseless, _selfDestructPressed;
+	int _timeout, _currentDist, _targetDist, _weaponFireInterval[RuleCraft::WeaponMax], _weaponFireCountdown[RuleCraft::WeaponMax];
+	bool _end, _endUfoHandled, _endCraftHandled, _ufoBreakingOff, _destroyUfo, _destroyCraft, _weaponEnabled[RuleCraft::WeaponMax];
+	bool _minimized, _endDogfight, _animatingHit;
+	std::vector<CraftWeaponProjectile*> _projectiles;
+	int _ufoSize, _interceptionNumber;
+	int _weaponNum;
+	int _pilotAccuracyBonus, _pilotDodgeBonus, _pilotApproachSpeedModifier, _craftAccelerationBonus;
+	bool _firedAtLeastOnce, _experienceAwarded;
+	bool _tractorLockedOn[RuleCraft::WeaponMax];
+	// feedback for the window, collected until cleared
+	bool _feedback;
+	std::string _status;
+	std::vector<int> _sounds;
+	bool _statusChanged, _ammoChanged, _craftShieldChanged, _craftDamageChanged;
+
+	/// Moves the craft and projectiles, fires the weapons and checks the outcome.
+	void update();
+	/// Counts down the status text and the UFO hit animation.
+	void animate();
+	/// Plays a sound in the dogfight window.
+	void playSound(int sound);
+	/// Checks if the craft can't escape and has nothing left to fire.
+	void checkDefenseless();
+	/// Applies the consequences of shooting the UFO down.
+	void handleUfoShotDown(bool &finalRun);
+	/// Applies the consequences of forcing the UFO down with tractor beams.
+	void handleUfoTractored(bool &finalRun);
+	/// Adds the UFO score to the country and region below it.
+	void addActivity(int score);
+	/// Checks if the UFO is over land.
+	bool isUfoOverLand() const;
+	/// Checks if the UFO is over a fake underwater texture.
+	bool isUfoOverFakeWater() const;
+public:
+	/// Longest interception resolved at once, in ticks.
+	static const int MAX_RESOLVE_TICKS = 100000;
+
+	/// Creates a dogfight between a craft and an UFO.
+	Dogfight(Game *game, GeoscapeState *state, Craft *craft, Ufo *ufo, bool ufoIsAttacking);
+	/// Cleans up the dogfight.
+	~Dogfight();
+	/// Advances the dogfight by one tick.
+	void step();
+	/// Steps the dogfight until it's over.
+	int resolve(int maxTicks = MAX_RESOLVE_TICKS);
+	/// Ends the dogfight.
+	void end();
+	/// Checks if the dogfight is over.
+	bool isEnded() const { return _endDogfight; }
+	/// Fires a craft weapon.
+	void fireWeapon(int i);
+	/// Fires the UFO weapon.
+	void ufoFireWeapon();
+	/// Sets the craft to minimum distance.
+	void minimumDistance();
+	/// Sets the craft to maximum distance.
+	void maximumDistance();
+	/// Sets the craft to maximum distance or 8 km, whichever is smaller.
+	void aggressiveDistance();
+	/// Gets the attack mode.
+	DogfightMode getMode() const { return _mode; }
+	/// Changes the attack mode.
+	void setMode(DogfightMode mode);
+	/// Toggles the self-destruct of a defenseless craft.
+	void toggleSelfDestruct();
+	/// Is the craft's self-destruct activated?
+	bool isSelfDestructPressed() const { return _selfDestructPressed; }
+	/// Is the craft unable to escape or fight back?
+	bool isCraftDefenseless() const { return _craftIsDefenseless; }
+	/// Is the UFO the aggressor?
+	bool isUfoAttacking() const { return _ufoIsAttacking; }
+	/// Is the UFO breaking off?
+	bool isUfoBreakingOff() const { return _ufoBreakingOff; }
+	/// Can the craft disengage?
+	bool isDisengageDisabled() const { return _disableDisengage; }
+	/// Can the craft attack cautiously?
+	bool isCautiousDisabled() const { return _disableCautious; }
+	/// Is the dogfight minimized?
+	bool isMinimized() const { return _minimized; }
+	/// Minimizes or maximizes the dogfight.
+	void setMinimized(bool minimized) { _minimized = minimized; }
+	/// Gets the number of craft weapon slots in use.
+	int getWeaponCount() const { return _weaponNum; }
+	/// Is a craft weapon enabled?
+	bool isWeaponEnabled(int i) const { return _weaponEnabled[i]; }
+	/// Enables or disables a craft weapon.
+	void setWeaponEnabled(int i, bool enabled) { _weaponEnabled[i] = enabled; }
+	/// Gets the distance between the craft and the UFO.
+	int getDistance() const { return _currentDist; }
+	/// Gets the UFO size used for hit chances and the radar blob.
+	int getUfoSize() const { return _ufoSize; }
+	/// Gets the projectiles in flight.
+	const std::vector<CraftWeaponProjectile*> &getProjectiles() const { return _projectiles; }
+	/// Gets the interception number.
+	int getInterceptionNumber() const { return _interceptionNumber; }
+	/// Sets the interception number.
+	void setInterceptionNumber(int number) { _interceptionNumber = number; }
+	/// Gets the UFO in this dogfight.
+	Ufo *getUfo() const { return _ufo; }
+	/// Gets the craft in this dogfight.
+	Craft *getCraft() const { return _craft; }
+	/// Has the craft fired at least once?
+	bool hasFiredAtLeastOnce() const { return _firedAtLeastOnce; }
+	/// Awards experience to the pilots.
+	void awardExperienceToPilots();
+
+	/// Turns collecting the window feedback on or off.
+	void setFeedback(bool feedback) { _feedback = feedback; }
+	/// Changes the status text and restarts its timeout.
+	void setStatus(const std::string &status);
+	/// Gets the status text to show.
+	const std::string &getStatus() const { return _status; }
+	/// Gets the ticks left before the status text is cleared.
+	int getStatusTimeout() const { return _timeout; }
+	/// Has the status changed since the feedback was cleared?
+	bool isStatusChanged() const { return _statusChanged; }
+	/// Gets the sounds to play since the feedback was cleared.
+	const std::vector<int> &getSounds() const { return _sounds; }
+	/// Has the ammo changed since the feedback was cleared?
+	bool isAmmoChanged() const { return _ammoChanged; }
+	/// Has the craft shield changed since the feedback was cleared?
+	bool isCraftShieldChanged() const { return _craftShieldChanged; }
+	/// Has the craft damage changed since the feedback was cleared?
+	bool isCraftDamageChanged() const { return _craftDamageChanged; }
+	/// Clears the window feedback.
+	void clearFeedback();
+};
+
+}
@@ -32,6 +32,7 @@
 #include "../Engine/Sound.h"
 #include "../Engine/Surface.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "../Engine/Collections.h"
 #include "../Engine/Unicode.h"
 #include "Globe.h"
@@ -811,6 +812,7 @@ void GeoscapeState::timeDisplay()
  */
 void GeoscapeState::timeAdvance()
 {
+	PROFILE_SCOPE("GeoscapeState::timeAdvance");
 	int timeSpan = 0;
 	if (_timeSpeed == _btn5Secs)
 	{
@@ -893,9 +895,9 @@ const std::vector<Craft*>* GeoscapeState::updateActiveCrafts()
 	_activeCrafts.clear();
 	for (auto* xbase : *_game->getSavedGame()->getBases())
 	{
-		for (auto* xcraft : *xbase->getCrafts())
+		for (auto* xcraft : xbase->getActiveCrafts())
 		{
-			if (xcraft->getStatus() == "STR_OUT" && !xcraft->isDestroyed())
+			if (!xcraft->isDestroyed())
 			{
 				_activeCrafts.push_back(xcraft);
 			}
@@ -1378,7 +1380,7 @@ void GeoscapeState::time5Seconds()
 				}
 				else if (x != 0)
 				{
-					if (x->getStatus() != "STR_OUT" || x->isDestroyed())
+					if (x->getStatus() != CS_OUT || x->isDestroyed())
 					{
 						xcraft->returnToBase();
 					}
@@ -1389,25 +1391,25 @@ void GeoscapeState::time5Seconds()
 	}
 
 	// Clean up dead UFOs and end dogfights which were minimized.
-	Collections::deleteIf(*_game->getSavedGame()->getUfos(), _game->getSavedGame()->getUfos()->size(),
-		[&](Ufo* ufo)
+	for (auto ufoIt = _game->getSavedGame()->getUfos()->begin(); ufoIt != _game->getSavedGame()->getUfos()->end();)
+	{
+		Ufo *ufo = (*ufoIt);
+		if (ufo->getStatus() == Ufo::DESTROYED)
 		{
-			if (ufo->getStatus() == Ufo::DESTROYED)
-			{
-				Collections::deleteIf(_dogfights, _dogfights.size(),
-					[&](DogfightState* dogfight)
-					{
-						return dogfight->getUfo() == ufo;
-					}
-				);
-				return true;
-			}
-			else
-			{
-				return false;
-			}
+			Collections::deleteIf(_dogfights, _dogfights.size(),
+				[&](DogfightState* dogfight)
+				{
+					return dogfight->getUfo() == ufo;
+				}
+			);
+			ufoIt = _game->getSavedGame()->removeUfo(ufoIt);
+			delete ufo;
 		}
-	);
+		else
+		{
+			++ufoIt;
+		}
+	}
 
 	// Check any dogfights waiting to open
 	for (auto* dfs : _dogfights)
@@ -1492,7 +1494,7 @@ void GeoscapeState::time10Minutes()
 		// Fuel consumption for XCOM craft.
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_OUT")
+			if (xcraft->getStatus() == CS_OUT)
 			{
 				int escortSpeed = 0;
 				{
@@ -1680,7 +1682,7 @@ void GeoscapeState::baseHunting()
 				for (auto* craft : *activeCrafts)
 				{
 					// Craft is flying (i.e. not in base)
-					if (craft->getStatus() == "STR_OUT" && !craft->isDestroyed() && !craft->getRules()->isUndetectable() && !craft->isIgnoredByHK())
+					if (craft->getStatus() == CS_OUT && !craft->isDestroyed() && !craft->getRules()->isUndetectable() && !craft->isIgnoredByHK())
 					{
 						// Craft is close enough and RNG is in our favour
 						if (craft->getDistance(ab) < Nautical(ab->getDeployment()->getBaseDetectionRange()) && RNG::percent(ab->getDeployment()->getBaseDetectionChance()))
@@ -1878,20 +1880,20 @@ void GeoscapeState::time30Minutes()
 	{
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_REFUELLING")
+			if (xcraft->getStatus() == CS_REFUELLING)
 			{
 				std::string item = xcraft->refuel();
 
 				if (item.empty())
 				{
 					// notification
-					if (xcraft->getStatus() == "STR_READY" && xcraft->getRules()->notifyWhenRefueled())
+					if (xcraft->getStatus() == CS_READY && xcraft->getRules()->notifyWhenRefueled())
 					{
 						std::string msg = tr("STR_CRAFT_IS_READY").arg(xcraft->getName(_game->getLanguage())).arg(xbase->getName());
 						popup(new CraftErrorState(this, msg));
 					}
 					// auto-patrol
-					if (xcraft->getStatus() == "STR_READY" && xcraft->getRules()->canAutoPatrol())
+					if (xcraft->getStatus() == CS_READY && xcraft->getRules()->canAutoPatrol())
 					{
 						if (xcraft->getIsAutoPatrolling())
 						{
@@ -1904,7 +1906,7 @@ void GeoscapeState::time30Minutes()
 								_game->getSavedGame()->getWaypoints()->push_back(w);
 							}
 							xcraft->setDestination(w);
-							xcraft->setStatus("STR_OUT");
+							xcraft->setStatus(CS_OUT);
 						}
 					}
 				}
@@ -1969,13 +1971,19 @@ void GeoscapeState::time30Minutes()
 	}
 
 	// Processes MissionSites
-	Collections::deleteIf(
-		*_game->getSavedGame()->getMissionSites(),
-		[&](MissionSite* site)
+	for (auto siteIt = _game->getSavedGame()->getMissionSites()->begin(); siteIt != _game->getSavedGame()->getMissionSites()->end();)
+	{
+		MissionSite *site = (*siteIt);
+		if (processMissionSite(site))
 		{
-			return processMissionSite(site);
+			siteIt = _game->getSavedGame()->removeMissionSite(siteIt);
+			delete site;
 		}
-	);
+		else
+		{
+			++siteIt;
+		}
+	}
 
 	// Decrease event countdowns and pop up if needed
 	for (auto* ge : _game->getSavedGame()->getGeoscapeEvents())
@@ -2085,11 +2093,11 @@ void GeoscapeState::time1Hour()
 	{
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_REPAIRS")
+			if (xcraft->getStatus() == CS_REPAIRS)
 			{
 				xcraft->repair();
 			}
-			else if (xcraft->getStatus() == "STR_REARMING")
+			else if (xcraft->getStatus() == CS_REARMING)
 			{
 				auto* ammo = xcraft->rearm();
 				if (ammo)
@@ -2101,7 +2109,7 @@ void GeoscapeState::time1Hour()
 					popup(new CraftErrorState(this, msg));
 				}
 			}
-			if (xcraft->getShieldCapacity() > 0 && xcraft->getStatus() != "STR_OUT")
+			if (xcraft->getShieldCapacity() > 0 && xcraft->getStatus() != CS_OUT)
 			{
 				// Recharge craft shields in parallel (no wait for repair/rearm/refuel)
 				xcraft->setShield(xcraft->getShield() + xcraft->getRules()->getShieldRechargeAtBase());
@@ -2803,6 +2811,18 @@ void GeoscapeState::timerReset()
 	_btn5Secs->mousePress(&act, this);
 }
 
+/**
+ * Speeds the timer up to maximum speed, for when
+ * nobody is watching (headless runs).
+ */
+void GeoscapeState::timerFastForward()
+{
+	SDL_Event ev;
+	ev.button.button = SDL_BUTTON_LEFT;
+	Action act(&ev, _game->getScreen()->getXScale(), _game->getScreen()->getYScale(), _game->getScreen()->getCursorTopBlackBand(), _game->getScreen()->getCursorLeftBlackBand());
+	_btn1Day->mousePress(&act, this);
+}
+
 /**
  * Adds a new popup window to the queue
  * (this prevents popups from overlapping)
@@ -3233,6 +3253,38 @@ void GeoscapeState::handleDogfights()
 	}
 }
 
+/**
+ * Fights out all the open dogfights at once, stepping them
+ * together tick by tick without waiting for the dogfight timer
+ * or drawing them. The ended ones are closed on the next timer tick.
+ * Minimized dogfights are left alone, since they don't fight.
+ */
+void GeoscapeState::resolveDogfights()
+{
+	for (int tick = 0; tick < Dogfight::MAX_RESOLVE_TICKS; ++tick)
+	{
+		for (auto* dfs : _dogfights)
+		{
+			dfs->getUfo()->setInterceptionProcessed(false);
+		}
+		bool fighting = false;
+		for (auto* dfs : _dogfights)
+		{
+			Dogfight *dogfight = dfs->getDogfight();
+			if (!dogfight->isMinimized() && !dogfight->isEnded())
+			{
+				dogfight->step();
+				dogfight->clearFeedback();
+				fighting = true;
+			}
+		}
+		if (!fighting)
+		{
+			break;
+		}
+	}
+}
+
 /**
  * Goes through all active dogfight instances and tries to perform the same action.
  * @param button Action to perform.
@@ -104,6 +104,8 @@ public:
 	void time1Month();
 	/// Resets the timer to minimum speed.
 	void timerReset();
+	/// Sets the timer to maximum speed.
+	void timerFastForward();
 	/// Displays a popup window.
 	void popup(State *state);
 	/// Gets the Geoscape globe.
@@ -170,6 +172,8 @@ public:
 	void zoomOutEffect();
 	/// Multi-dogfights logic handling.
 	void handleDogfights();
+	/// Fights out the open dogfights at once.
+	void resolveDogfights();
 	void handleDogfightMultiAction(int button);
 	/// Dogfight experience handling.
 	void handleDogfightExperience();
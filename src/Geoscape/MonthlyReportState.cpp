@@ -34,6 +34,7 @@
 #include "../Mod/RuleCountry.h"
 #include "Globe.h"
 #include "../Engine/Options.h"
+#include "../Engine/Parallel.h"
 #include "../Engine/Unicode.h"
 #include "../Menu/CutsceneState.h"
 #include "../Battlescape/CommendationState.h"
@@ -321,17 +322,27 @@ void MonthlyReportState::btnOkClick(Action *)
 		_game->popState();
 		// Award medals for service time
 		// Iterate through all your bases
+		std::vector<Soldier*> soldiers;
 		for (auto* xbase : *_game->getSavedGame()->getBases())
 		{
 			// Iterate through all your soldiers
 			for (auto* soldier : *xbase->getSoldiers())
 			{
-				// Award medals to eligible soldiers
 				soldier->getDiary()->addMonthlyService();
-				if (soldier->getDiary()->manageCommendations(_game->getMod(), _game->getSavedGame()->getMissionStatistics()))
-				{
-					_soldiersMedalled.push_back(soldier);
-				}
+				soldiers.push_back(soldier);
+			}
+		}
+		// Award medals to eligible soldiers, each diary is independent so do them in parallel
+		std::vector<char> medalled(soldiers.size(), 0);
+		Parallel::forEach(soldiers.size(), [&](size_t i)
+		{
+			medalled[i] = soldiers[i]->getDiary()->manageCommendations(_game->getMod(), _game->getSavedGame()->getMissionStatistics());
+		});
+		for (size_t i = 0; i < soldiers.size(); ++i)
+		{
+			if (medalled[i])
+			{
+				_soldiersMedalled.push_back(soldiers[i]);
 			}
 		}
 		if (!_soldiersMedalled.empty())
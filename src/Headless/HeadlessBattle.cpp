@@ -0,0 +1,351 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "HeadlessBattle.h"
+#include <iomanip>
+#include <sstream>
+#include "../Engine/Exception.h"
+#include "../Engine/Game.h"
+#include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/RNG.h"
+#include "../Engine/Timer.h"
+#include "../Battlescape/BattleReplay.h"
+#include "../Battlescape/BattlescapeGame.h"
+#include "../Battlescape/BattlescapeState.h"
+#include "../Battlescape/BriefingState.h"
+#include "../Battlescape/ConfirmEndMissionState.h"
+#include "../Battlescape/DebriefingState.h"
+#include "../Battlescape/InventoryState.h"
+#include "../Battlescape/NextTurnState.h"
+#include "../Geoscape/GeoscapeState.h"
+#include "../Menu/MainMenuState.h"
+#include "../Menu/NewBattleState.h"
+#include "../Mod/Mod.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SavedGame.h"
+#include "HeadlessReport.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Sets up a headless battle runner.
+ * @param game Pointer to the core game, with the mods already loaded.
+ */
+HeadlessBattle::HeadlessBattle(Game *game) : _game(game), _replay(0), _totalUs(0), _generateUs(0), _cycles(0), _finished(false)
+{
+	// nothing should be written to the user folder by a benchmark
+	Options::autosave = false;
+}
+
+/**
+ * Deletes the replay being recorded or played back, if any.
+ */
+HeadlessBattle::~HeadlessBattle()
+{
+	delete _replay;
+}
+
+/**
+ * Loads a saved game that's in the middle of a battle,
+ * the same way the Load Game screen does.
+ * @param filename Name of the save file in the user folder.
+ */
+void HeadlessBattle::load(const std::string &filename)
+{
+	SavedGame *save = new SavedGame();
+	try
+	{
+		save->load(filename, _game->getMod(), _game->getLanguage());
+	}
+	catch (...)
+	{
+		delete save;
+		throw;
+	}
+	_game->setSavedGame(save);
+	if (save->getSavedBattle() == 0)
+	{
+		throw Exception(filename + " is not a battlescape save");
+	}
+	_game->setState(new GeoscapeState);
+	save->getSavedBattle()->loadMapResources(_game->getMod());
+	BattlescapeState *bs = new BattlescapeState;
+	_game->pushState(bs);
+	save->getSavedBattle()->setBattleState(bs);
+}
+
+/**
+ * Generates a random battle, the same way the New Battle screen does
+ * when its Random button is pressed, so the whole setup only depends on the seed.
+ * @param seed Seed for the random number generator.
+ * @param deployment Mission type to use instead of a random one.
+ */
+void HeadlessBattle::generate(Uint64 seed, const std::string &deployment)
+{
+	RNG::setSeed(seed);
+	_game->setState(new MainMenuState);
+	NewBattleState *setup = new NewBattleState;
+	_game->pushState(setup);
+	setup->btnRandomClick(0);
+	if (!deployment.empty() && !setup->selectMission(deployment))
+	{
+		throw Exception(deployment + " can't be picked in New Battle");
+	}
+	Uint64 start = Profiler::now();
+	setup->btnOkClick(0);
+	_generateUs = Profiler::now() - start;
+	if (_game->getSavedGame()->getSavedBattle() == 0)
+	{
+		throw Exception("Failed to generate a battle from seed " + std::to_string(seed));
+	}
+}
+
+/**
+ * Loads a battle recorded with the oxceRecordBattles option.
+ * The player's side is then played by the recorded commands instead of the AI.
+ * @param name Name of the replay in the user folder.
+ */
+void HeadlessBattle::loadReplay(const std::string &name)
+{
+	_replay = new BattleReplay();
+	_replay->load(name);
+	load(_replay->getSaveName());
+	getBattle()->getBattleState()->getBattleGame()->setReplay(_replay);
+	// setting up the screens is not part of the recording
+	RNG::setSeed(_replay->getSeed());
+}
+
+/**
+ * Gets the battle currently being played.
+ * @return Pointer to the battle, or null if there's none.
+ */
+SavedBattleGame *HeadlessBattle::getBattle() const
+{
+	return _game->getSavedGame() ? _game->getSavedGame()->getSavedBattle() : 0;
+}
+
+/**
+ * Answers any screen that has been put on top of the battlescape,
+ * taking the default choice a player would make, and detects
+ * when the battle is over.
+ */
+void HeadlessBattle::dismissPopups()
+{
+	State *top = _game->getTopState();
+	if (top == 0 || dynamic_cast<DebriefingState*>(top))
+	{
+		_finished = true;
+	}
+	else if (dynamic_cast<BattlescapeState*>(top))
+	{
+		// keep playing
+	}
+	else if (NextTurnState *nextTurn = dynamic_cast<NextTurnState*>(top))
+	{
+		nextTurn->close();
+	}
+	else if (_replay && dynamic_cast<ConfirmEndMissionState*>(top))
+	{
+		// the player confirmed if the end of the turn was recorded next, otherwise cancelled
+		_game->popState();
+		const ReplayCommand *cmd = _replay->getNextCommand();
+		if (cmd && cmd->type == RC_END_TURN)
+		{
+			_replay->playNextCommand(getBattle()->getBattleState()->getBattleGame());
+		}
+	}
+	else if (BriefingState *briefing = dynamic_cast<BriefingState*>(top))
+	{
+		briefing->btnOkClick(0);
+	}
+	else if (InventoryState *inventory = dynamic_cast<InventoryState*>(top))
+	{
+		inventory->btnOkClick(0);
+	}
+	else
+	{
+		// messages, cutscenes, saving screens, etc.
+		_game->popState();
+	}
+}
+
+/**
+ * Plays back the next recorded command once the battle is waiting
+ * for the player, which is when it was given in the first place.
+ * @return True if the whole recording has been played back.
+ */
+bool HeadlessBattle::playReplay()
+{
+	SavedBattleGame *battle = getBattle();
+	if (battle == 0 || battle->getBattleState() == 0 || _game->getTopState() != battle->getBattleState())
+	{
+		return false;
+	}
+	BattlescapeGame *battleGame = battle->getBattleState()->getBattleGame();
+	if (battle->getSide() != FACTION_PLAYER || battleGame->isBusy())
+	{
+		return false;
+	}
+	const ReplayCommand *cmd = _replay->getNextCommand();
+	if (cmd == 0)
+	{
+		return _replay->isFinished();
+	}
+	if (cmd->turn != battle->getTurn())
+	{
+		throw Exception("Replay diverged: waiting for the player on turn " + std::to_string(battle->getTurn()) + " but the next command is from turn " + std::to_string(cmd->turn));
+	}
+	_replay->playNextCommand(battleGame);
+	return false;
+}
+
+/**
+ * Plays the battle until the given number of turns have passed
+ * or the battle ends, with the AI playing for every side
+ * except the player's when a recording is played back.
+ * Each cycle advances all the timers far enough to fire,
+ * so the game logic runs as fast as the CPU allows.
+ * @param turns Number of full turns to play.
+ */
+void HeadlessBattle::run(int turns)
+{
+	Profiler::start(false);
+	Profiler::collectStats();
+
+	int lastTurn = -1;
+	int firstTurn = -1;
+	int turnCycles = 0;
+	Uint64 sideStart = Profiler::now();
+	Uint64 start = sideStart;
+	while (!_finished)
+	{
+		SavedBattleGame *battle = getBattle();
+		if (battle && battle->getBattleState())
+		{
+			battle->getBattleState()->getBattleGame()->setPlayerSideAI(_replay == 0);
+			if (battle->getTurn() != lastTurn)
+			{
+				if (!_turns.empty())
+				{
+					_turns.back().checksum = getChecksum();
+				}
+				if (firstTurn == -1)
+				{
+					firstTurn = battle->getTurn();
+				}
+				if (battle->getTurn() - firstTurn >= turns)
+				{
+					break;
+				}
+				lastTurn = battle->getTurn();
+				TurnStats stats;
+				stats.turn = lastTurn;
+				_turns.push_back(stats);
+				turnCycles = 0;
+			}
+		}
+
+		Timer::advanceHeadlessTime(CYCLE_TIME);
+		UnitFaction side = battle ? battle->getSide() : FACTION_PLAYER;
+		_game->runHeadlessCycle();
+		// commands go after the cycle, so anything that happens when popups close comes first, like in the game
+		if (_replay && playReplay())
+		{
+			break;
+		}
+		dismissPopups();
+		_cycles++;
+		if (_replay && !_replay->getMismatch().empty())
+		{
+			throw Exception(_replay->getMismatch());
+		}
+
+		Uint64 now = Profiler::now();
+		if (!_turns.empty() && side >= FACTION_PLAYER && side <= FACTION_NEUTRAL)
+		{
+			_turns.back().sideUs[side] += now - sideStart;
+		}
+		sideStart = now;
+		if (++turnCycles > MAX_CYCLES_PER_TURN)
+		{
+			throw Exception("Battle got stuck on turn " + std::to_string(lastTurn));
+		}
+	}
+	_totalUs = Profiler::now() - start;
+	_sections = Profiler::collectStats();
+	if (_finished && !_turns.empty() && getBattle())
+	{
+		_turns.back().checksum = getChecksum();
+	}
+	Profiler::stop();
+	if (_replay && !_replay->isFinished())
+	{
+		throw Exception("Replay diverged: the battle ended before the recording did");
+	}
+}
+
+/**
+ * Calculates a checksum of the entire battle state.
+ * @return MD5 hash as a hex string.
+ */
+std::string HeadlessBattle::getChecksum() const
+{
+	SavedBattleGame *battle = getBattle();
+	if (battle == 0)
+	{
+		return std::string();
+	}
+	return battle->getChecksum();
+}
+
+/**
+ * Gets a report with the time spent in each turn and side,
+ * the profiler sections and the checksums after every turn.
+ * @return Multi-line report.
+ */
+std::string HeadlessBattle::getReport() const
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	ss << "Battle " << (_finished ? "finished" : "stopped") << " after " << _turns.size() << " turns, "
+		<< _cycles << " cycles, " << _totalUs / 1000.0 << " ms" << std::endl;
+	if (_replay)
+	{
+		ss << "Replayed " << _replay->getCommandCount() << " commands, " << _replay->getVerifiedCount() << " turn checksums match the recording" << std::endl;
+	}
+	ss << std::endl << "turn  player ms  hostile ms  neutral ms  checksum" << std::endl;
+	for (const auto &t : _turns)
+	{
+		ss << std::setw(4) << t.turn
+			<< std::setw(11) << t.sideUs[FACTION_PLAYER] / 1000.0
+			<< std::setw(12) << t.sideUs[FACTION_HOSTILE] / 1000.0
+			<< std::setw(12) << t.sideUs[FACTION_NEUTRAL] / 1000.0
+			<< "  " << t.checksum << std::endl;
+	}
+	ss << std::endl << HeadlessReport::formatSections(_sections);
+	if (SavedBattleGame *battle = getBattle())
+	{
+		ss << std::endl << "Units, items and nodes: " << battle->getPooledObjects() << " created in " << battle->getPoolBlocks() << " heap blocks" << std::endl;
+	}
+	ss << std::endl << "checksum: " << getChecksum() << std::endl;
+	return ss.str();
+}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+#include "../Engine/Profiler.h"
+
+namespace OpenXcom
+{
+
+class BattleReplay;
+class Game;
+class SavedBattleGame;
+
+/**
+ * Plays a battle without any display or player input,
+ * with the AI controlling every side, as fast as possible.
+ * Used to benchmark the battlescape logic (AI, pathfinding,
+ * FOV, lighting) and to check that it stays deterministic.
+ * Can also play back a battle recorded from the game, checking
+ * the recorded checksums every turn.
+ */
+class HeadlessBattle
+{
+private:
+	/// Game time passed to the timers every cycle, enough to make all of them fire.
+	static const Uint32 CYCLE_TIME = 1000;
+	/// Cycles a single turn may take before the battle is considered stuck.
+	static const int MAX_CYCLES_PER_TURN = 200000;
+
+	/// Wall-clock time and end-of-turn checksum of a played turn.
+	struct TurnStats
+	{
+		int turn = 0;
+		Uint64 sideUs[3] = {};
+		std::string checksum;
+	};
+
+	Game *_game;
+	BattleReplay *_replay;
+	std::vector<TurnStats> _turns;
+	std::vector<Profiler::SectionStats> _sections;
+	Uint64 _totalUs, _generateUs;
+	int _cycles;
+	bool _finished;
+
+	/// Gets the battle being played.
+	SavedBattleGame *getBattle() const;
+	/// Closes anything covering the battlescape.
+	void dismissPopups();
+	/// Plays back the next recorded command, when the player would be able to give it.
+	bool playReplay();
+public:
+	/// Creates a headless battle runner.
+	HeadlessBattle(Game *game);
+	/// Cleans up the headless battle runner.
+	~HeadlessBattle();
+	/// Loads a battle from a saved game.
+	void load(const std::string &filename);
+	/// Generates a random battle.
+	void generate(Uint64 seed, const std::string &deployment = "");
+	/// Loads a recorded battle for playback.
+	void loadReplay(const std::string &name);
+	/// Plays the battle for a number of turns.
+	void run(int turns);
+	/// Gets the time it took to generate the battle.
+	Uint64 getGenerateTime() const { return _generateUs; }
+	/// Gets a checksum of the battle state.
+	std::string getChecksum() const;
+	/// Gets a text report of the timings and checksums.
+	std::string getReport() const;
+};
+
+}
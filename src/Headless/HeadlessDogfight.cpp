@@ -0,0 +1,251 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "HeadlessDogfight.h"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include "../Engine/Exception.h"
+#include "../Engine/Game.h"
+#include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
+#include "../Mod/Mod.h"
+#include "../Mod/RuleAlienMission.h"
+#include "../Mod/RuleCraft.h"
+#include "../Mod/RuleCraftWeapon.h"
+#include "../Mod/RuleUfo.h"
+#include "../Mod/UfoTrajectory.h"
+#include "../Savegame/AlienMission.h"
+#include "../Savegame/Base.h"
+#include "../Savegame/Craft.h"
+#include "../Savegame/CraftWeapon.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/Ufo.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Sets up a headless dogfight runner.
+ * @param game Pointer to the core game, with the mods already loaded.
+ */
+HeadlessDogfight::HeadlessDogfight(Game *game) : _game(game), _totalUs(0), _totalTicks(0), _totalFights(0)
+{
+	// nothing should be written to the user folder by a benchmark
+	Options::autosave = false;
+}
+
+/**
+ * Loads the campaign save the crafts, difficulty and
+ * other campaign settings are taken from.
+ * @param filename Name of the save file in the user folder.
+ */
+void HeadlessDogfight::load(const std::string &filename)
+{
+	SavedGame *save = new SavedGame();
+	try
+	{
+		save->load(filename, _game->getMod(), _game->getLanguage());
+	}
+	catch (...)
+	{
+		delete save;
+		throw;
+	}
+	_game->setSavedGame(save);
+	if (save->getSavedBattle() != 0)
+	{
+		throw Exception(filename + " is not a geoscape save");
+	}
+}
+
+/**
+ * Fights every distinct craft loadout at the bases against
+ * every UFO type a number of times, and measures how long it takes.
+ * @param fights Number of fights per craft and UFO.
+ * @param mode Attack mode of the crafts.
+ * @param ufoType Only fight this UFO type, or all of them if empty.
+ */
+void HeadlessDogfight::run(int fights, DogfightMode mode, const std::string &ufoType)
+{
+	Mod *mod = _game->getMod();
+
+	// one craft per type and weapon loadout
+	std::map<std::string, Craft*> crafts;
+	for (auto* base : *_game->getSavedGame()->getBases())
+	{
+		for (auto* craft : *base->getCrafts())
+		{
+			std::string name = craft->getRules()->getType();
+			bool armed = false;
+			for (auto* weapon : *craft->getWeapons())
+			{
+				name += weapon ? " " + weapon->getRules()->getType() : " -";
+				armed = armed || (weapon && weapon->getRules()->getAmmoMax() > 0);
+			}
+			if (armed)
+			{
+				crafts.insert(std::make_pair(name, craft));
+			}
+		}
+	}
+	if (crafts.empty())
+	{
+		throw Exception("No armed crafts in the campaign");
+	}
+
+	std::vector<const RuleUfo*> ufos;
+	if (!ufoType.empty())
+	{
+		ufos.push_back(mod->getUfo(ufoType, true));
+	}
+	else
+	{
+		for (const auto& type : mod->getUfosList())
+		{
+			ufos.push_back(mod->getUfo(type));
+		}
+	}
+
+	// the UFOs need a mission to crash; without a geoscape, nothing else comes of it
+	const RuleAlienMission *missionRule = 0;
+	const UfoTrajectory *trajectory = 0;
+	for (const auto& type : mod->getAlienMissionList())
+	{
+		const RuleAlienMission *rule = mod->getAlienMission(type);
+		if (rule && rule->getWaveCount() > 0)
+		{
+			trajectory = mod->getUfoTrajectory(rule->getWave(0).trajectory);
+			if (trajectory)
+			{
+				missionRule = rule;
+				break;
+			}
+		}
+	}
+	if (missionRule == 0)
+	{
+		throw Exception("No alien mission with UFO waves in the mods");
+	}
+	AlienMission mission(*missionRule);
+
+	Uint64 start = Profiler::now();
+	for (const auto& craft : crafts)
+	{
+		for (auto* ufo : ufos)
+		{
+			Matchup result;
+			result.craft = craft.first;
+			result.ufo = ufo->getType();
+			for (int i = 0; i < fights; ++i)
+			{
+				fight(craft.second, ufo, mode, &mission, trajectory, result);
+			}
+			_totalTicks += result.ticks;
+			_totalFights += result.fights;
+			_matchups.push_back(result);
+		}
+	}
+	_totalUs = Profiler::now() - start;
+}
+
+/**
+ * Fights one interception between a copy of a craft and a new UFO.
+ * @param source Craft to copy the type and weapons from.
+ * @param ufoRule Type of the UFO.
+ * @param mode Attack mode of the craft.
+ * @param mission Mission the UFO belongs to.
+ * @param trajectory Trajectory the UFO flies.
+ * @param result Outcome to add the fight to.
+ */
+void HeadlessDogfight::fight(Craft *source, const RuleUfo *ufoRule, DogfightMode mode, AlienMission *mission, const UfoTrajectory *trajectory, Matchup &result)
+{
+	Craft *craft = new Craft(source->getRules(), source->getBase(), 0);
+	for (size_t i = 0; i < source->getWeapons()->size(); ++i)
+	{
+		CraftWeapon *weapon = source->getWeapons()->at(i);
+		if (weapon)
+		{
+			craft->getWeapons()->at(i) = new CraftWeapon(weapon->getRules(), weapon->getRules()->getAmmoMax());
+			craft->addCraftStats(weapon->getRules()->getBonusStats());
+		}
+	}
+	craft->setFuel(craft->getFuelMax());
+	craft->setShield(craft->getShieldCapacity());
+
+	Ufo *ufo = new Ufo(ufoRule, 0);
+	ufo->setMissionInfo(mission, trajectory);
+	ufo->setLongitude(craft->getLongitude());
+	ufo->setLatitude(craft->getLatitude());
+	ufo->setSpeed(trajectory->getSpeedPercentage(0) * ufo->getCraftStats().speedMax);
+	craft->setDestination(ufo);
+
+	{
+		Dogfight dogfight(_game, 0, craft, ufo, false);
+		dogfight.setFeedback(false);
+		dogfight.setInterceptionNumber(1);
+		dogfight.setMode(mode);
+		result.ticks += dogfight.resolve();
+	}
+
+	result.fights++;
+	if (ufo->isCrashed() || ufo->getStatus() == Ufo::LANDED)
+	{
+		result.ufosDown++;
+	}
+	else if (craft->isDestroyed())
+	{
+		result.craftsLost++;
+	}
+	// the craft goes first, so it stops following the UFO
+	delete craft;
+	delete ufo;
+}
+
+/**
+ * Gets a report with the outcome of every craft and UFO
+ * pairing, and how fast the interceptions were resolved.
+ * @return Multi-line report.
+ */
+std::string HeadlessDogfight::getReport() const
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(1);
+	ss << std::left << std::setw(50) << "craft" << std::setw(24) << "ufo" << std::right
+		<< std::setw(8) << "fights" << std::setw(8) << "down%" << std::setw(8) << "lost%" << std::setw(8) << "away%" << std::setw(11) << "avg ticks" << std::endl;
+	for (const auto& m : _matchups)
+	{
+		double fights = std::max(m.fights, 1) / 100.0;
+		int away = m.fights - m.ufosDown - m.craftsLost;
+		ss << std::left << std::setw(50) << m.craft << std::setw(24) << m.ufo << std::right
+			<< std::setw(8) << m.fights << std::setw(8) << m.ufosDown / fights << std::setw(8) << m.craftsLost / fights
+			<< std::setw(8) << away / fights << std::setw(11) << m.ticks / (fights * 100) << std::endl;
+	}
+
+	double seconds = _totalUs / 1000000.0;
+	ss << std::endl << "Resolved " << _totalFights << " interceptions (" << _totalTicks << " ticks) in " << seconds << " s";
+	if (seconds > 0)
+	{
+		ss << ", " << std::setprecision(0) << _totalFights / seconds << " interceptions/s";
+	}
+	ss << std::endl;
+	return ss.str();
+}
+
+}
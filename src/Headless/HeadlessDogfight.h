@@ -0,0 +1,71 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+#include "../Geoscape/Dogfight.h"
+
+namespace OpenXcom
+{
+
+class Game;
+class Craft;
+class RuleUfo;
+class AlienMission;
+class UfoTrajectory;
+
+/**
+ * Fights interceptions between the armed crafts of a campaign save
+ * and the UFOs in the mods, without any display and without the
+ * geoscape, stepping the dogfight model as fast as possible.
+ * Every fight starts with a fresh copy of the craft and its
+ * weapons (without pilots) and a fresh UFO, so the results
+ * can be used to compare crafts and UFOs for balance.
+ */
+class HeadlessDogfight
+{
+private:
+	/// Outcome of the fights between one craft loadout and one UFO type.
+	struct Matchup
+	{
+		std::string craft, ufo;
+		int fights = 0, ufosDown = 0, craftsLost = 0;
+		Uint64 ticks = 0;
+	};
+
+	Game *_game;
+	std::vector<Matchup> _matchups;
+	Uint64 _totalUs, _totalTicks;
+	int _totalFights;
+
+	/// Fights one interception.
+	void fight(Craft *source, const RuleUfo *ufoRule, DogfightMode mode, AlienMission *mission, const UfoTrajectory *trajectory, Matchup &result);
+public:
+	/// Creates a headless dogfight runner.
+	HeadlessDogfight(Game *game);
+	/// Loads the campaign the crafts come from.
+	void load(const std::string &filename);
+	/// Fights every craft loadout against every UFO type.
+	void run(int fights, DogfightMode mode, const std::string &ufoType);
+	/// Gets a text report of the outcomes and speed.
+	std::string getReport() const;
+};
+
+}
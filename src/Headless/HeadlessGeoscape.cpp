@@ -0,0 +1,217 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "HeadlessGeoscape.h"
+#include <iomanip>
+#include <sstream>
+#include "HeadlessReport.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Game.h"
+#include "../Engine/Options.h"
+#include "../Engine/Timer.h"
+#include "../Geoscape/ConfirmLandingState.h"
+#include "../Geoscape/GeoscapeState.h"
+#include "../Geoscape/MonthlyReportState.h"
+#include "../Savegame/GameTime.h"
+#include "../Savegame/SavedGame.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Sets up a headless geoscape runner.
+ * @param game Pointer to the core game, with the mods already loaded.
+ */
+HeadlessGeoscape::HeadlessGeoscape(Game *game) : _game(game), _geoscape(0), _totalUs(0), _days(0), _cycles(0), _finished(false)
+{
+	// nothing should be written to the user folder by a benchmark
+	Options::autosave = false;
+}
+
+/**
+ * Loads a campaign save, the same way the Load Game screen does.
+ * @param filename Name of the save file in the user folder.
+ */
+void HeadlessGeoscape::load(const std::string &filename)
+{
+	SavedGame *save = new SavedGame();
+	try
+	{
+		save->load(filename, _game->getMod(), _game->getLanguage());
+	}
+	catch (...)
+	{
+		delete save;
+		throw;
+	}
+	_game->setSavedGame(save);
+	if (save->getSavedBattle() != 0 || save->getEnding() != END_NONE)
+	{
+		throw Exception(filename + " is not a geoscape save");
+	}
+	_geoscape = new GeoscapeState;
+	_game->setState(_geoscape);
+}
+
+/**
+ * Measures the parts of the saved game that keep growing
+ * during a campaign, plus the size of the whole save.
+ * @return Current sizes.
+ */
+HeadlessGeoscape::Counters HeadlessGeoscape::count() const
+{
+	SavedGame *save = _game->getSavedGame();
+	Counters c;
+	c.missionStatistics = save->getMissionStatistics()->size();
+	c.geoscapeDebugLog = save->getGeoscapeDebugLog().size();
+	c.ufos = save->getUfos()->size();
+	c.alienMissions = save->getAlienMissions().size();
+	c.missionSites = save->getMissionSites()->size();
+	c.alienBases = save->getAlienBases()->size();
+	c.deadSoldiers = save->getDeadSoldiers()->size();
+	YAML::Emitter out;
+	out << save->saveData(_game->getMod());
+	c.saveBytes = out.size();
+	return c;
+}
+
+/**
+ * Answers any screen that has been put on top of the geoscape,
+ * declining anything that would start a battle.
+ */
+void HeadlessGeoscape::dismissPopups()
+{
+	State *top = _game->getTopState();
+	if (top == 0 || _game->getSavedGame()->getEnding() != END_NONE)
+	{
+		_finished = true;
+	}
+	else if (top == _geoscape)
+	{
+		// keep playing
+	}
+	else if (MonthlyReportState *report = dynamic_cast<MonthlyReportState*>(top))
+	{
+		// awards the monthly commendations and checks for game over
+		report->btnOkClick(0);
+	}
+	else if (ConfirmLandingState *landing = dynamic_cast<ConfirmLandingState*>(top))
+	{
+		landing->btnNoClick(0);
+	}
+	else
+	{
+		// messages, base defenses, research and production reports, etc.
+		_game->popState();
+	}
+}
+
+/**
+ * Simulates the campaign for a number of days at the fastest time speed.
+ * Each cycle advances all the timers far enough to fire,
+ * so the game logic runs as fast as the CPU allows.
+ * @param days Number of game days to simulate.
+ */
+void HeadlessGeoscape::run(int days)
+{
+	Profiler::start(false);
+	Profiler::collectStats();
+
+	_before = count();
+	GameTime *time = _game->getSavedGame()->getTime();
+	int lastDay = time->getDay();
+	int dayCycles = 0;
+	Uint64 start = Profiler::now();
+	while (_days < days && !_finished)
+	{
+		if (_game->getTopState() == _geoscape)
+		{
+			_geoscape->timerFastForward();
+			// standard attack mode in every interception, fought out right away
+			_geoscape->handleDogfightMultiAction(2);
+			_geoscape->resolveDogfights();
+		}
+		Timer::advanceHeadlessTime(CYCLE_TIME);
+		_game->runHeadlessCycle();
+		dismissPopups();
+		_cycles++;
+
+		if (time->getDay() != lastDay)
+		{
+			lastDay = time->getDay();
+			_days++;
+			dayCycles = 0;
+		}
+		else if (++dayCycles > MAX_CYCLES_PER_DAY)
+		{
+			throw Exception("Campaign got stuck after " + std::to_string(_days) + " days");
+		}
+	}
+	_totalUs = Profiler::now() - start;
+	_sections = Profiler::collectStats();
+	_after = count();
+	Profiler::stop();
+}
+
+/**
+ * Calculates a checksum of the entire campaign state.
+ * @return MD5 hash as a hex string.
+ */
+std::string HeadlessGeoscape::getChecksum() const
+{
+	return _game->getSavedGame()->getChecksum(_game->getMod());
+}
+
+/**
+ * Gets a report with the simulation speed, the growth of
+ * the saved game and the profiler sections.
+ * @return Multi-line report.
+ */
+std::string HeadlessGeoscape::getReport() const
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	double seconds = _totalUs / 1000000.0;
+	ss << "Campaign " << (_finished ? "ended" : "stopped") << " after " << _days << " days, "
+		<< _cycles << " cycles, " << seconds << " s";
+	if (seconds > 0)
+	{
+		ss << ", " << _days / seconds << " days/s";
+	}
+	ss << std::endl;
+
+	ss << std::endl << "data                    before       after" << std::endl;
+	auto row = [&](const char *name, size_t before, size_t after)
+	{
+		ss << std::left << std::setw(20) << name << std::right << std::setw(10) << before << std::setw(12) << after << std::endl;
+	};
+	row("mission statistics", _before.missionStatistics, _after.missionStatistics);
+	row("geoscape debug log", _before.geoscapeDebugLog, _after.geoscapeDebugLog);
+	row("ufos", _before.ufos, _after.ufos);
+	row("alien missions", _before.alienMissions, _after.alienMissions);
+	row("mission sites", _before.missionSites, _after.missionSites);
+	row("alien bases", _before.alienBases, _after.alienBases);
+	row("dead soldiers", _before.deadSoldiers, _after.deadSoldiers);
+	row("save bytes", _before.saveBytes, _after.saveBytes);
+
+	ss << std::endl << HeadlessReport::formatSections(_sections);
+	ss << std::endl << "checksum: " << getChecksum() << std::endl;
+	return ss.str();
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+#include "../Engine/Profiler.h"
+
+namespace OpenXcom
+{
+
+class Game;
+class GeoscapeState;
+
+/**
+ * Runs a campaign on the geoscape for a number of days without any
+ * display or player input, as fast as possible. Popups are closed,
+ * landings declined and interceptions resolved at once in standard mode.
+ * Used to find performance regressions and unbounded growth
+ * that only show up in long campaigns.
+ */
+class HeadlessGeoscape
+{
+private:
+	/// Game time passed to the timers every cycle, enough to make all of them fire.
+	static const Uint32 CYCLE_TIME = 1000;
+	/// Cycles a single day may take before the campaign is considered stuck.
+	static const int MAX_CYCLES_PER_DAY = 100000;
+
+	/// Sizes of the saved game parts that tend to grow over time.
+	struct Counters
+	{
+		size_t missionStatistics = 0, geoscapeDebugLog = 0, ufos = 0, alienMissions = 0, missionSites = 0, alienBases = 0, deadSoldiers = 0, saveBytes = 0;
+	};
+
+	Game *_game;
+	GeoscapeState *_geoscape;
+	Counters _before, _after;
+	std::vector<Profiler::SectionStats> _sections;
+	Uint64 _totalUs;
+	int _days, _cycles;
+	bool _finished;
+
+	/// Measures the saved game parts that tend to grow.
+	Counters count() const;
+	/// Closes anything covering the geoscape.
+	void dismissPopups();
+public:
+	/// Creates a headless geoscape runner.
+	HeadlessGeoscape(Game *game);
+	/// Loads a campaign from a saved game.
+	void load(const std::string &filename);
+	/// Simulates a number of days.
+	void run(int days);
+	/// Gets a checksum of the campaign state.
+	std::string getChecksum() const;
+	/// Gets a text report of the speed, growth and checksum.
+	std::string getReport() const;
+};
+
+}
@@ -0,0 +1,331 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include "../version.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/FileMap.h"
+#include "../Engine/Game.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/State.h"
+#include "../Mod/Mod.h"
+#include "HeadlessBattle.h"
+#include "HeadlessDogfight.h"
+#include "HeadlessGeoscape.h"
+
+/**
+ * Entry point of openxcom-headless, which runs parts of the game
+ * logic without a display, audio or input, for benchmarks and
+ * regression checks on machines without a screen.
+ *
+ * Usage: openxcom-headless MODE [-KEY VALUE]...
+ * Any regular command-line option (-data, -user, -master, etc.) also applies.
+ */
+
+using namespace OpenXcom;
+
+namespace
+{
+
+/**
+ * Gets the tool arguments, in the same "-key value" format
+ * the game options use.
+ * @return Map of lowercase keys to values.
+ */
+std::map<std::string, std::string> getToolArgs()
+{
+	std::map<std::string, std::string> args;
+	auto& argv = CrossPlatform::getArgs();
+	for (size_t i = 1; i + 1 < argv.size(); ++i)
+	{
+		const std::string &arg = argv[i];
+		if (arg.size() > 1 && arg[0] == '-')
+		{
+			std::string argname = arg.substr(arg[1] == '-' ? 2 : 1);
+			std::transform(argname.begin(), argname.end(), argname.begin(), ::tolower);
+			args[argname] = argv[++i];
+		}
+	}
+	return args;
+}
+
+/**
+ * Gets a tool argument.
+ * @param args Tool arguments.
+ * @param key Lowercase argument name.
+ * @param def Default value.
+ * @return Argument value.
+ */
+std::string getArg(const std::map<std::string, std::string> &args, const std::string &key, const std::string &def)
+{
+	auto i = args.find(key);
+	return i != args.end() ? i->second : def;
+}
+
+void showUsage()
+{
+	std::cout << "OpenXcom headless v" << OPENXCOM_VERSION_SHORT << std::endl;
+	std::cout << "Usage: openxcom-headless MODE [OPTION]..." << std::endl << std::endl;
+	std::cout << "battle -save FILE | -seed N  [-turns N]" << std::endl;
+	std::cout << "        play a battle with the AI on all sides, loaded from a battlescape save" << std::endl;
+	std::cout << "        in the user folder or generated from a seed like New Battle > Random" << std::endl;
+	std::cout << "        (default: -seed 1 -turns 10)" << std::endl << std::endl;
+	std::cout << "replay -file NAME" << std::endl;
+	std::cout << "        play back a battle recorded in the game with the oxceRecordBattles option," << std::endl;
+	std::cout << "        failing if the state at the start of any turn differs from the recording" << std::endl << std::endl;
+	std::cout << "geoscape -save FILE [-days N]" << std::endl;
+	std::cout << "        simulate a campaign save from the user folder at full speed, closing popups," << std::endl;
+	std::cout << "        declining landings and resolving interceptions at once in standard mode" << std::endl;
+	std::cout << "        (default: -days 30)" << std::endl << std::endl;
+	std::cout << "generate [-seeds N]" << std::endl;
+	std::cout << "        generate a battle for every mission type in the mods, once per seed" << std::endl;
+	std::cout << "        from 1 to N, and report how long the map generation took" << std::endl;
+	std::cout << "        (default: -seeds 3)" << std::endl << std::endl;
+	std::cout << "dogfight -save FILE [-fights N] [-mode MODE] [-ufo TYPE]" << std::endl;
+	std::cout << "        fight every armed craft loadout at the bases of a campaign save against" << std::endl;
+	std::cout << "        every UFO type N times without the geoscape, in cautious, standard or" << std::endl;
+	std::cout << "        aggressive mode, and report the outcomes and interceptions per second" << std::endl;
+	std::cout << "        (default: -fights 100 -mode standard)" << std::endl << std::endl;
+	std::cout << "Regular options such as -data, -user and -master can be used too." << std::endl;
+}
+
+/**
+ * Runs a battle with the AI playing every side.
+ * @param game Pointer to the core game.
+ * @param args Tool arguments.
+ */
+void runBattle(Game *game, const std::map<std::string, std::string> &args)
+{
+	HeadlessBattle battle(game);
+	std::string save = getArg(args, "save", "");
+	if (!save.empty())
+	{
+		battle.load(save);
+	}
+	else
+	{
+		battle.generate(std::stoull(getArg(args, "seed", "1")));
+	}
+	battle.run(std::stoi(getArg(args, "turns", "10")));
+	std::cout << battle.getReport();
+}
+
+/**
+ * Plays back a recorded battle and checks it turns out the same.
+ * @param game Pointer to the core game.
+ * @param args Tool arguments.
+ */
+void runReplay(Game *game, const std::map<std::string, std::string> &args)
+{
+	HeadlessBattle battle(game);
+	std::string file = getArg(args, "file", "");
+	if (file.empty())
+	{
+		throw Exception("No replay given, use -file NAME");
+	}
+	battle.loadReplay(file);
+	battle.run(std::numeric_limits<int>::max());
+	std::cout << battle.getReport();
+}
+
+/**
+ * Simulates a campaign on the geoscape.
+ * @param game Pointer to the core game.
+ * @param args Tool arguments.
+ */
+void runGeoscape(Game *game, const std::map<std::string, std::string> &args)
+{
+	HeadlessGeoscape geoscape(game);
+	std::string save = getArg(args, "save", "");
+	if (save.empty())
+	{
+		throw Exception("No campaign save given, use -save FILE");
+	}
+	geoscape.load(save);
+	geoscape.run(std::stoi(getArg(args, "days", "30")));
+	std::cout << geoscape.getReport();
+}
+
+/**
+ * Generates a battle for every deployment with fixed seeds
+ * and reports the time each one took.
+ * @param game Pointer to the core game.
+ * @param args Tool arguments.
+ */
+void runGenerate(Game *game, const std::map<std::string, std::string> &args)
+{
+	int seeds = std::max(std::stoi(getArg(args, "seeds", "3")), 1);
+	// lists the hidden deployments in New Battle too
+	Options::debug = true;
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::left << std::setw(40) << "deployment" << std::right
+		<< std::setw(10) << "first ms" << std::setw(10) << "avg ms" << std::setw(10) << "max ms" << std::endl;
+	Uint64 totalUs = 0;
+	int generated = 0, failed = 0;
+	for (const auto& type : game->getMod()->getDeploymentsList())
+	{
+		Uint64 firstUs = 0, sumUs = 0, maxUs = 0;
+		std::string error;
+		for (int seed = 1; seed <= seeds && error.empty(); ++seed)
+		{
+			try
+			{
+				HeadlessBattle battle(game);
+				battle.generate(seed, type);
+				Uint64 us = battle.getGenerateTime();
+				if (seed == 1)
+				{
+					firstUs = us;
+				}
+				sumUs += us;
+				maxUs = std::max(maxUs, us);
+			}
+			catch (std::exception &e)
+			{
+				error = e.what();
+			}
+		}
+		std::cout << std::left << std::setw(40) << type << std::right;
+		if (!error.empty())
+		{
+			std::cout << "  failed: " << error << std::endl;
+			failed++;
+			continue;
+		}
+		std::cout << std::setw(10) << firstUs / 1000.0 << std::setw(10) << sumUs / 1000.0 / seeds << std::setw(10) << maxUs / 1000.0 << std::endl;
+		totalUs += sumUs;
+		generated++;
+	}
+	std::cout << std::endl << "Generated " << generated << " deployments " << seeds << " times each in "
+		<< totalUs / 1000.0 << " ms, " << failed << " failed" << std::endl;
+}
+
+/**
+ * Fights interceptions between the crafts of a campaign
+ * and the UFOs in the mods, and reports the outcomes.
+ * @param game Pointer to the core game.
+ * @param args Tool arguments.
+ */
+void runDogfight(Game *game, const std::map<std::string, std::string> &args)
+{
+	HeadlessDogfight dogfight(game);
+	std::string save = getArg(args, "save", "");
+	if (save.empty())
+	{
+		throw Exception("No campaign save given, use -save FILE");
+	}
+	std::string mode = getArg(args, "mode", "standard");
+	DogfightMode dogfightMode;
+	if (mode == "cautious")
+	{
+		dogfightMode = DM_CAUTIOUS;
+	}
+	else if (mode == "standard")
+	{
+		dogfightMode = DM_STANDARD;
+	}
+	else if (mode == "aggressive")
+	{
+		dogfightMode = DM_AGGRESSIVE;
+	}
+	else
+	{
+		throw Exception("Unknown attack mode " + mode + ", use cautious, standard or aggressive");
+	}
+	dogfight.load(save);
+	dogfight.run(std::max(std::stoi(getArg(args, "fights", "100")), 1), dogfightMode, getArg(args, "ufo", ""));
+	std::cout << dogfight.getReport();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	CrossPlatform::processArgs(argc, argv);
+	std::string mode = argc > 1 ? argv[1] : "";
+	if (mode != "battle" && mode != "replay" && mode != "geoscape" && mode != "generate" && mode != "dogfight")
+	{
+		showUsage();
+		return EXIT_FAILURE;
+	}
+	Options::headless = true;
+	if (!Options::init())
+		return EXIT_SUCCESS;
+	Options::useOpenGL = false;
+	Options::fullscreen = false;
+	Options::baseXResolution = Options::displayWidth;
+	Options::baseYResolution = Options::displayHeight;
+
+	int result = EXIT_SUCCESS;
+	Game *game = 0;
+	try
+	{
+		game = new Game("OpenXcom headless");
+		State::setGamePtr(game);
+		Options::updateMods();
+		game->loadMods();
+		game->loadLanguages();
+
+		auto args = getToolArgs();
+		if (mode == "battle")
+		{
+			runBattle(game, args);
+		}
+		else if (mode == "replay")
+		{
+			runReplay(game, args);
+		}
+		else if (mode == "geoscape")
+		{
+			runGeoscape(game, args);
+		}
+		else if (mode == "generate")
+		{
+			runGenerate(game, args);
+		}
+		else if (mode == "dogfight")
+		{
+			runDogfight(game, args);
+		}
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+		std::cerr << e.what() << std::endl;
+		result = EXIT_FAILURE;
+	}
+
+	delete game;
+	FileMap::clear(true, false);
+	return result;
+}
+
+namespace OpenXcom
+{
+	Exception::Exception(const std::string &msg) : runtime_error(msg) {
+	}
+}
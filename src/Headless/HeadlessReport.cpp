@@ -0,0 +1,52 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "HeadlessReport.h"
+#include <iomanip>
+#include <sstream>
+
+namespace OpenXcom
+{
+
+namespace HeadlessReport
+{
+
+/**
+ * Formats the timings of profiler sections as a table,
+ * one section per line.
+ * @param sections Section timings.
+ * @return Multi-line table.
+ */
+std::string formatSections(const std::vector<Profiler::SectionStats> &sections)
+{
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	ss << "section                             calls    total ms      max ms" << std::endl;
+	for (const auto &s : sections)
+	{
+		ss << std::left << std::setw(32) << s.name << std::right
+			<< std::setw(9) << s.calls
+			<< std::setw(12) << s.totalUs / 1000.0
+			<< std::setw(12) << s.maxUs / 1000.0 << std::endl;
+	}
+	return ss.str();
+}
+
+}
+
+}
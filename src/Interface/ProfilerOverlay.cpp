@@ -0,0 +1,140 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ProfilerOverlay.h"
+#include <iomanip>
+#include <sstream>
+#include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/Timer.h"
+#include "Text.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates a profiler overlay of the specified size.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ * @param x X position in pixels.
+ * @param y Y position in pixels.
+ */
+ProfilerOverlay::ProfilerOverlay(int width, int height, int x, int y) : Surface(width, height, x, y), _layoutHits(0), _layoutMisses(0)
+{
+	_visible = Options::oxceProfilerOverlay;
+
+	_timer = new Timer(1000);
+	_timer->onTimer((SurfaceHandler)&ProfilerOverlay::update);
+	_timer->start();
+
+	_text = new Text(width, height, 0, 0);
+}
+
+/**
+ * Deletes profiler overlay content.
+ */
+ProfilerOverlay::~ProfilerOverlay()
+{
+	delete _text;
+	delete _timer;
+}
+
+/**
+ * Replaces a certain amount of colors in the profiler overlay palette.
+ * @param colors Pointer to the set of colors.
+ * @param firstcolor Offset of the first color to replace.
+ * @param ncolors Amount of colors to replace.
+ */
+void ProfilerOverlay::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
+{
+	Surface::setPalette(colors, firstcolor, ncolors);
+	_text->setPalette(colors, firstcolor, ncolors);
+}
+
+/**
+ * Sets the text color of the overlay.
+ * @param color The color to set.
+ */
+void ProfilerOverlay::setColor(Uint8 color)
+{
+	_text->setColor(color);
+}
+
+/**
+ * Passes the fonts on to the contained text.
+ * @param big Pointer to large-size font.
+ * @param small Pointer to small-size font.
+ * @param lang Pointer to current language.
+ */
+void ProfilerOverlay::initText(Font *big, Font *small, Language *lang)
+{
+	_text->initText(big, small, lang);
+	_redraw = true;
+}
+
+/**
+ * Advances the refresh timer.
+ */
+void ProfilerOverlay::think()
+{
+	_timer->think(0, this);
+}
+
+/**
+ * Fetches the section timings of the last interval
+ * and lists the most expensive ones, along with how
+ * well the text layout cache did.
+ */
+void ProfilerOverlay::update()
+{
+	auto stats = Profiler::collectStats();
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	int lines = 0;
+	for (const auto& section : stats)
+	{
+		if (lines++ == MAX_LINES)
+		{
+			break;
+		}
+		ss << section.name << ": " << (section.totalUs / 1000.0 / section.calls) << "ms x" << section.calls << " (max " << (section.maxUs / 1000.0) << "ms)\n";
+	}
+
+	auto layouts = Text::getLayoutCacheStats();
+	Uint64 hits = layouts.hits - _layoutHits;
+	Uint64 misses = layouts.misses - _layoutMisses;
+	_layoutHits = layouts.hits;
+	_layoutMisses = layouts.misses;
+	if (hits + misses > 0)
+	{
+		ss << "Text layouts: " << (hits * 100.0 / (hits + misses)) << "% cached x" << (hits + misses) << " (" << layouts.entries << " kept)\n";
+	}
+	_text->setText(ss.str());
+	_redraw = true;
+}
+
+/**
+ * Draws the profiler overlay.
+ */
+void ProfilerOverlay::draw()
+{
+	Surface::draw();
+	_text->blit(this->getSurface());
+}
+
+}
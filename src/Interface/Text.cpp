@@ -17,6 +17,9 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Text.h"
+#include <cstring>
+#include <list>
+#include <unordered_map>
 #include "../fmath.h"
 #include "../Engine/Font.h"
 #include "../Engine/Options.h"
@@ -29,6 +32,90 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Everything besides the string itself that changes how a text is laid out.
+struct LayoutParams
+{
+	Font *font, *small;
+	int width;
+	int wrapping;
+	bool wrap, indent, ignoreSeparators;
+};
+
+/// A text already converted and split in lines.
+struct Layout
+{
+	std::string key;
+	UString text;
+	std::vector<int> lineWidth, lineHeight;
+};
+
+/**
+ * Keeps the most recently used text layouts, since most texts are
+ * set to the same few strings over and over (list rows, counters,
+ * tooltips) and wrapping them is the slow part of setting them.
+ */
+class LayoutCache
+{
+private:
+	static const size_t MAX_ENTRIES = 1024;
+	std::list<Layout> _entries;
+	std::unordered_map<std::string, std::list<Layout>::iterator> _index;
+public:
+	Uint64 hits = 0, misses = 0;
+
+	/// Builds the cache key for a string and its layout parameters.
+	static std::string makeKey(const LayoutParams &params, const std::string &text)
+	{
+		std::string key;
+		key.reserve(sizeof(params) + text.size());
+		key.append((const char*)&params, sizeof(params));
+		key.append(text);
+		return key;
+	}
+	/// Gets a cached layout, or null if there isn't one.
+	const Layout *find(const std::string &key)
+	{
+		auto i = _index.find(key);
+		if (i == _index.end())
+		{
+			misses++;
+			return 0;
+		}
+		hits++;
+		_entries.splice(_entries.begin(), _entries, i->second);
+		return &*i->second;
+	}
+	/// Stores a layout, dropping the least recently used one if full.
+	void add(Layout &&layout)
+	{
+		if (_entries.size() >= MAX_ENTRIES)
+		{
+			_index.erase(_entries.back().key);
+			_entries.pop_back();
+		}
+		_entries.push_front(std::move(layout));
+		_index[_entries.front().key] = _entries.begin();
+	}
+	/// Gets the number of cached layouts.
+	size_t size() const
+	{
+		return _entries.size();
+	}
+	/// Removes all cached layouts.
+	void clear()
+	{
+		_index.clear();
+		_entries.clear();
+	}
+};
+
+LayoutCache layoutCache;
+
+}
+
 /**
  * Sets up a blank text with the specified size and position.
  * @param width Width in pixels.
@@ -316,10 +403,31 @@ void Text::processText()
 		return;
 	}
 
+	_scrollY = 0;
+	_redraw = true;
+
+	// Zeroed first so the padding bytes don't end up in the key
+	LayoutParams params;
+	std::memset(&params, 0, sizeof(params));
+	params.font = _font;
+	params.small = _small;
+	params.width = _wrap ? getWidth() : 0;
+	params.wrapping = _lang->getTextWrapping();
+	params.wrap = _wrap;
+	params.indent = _indent;
+	params.ignoreSeparators = _ignoreSeparators;
+	std::string key = LayoutCache::makeKey(params, _text);
+	if (const Layout *layout = layoutCache.find(key))
+	{
+		_processedText = layout->text;
+		_lineWidth = layout->lineWidth;
+		_lineHeight = layout->lineHeight;
+		return;
+	}
+
 	_processedText = Unicode::convUtf8ToUtf32(_text);
 	_lineWidth.clear();
 	_lineHeight.clear();
-	_scrollY = 0;
 
 	int width = 0, word = 0;
 	size_t space = 0, textIndentation = 0;
@@ -421,12 +529,51 @@ void Text::processText()
 		}
 	}
 
-	_redraw = true;
+	Layout layout;
+	layout.key = std::move(key);
+	layout.text = _processedText;
+	layout.lineWidth = _lineWidth;
+	layout.lineHeight = _lineHeight;
+	layoutCache.add(std::move(layout));
+}
+
+/**
+ * Gets how often texts found their layout already cached,
+ * for performance checks.
+ * @return Hits, misses and cached layouts.
+ */
+Text::LayoutCacheStats Text::getLayoutCacheStats()
+{
+	LayoutCacheStats stats;
+	stats.hits = layoutCache.hits;
+	stats.misses = layoutCache.misses;
+	stats.entries = layoutCache.size();
+	return stats;
+}
+
+/**
+ * Empties the layout cache. Must be called whenever
+ * fonts are unloaded, since layouts are tied to them.
+ */
+void Text::clearLayoutCache()
+{
+	layoutCache.clear();
 }
 
 namespace
 {
 
+struct PaletteOffset
+{
+	static inline void func(Uint8& dest, const Uint8& src, int off)
+	{
+		if(src)
+		{
+			dest = off + src;
+		}
+	}
+};
+
 struct PaletteShift
 {
 	static inline void func(Uint8& dest, const Uint8& src, int off, int mul, int mid)
@@ -584,7 +731,11 @@ void Text::draw()
 			auto chr = font->getChar(*c);
 			chr.setX(x);
 			chr.setY(y);
-			ShaderDraw<PaletteShift>(ShaderSurface(this, 0, 0), ShaderCrop(chr), ShaderScalar(color), ShaderScalar(mul), ShaderScalar(mid));
+			// Plain text only needs its glyph shifted to the right palette block
+			if (mul == 1 && mid == 0)
+				ShaderDraw<PaletteOffset>(ShaderSurface(this, 0, 0), ShaderCrop(chr), ShaderScalar(color));
+			else
+				ShaderDraw<PaletteShift>(ShaderSurface(this, 0, 0), ShaderCrop(chr), ShaderScalar(color), ShaderScalar(mul), ShaderScalar(mid));
 			if (dir > 0)
 				x += dir * font->getCharSize(*c).w;
 		}
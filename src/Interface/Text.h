@@ -106,6 +106,17 @@ public:
 	void setScrollable(bool scroll);
 	/// Special handling for mouse presses.
 	void mousePress(Action* action, State* state) override;
+
+	/// Usage counters of the layout cache shared by all texts.
+	struct LayoutCacheStats
+	{
+		Uint64 hits, misses;
+		size_t entries;
+	};
+	/// Gets the usage counters of the layout cache.
+	static LayoutCacheStats getLayoutCacheStats();
+	/// Empties the layout cache.
+	static void clearLayoutCache();
 };
 
 }
@@ -39,7 +39,7 @@ namespace OpenXcom
  * @param x X position in pixels.
  * @param y Y position in pixels.
  */
-TextList::TextList(int width, int height, int x, int y) : InteractiveSurface(width, height, x, y),
+TextList::TextList(int width, int height, int x, int y) : InteractiveSurface(width, height, x, y), _virtual(false),
 	_big(0), _small(0), _font(0), _lang(nullptr), _scroll(0), _visibleRows(0), _selRow(0), _color(0), _color2(0),
 	_dot(false), _selectable(false), _condensed(false), _contrast(false), _wrap(false), _flooding(false), _ignoreSeparators(false),
 	_bg(0), _selector(0), _margin(0), _scrolling(true), _arrowPos(-1), _scrollPos(4), _arrowType(ARROW_VERTICAL),
@@ -70,6 +70,10 @@ TextList::~TextList()
 			delete text;
 		}
 	}
+	for (auto* text : _measure)
+	{
+		delete text;
+	}
 	for (auto* ab : _arrowLeft)
 	{
 		delete ab;
@@ -155,6 +159,11 @@ void TextList::unpress(State *state)
  */
 void TextList::setCellColor(size_t row, size_t column, Uint8 color)
 {
+	if (_virtual && _texts[row].empty())
+	{
+		_virtualRows[row].cells[column].color = color;
+		return;
+	}
 	_texts[row][column]->setColor(color);
 	_redraw = true;
 }
@@ -166,6 +175,14 @@ void TextList::setCellColor(size_t row, size_t column, Uint8 color)
  */
 void TextList::setRowColor(size_t row, Uint8 color)
 {
+	if (_virtual && _texts[row].empty())
+	{
+		for (auto& cell : _virtualRows[row].cells)
+		{
+			cell.color = color;
+		}
+		return;
+	}
 	for (auto* text : _texts[row])
 	{
 		text->setColor(color);
@@ -181,6 +198,10 @@ void TextList::setRowColor(size_t row, Uint8 color)
  */
 std::string TextList::getCellText(size_t row, size_t column) const
 {
+	if (_texts[row].empty())
+	{
+		return _virtualRows[row].cells[column].text;
+	}
 	return _texts[row][column]->getText();
 }
 
@@ -192,6 +213,11 @@ std::string TextList::getCellText(size_t row, size_t column) const
  */
 void TextList::setCellText(size_t row, size_t column, const std::string &text)
 {
+	if (_virtual && _texts[row].empty())
+	{
+		_virtualRows[row].cells[column].text = text;
+		return;
+	}
 	_texts[row][column]->setText(text);
 	_redraw = true;
 }
@@ -203,6 +229,10 @@ void TextList::setCellText(size_t row, size_t column, const std::string &text)
  */
 int TextList::getColumnX(size_t column) const
 {
+	if (_texts[0].empty())
+	{
+		return getX() + _virtualRows[0].cells[column].x;
+	}
 	return getX() + _texts[0][column]->getX();
 }
 
@@ -213,7 +243,7 @@ int TextList::getColumnX(size_t column) const
  */
 int TextList::getRowY(size_t row) const
 {
-	return getY() + _texts[row][0]->getY();
+	return getY() + getRowTop(row);
 }
 
 /**
@@ -223,6 +253,10 @@ int TextList::getRowY(size_t row) const
  */
 int TextList::getTextHeight(size_t row) const
 {
+	if (_texts[row].empty())
+	{
+		return _virtualRows[row].textHeight;
+	}
 	return _texts[row].front()->getTextHeight();
 }
 
@@ -233,6 +267,10 @@ int TextList::getTextHeight(size_t row) const
  */
 int TextList::getNumTextLines(size_t row) const
 {
+	if (_texts[row].empty())
+	{
+		return _virtualRows[row].lines;
+	}
 	return _texts[row].front()->getNumLines();
 }
 
@@ -272,6 +310,147 @@ size_t TextList::getVisibleRows() const
 	return _visibleRows;
 }
 
+/**
+ * Makes a Text for a cell of the list, set up like the list.
+ * @param width Width in pixels.
+ * @param x X position in pixels, relative to the list.
+ * @param y Y position in pixels, relative to the list.
+ * @param color Text color.
+ * @param color2 Secondary text color.
+ * @param align Horizontal alignment.
+ * @param big Use the big font?
+ * @return New Text.
+ */
+Text *TextList::makeText(int width, int x, int y, Uint8 color, Uint8 color2, TextHAlign align, bool big)
+{
+	Text* txt = new Text(width, (big ? _big : _small)->getHeight(), x, y);
+	txt->setPalette(this->getPalette());
+	txt->initText(_big, _small, _lang);
+	txt->setColor(color);
+	txt->setSecondaryColor(color2);
+	if (align)
+	{
+		txt->setAlign(align);
+	}
+	txt->setHighContrast(_contrast);
+	if (big)
+	{
+		txt->setBig();
+	}
+	else
+	{
+		txt->setSmall();
+	}
+	return txt;
+}
+
+/**
+ * Gets the Text's making up a row. In a virtual list, they are
+ * made from the row data if the row doesn't have them yet, and
+ * the rows that went the longest without being used lose theirs,
+ * so only a couple screens worth of rows ever have Text's.
+ * @param row Row number.
+ * @return Text's of the row.
+ */
+std::vector<Text*> &TextList::getRowTexts(size_t row)
+{
+	if (!_virtual)
+	{
+		return _texts[row];
+	}
+
+	auto cached = std::find(_virtualCache.begin(), _virtualCache.end(), row);
+	if (cached != _virtualCache.end())
+	{
+		// move it to the back, as the most recently used
+		std::rotate(cached, cached + 1, _virtualCache.end());
+		return _texts[row];
+	}
+
+	const VirtualRow &virtualRow = _virtualRows[row];
+	for (const auto& cell : virtualRow.cells)
+	{
+		Text* txt = makeText(cell.width, cell.x, virtualRow.y, cell.color, cell.color2, cell.align, virtualRow.big);
+		txt->setText(cell.text);
+		if (cell.wrap)
+		{
+			txt->setWordWrap(true, true, virtualRow.ignoreSeparators);
+		}
+		if (txt->getHeight() != virtualRow.height)
+		{
+			txt->setHeight(virtualRow.height);
+		}
+		_texts[row].push_back(txt);
+	}
+	_virtualCache.push_back(row);
+
+	const size_t maxCached = std::max<size_t>(_visibleRows * 2, 16);
+	while (_virtualCache.size() > maxCached)
+	{
+		freeRowTexts(_virtualCache.front());
+	}
+	return _texts[row];
+}
+
+/**
+ * Frees the Text's of a row in a virtual list,
+ * keeping what they were changed to in the row data.
+ * @param row Row number.
+ */
+void TextList::freeRowTexts(size_t row)
+{
+	auto cached = std::find(_virtualCache.begin(), _virtualCache.end(), row);
+	if (cached == _virtualCache.end())
+	{
+		return;
+	}
+	_virtualCache.erase(cached);
+
+	VirtualRow &virtualRow = _virtualRows[row];
+	auto& texts = _texts[row];
+	virtualRow.y = texts.front()->getY();
+	virtualRow.height = texts.front()->getHeight();
+	virtualRow.textHeight = texts.front()->getTextHeight();
+	virtualRow.lines = texts.front()->getNumLines();
+	for (size_t i = 0; i < texts.size(); ++i)
+	{
+		virtualRow.cells[i].text = texts[i]->getText();
+		virtualRow.cells[i].color = texts[i]->getColor();
+		delete texts[i];
+	}
+	texts.clear();
+}
+
+/**
+ * Returns the Y position of a row relative to the list,
+ * without making its Text's in a virtual list.
+ * @param row Row number.
+ * @return Y position in pixels.
+ */
+int TextList::getRowTop(size_t row) const
+{
+	if (_texts[row].empty())
+	{
+		return _virtualRows[row].y;
+	}
+	return _texts[row].front()->getY();
+}
+
+/**
+ * Returns the height of a row,
+ * without making its Text's in a virtual list.
+ * @param row Row number.
+ * @return Height in pixels.
+ */
+int TextList::getRowHeight(size_t row) const
+{
+	if (_texts[row].empty())
+	{
+		return _virtualRows[row].height;
+	}
+	return _texts[row].front()->getHeight();
+}
+
 /**
  * Adds a new row of text to the list, automatically creating
  * the required Text objects lined up where they need to be.
@@ -293,11 +472,12 @@ void TextList::addRow(int cols, ...)
 	}
 
 	std::vector<Text*> temp;
+	VirtualRow virtualRow;
 	// Positions are relative to list surface.
 	int rowX = 0, rowY = 0, rows = 1, rowHeight = 0;
 	if (!_texts.empty())
 	{
-		rowY = _texts.back().front()->getY() + _texts.back().front()->getHeight() + _font->getSpacing();
+		rowY = getRowTop(_texts.size() - 1) + getRowHeight(_texts.size() - 1) + _font->getSpacing();
 	}
 
 	for (int i = 0; i < ncols; ++i)
@@ -312,32 +492,38 @@ void TextList::addRow(int cols, ...)
 		{
 			width = _columns[i];
 		}
-		Text* txt = new Text(width, _font->getHeight(), _margin + rowX, rowY);
-		txt->setPalette(this->getPalette());
-		txt->initText(_big, _small, _lang);
-		txt->setColor(_color);
-		txt->setSecondaryColor(_color2);
-		if (_align[i])
-		{
-			txt->setAlign(_align[i]);
-		}
-		txt->setHighContrast(_contrast);
-		if (_font == _big)
+		Text* txt;
+		if (_virtual)
 		{
-			txt->setBig();
+			// lay out the cell with a reusable Text, the row gets its own when it's shown
+			if (_measure.size() <= (size_t)i)
+			{
+				_measure.resize(i + 1, nullptr);
+			}
+			if (_measure[i] == nullptr || _measure[i]->getWidth() != width)
+			{
+				delete _measure[i];
+				_measure[i] = makeText(width, 0, 0, _color, _color2, ALIGN_LEFT, _font == _big);
+			}
+			txt = _measure[i];
+			txt->setWordWrap(false);
 		}
 		else
 		{
-			txt->setSmall();
+			txt = makeText(width, _margin + rowX, rowY, _color, _color2, _align[i], _font == _big);
 		}
 		if (cols > 0)
 			txt->setText(va_arg(args, char*));
+		else if (_virtual)
+			txt->setText("");
 		// grab this before we enable word wrapping so we can use it to calculate
 		// the total row height below
 		int vmargin = _font->getHeight() - txt->getTextHeight();
 		// Wordwrap text if necessary
+		bool wrap = false;
 		if (_wrap && txt->getTextWidth() > txt->getWidth())
 		{
+			wrap = true;
 			txt->setWordWrap(true, true, _ignoreSeparators);
 			rows = std::max(rows, txt->getNumLines());
 		}
@@ -364,7 +550,19 @@ void TextList::addRow(int cols, ...)
 			txt->setText(buf);
 		}
 
-		temp.push_back(txt);
+		if (_virtual)
+		{
+			virtualRow.cells.push_back({ txt->getText(), _margin + rowX, width, _color, _color2, _align[i], wrap });
+			if (i == 0)
+			{
+				virtualRow.textHeight = txt->getTextHeight();
+				virtualRow.lines = txt->getNumLines();
+			}
+		}
+		else
+		{
+			temp.push_back(txt);
+		}
 		if (_condensed)
 		{
 			rowX += txt->getTextWidth();
@@ -375,10 +573,21 @@ void TextList::addRow(int cols, ...)
 		}
 	}
 
-	// ensure all elements in this row are the same height
-	for (int i = 0; i < cols; ++i)
+	if (_virtual)
+	{
+		virtualRow.y = rowY;
+		virtualRow.height = cols > 0 ? rowHeight : _font->getHeight();
+		virtualRow.big = (_font == _big);
+		virtualRow.ignoreSeparators = _ignoreSeparators;
+		_virtualRows.push_back(virtualRow);
+	}
+	else
 	{
-		temp[i]->setHeight(rowHeight);
+		// ensure all elements in this row are the same height
+		for (int i = 0; i < cols; ++i)
+		{
+			temp[i]->setHeight(rowHeight);
+		}
 	}
 
 	_texts.push_back(temp);
@@ -432,6 +641,11 @@ void TextList::removeLastRow()
 {
 	if (!_texts.empty())
 	{
+		if (_virtual)
+		{
+			freeRowTexts(_texts.size() - 1);
+			_virtualRows.pop_back();
+		}
 		_texts.pop_back();
 	}
 	if (!_rows.empty())
@@ -530,6 +744,11 @@ void TextList::initText(Font *big, Font *small, Language *lang)
 	_selector = new Surface(getWidth(), _font->getHeight() + _font->getSpacing(), getX(), getY());
 	_selector->setPalette(getPalette());
 	_selector->setVisible(false);
+	for (auto* text : _measure)
+	{
+		delete text;
+	}
+	_measure.clear();
 
 	updateVisible();
 
@@ -566,6 +785,13 @@ void TextList::setColor(Uint8 color)
 			text->setColor(color);
 		}
 	}
+	for (auto& row : _virtualRows)
+	{
+		for (auto& cell : row.cells)
+		{
+			cell.color = color;
+		}
+	}
 }
 
 /**
@@ -584,6 +810,13 @@ Uint8 TextList::getColor() const
 void TextList::setSecondaryColor(Uint8 color)
 {
 	_color2 = color;
+	for (auto& row : _virtualRows)
+	{
+		for (auto& cell : row.cells)
+		{
+			cell.color2 = color;
+		}
+	}
 }
 
 /**
@@ -676,6 +909,11 @@ void TextList::setBig()
 	_selector = new Surface(getWidth(), _font->getHeight() + _font->getSpacing(), getX(), getY());
 	_selector->setPalette(getPalette());
 	_selector->setVisible(false);
+	for (auto* text : _measure)
+	{
+		delete text;
+	}
+	_measure.clear();
 
 	updateVisible();
 }
@@ -691,6 +929,11 @@ void TextList::setSmall()
 	_selector = new Surface(getWidth(), _font->getHeight() + _font->getSpacing(), getX(), getY());
 	_selector->setPalette(getPalette());
 	_selector->setVisible(false);
+	for (auto* text : _measure)
+	{
+		delete text;
+	}
+	_measure.clear();
 
 	updateVisible();
 }
@@ -894,9 +1137,22 @@ void TextList::clearList()
 	scrollUp(true, false);
 	_texts.clear();
 	_rows.clear();
+	_virtualRows.clear();
+	_virtualCache.clear();
 	_redraw = true;
 }
 
+/**
+ * Makes the list keep its rows as plain data and only make
+ * the Text's for the rows that are shown or changed, for lists
+ * with lots of rows. Must be set before adding any rows.
+ * @param isVirtual Virtual setting.
+ */
+void TextList::setVirtual(bool isVirtual)
+{
+	_virtual = isVirtual;
+}
+
 /**
  * Scrolls the text in the list up by one row or to the top.
  * @param toMax If true then scrolls to the top of the list. false => one row up
@@ -1016,14 +1272,15 @@ void TextList::draw()
 		}
 		for (size_t i = _rows[_scroll]; i < _texts.size() && i < _rows[_scroll] + _visibleRows; ++i)
 		{
-			for (auto* text : _texts[i])
+			auto& texts = getRowTexts(i);
+			for (auto* text : texts)
 			{
 				text->setY(y);
 				text->blit(this->getSurface());
 			}
-			if (!_texts[i].empty())
+			if (!texts.empty())
 			{
-				y += _texts[i].front()->getHeight() + _font->getSpacing();
+				y += texts.front()->getHeight() + _font->getSpacing();
 			}
 			else
 			{
@@ -1066,9 +1323,9 @@ void TextList::blit(SDL_Surface *surface)
 					_arrowRight[i]->blit(surface);
 				}
 
-				if (!_texts[i].empty())
+				if (!_texts[i].empty() || _virtual)
 				{
-					y += _texts[i].front()->getHeight() + _font->getSpacing();
+					y += getRowHeight(i) + _font->getSpacing();
 				}
 				else
 				{
@@ -1229,9 +1486,9 @@ void TextList::mouseOver(Action *action, State *state)
 		_selRow = std::max(0, (int)(_scroll + (int)floor(action->getRelativeYMouse() / (rowHeight * action->getYScale()))));
 		if (_selRow < _rows.size())
 		{
-			Text *selText = _texts[_rows[_selRow]].front();
-			int y = getY() + selText->getY();
-			int actualHeight = selText->getHeight() + _font->getSpacing(); //current line height
+			size_t selText = _rows[_selRow];
+			int y = getY() + getRowTop(selText);
+			int actualHeight = getRowHeight(selText) + _font->getSpacing(); //current line height
 			if (y < getY() || y + actualHeight > getY() + getHeight())
 			{
 				actualHeight /= 2;
@@ -40,7 +40,33 @@ class ScrollBar;
 class TextList : public InteractiveSurface
 {
 private:
+	/**
+	 * A cell of a row in a virtual list, with everything
+	 * needed to make its Text when the row is shown.
+	 */
+	struct VirtualCell
+	{
+		std::string text;
+		int x, width;
+		Uint8 color, color2;
+		TextHAlign align;
+		bool wrap;
+	};
+	/**
+	 * A row in a virtual list.
+	 */
+	struct VirtualRow
+	{
+		std::vector<VirtualCell> cells;
+		int y, height, textHeight, lines;
+		bool big, ignoreSeparators;
+	};
+
 	std::vector< std::vector<Text*> > _texts;
+	bool _virtual;
+	std::vector<VirtualRow> _virtualRows;
+	std::vector<size_t> _virtualCache;
+	std::vector<Text*> _measure;
 	std::vector<size_t> _columns, _rows;
 	Font *_big, *_small, *_font;
 	Language *_lang;
@@ -65,6 +91,16 @@ private:
 	void updateArrows();
 	/// Updates the visible rows.
 	void updateVisible();
+	/// Makes a Text for a cell.
+	Text *makeText(int width, int x, int y, Uint8 color, Uint8 color2, TextHAlign align, bool big);
+	/// Gets the Text's of a row, making them first in a virtual list.
+	std::vector<Text*> &getRowTexts(size_t row);
+	/// Frees the Text's of a row in a virtual list.
+	void freeRowTexts(size_t row);
+	/// Gets the Y position of a row relative to the list.
+	int getRowTop(size_t row) const;
+	/// Gets the height of a row.
+	int getRowHeight(size_t row) const;
 public:
 	/// Creates a text list with the specified size and position.
 	TextList(int width, int height, int x = 0, int y = 0);
@@ -170,6 +206,8 @@ public:
 	void onRightArrowRelease(ActionHandler handler);
 	/// Clears the list.
 	void clearList();
+	/// Sets whether the list only makes Text's for the rows on screen.
+	void setVirtual(bool isVirtual);
 	/// Scrolls the list up.
 	void scrollUp(bool toMax, bool scrollByWheel = false);
 	/// Scrolls the list down.
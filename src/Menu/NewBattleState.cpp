@@ -378,7 +378,7 @@ void NewBattleState::load(const std::string &filename)
 				{
 					std::string craftType = _crafts[_cbxCraft->getSelected()];
 					_craft = new Craft(_game->getMod()->getCraft(craftType), base, save->getId(craftType));
-					base->getCrafts()->push_back(_craft);
+					base->addCraft(_craft);
 				}
 				else
 				{
@@ -448,20 +448,22 @@ void NewBattleState::initSave()
 	save->getBases()->push_back(base);
 
 	// Kill everything we don't want in this base
-	for (auto* soldier : *base->getSoldiers())
+	while (!base->getSoldiers()->empty())
 	{
+		Soldier *soldier = base->getSoldiers()->back();
+		base->removeSoldier(base->getSoldiers()->end() - 1);
 		delete soldier;
 	}
-	base->getSoldiers()->clear();
-	for (auto* xcraft : *base->getCrafts())
+	while (!base->getCrafts()->empty())
 	{
+		Craft *xcraft = base->getCrafts()->back();
+		base->removeCraft(xcraft, false);
 		delete xcraft;
 	}
-	base->getCrafts()->clear();
 	base->getStorageItems()->getContents()->clear();
 
 	_craft = new Craft(mod->getCraft(_crafts[_cbxCraft->getSelected()]), base, 1);
-	base->getCrafts()->push_back(_craft);
+	base->addCraft(_craft);
 
 	// Generate soldiers
 	bool psiStrengthEval = (Options::psiStrengthEval && save->isResearched(mod->getPsiRequirements()));
@@ -498,7 +500,7 @@ void NewBattleState::initSave()
 		// update again, could have been changed since soldier creation
 		soldier->calcStatString(mod->getStatStrings(), psiStrengthEval);
 
-		base->getSoldiers()->push_back(soldier);
+		base->addSoldier(soldier);
 
 		int space = _craft->getSpaceAvailable();
 		if (_craft->validateAddingSoldier(space, soldier))
@@ -592,7 +594,7 @@ void NewBattleState::btnOkClick(Action *)
 			u->setStatus(Ufo::CRASHED);
 			bgame->setMissionType("STR_UFO_CRASH_RECOVERY");
 		}
-		_game->getSavedGame()->getUfos()->push_back(u);
+		_game->getSavedGame()->addUfo(u);
 	}
 	// mission site
 	else
@@ -604,7 +606,7 @@ void NewBattleState::btnOkClick(Action *)
 		m->setAlienRace(_alienRaces[_cbxAlienRace->getSelected()]);
 		_craft->setDestination(m);
 		bgen.setMissionSite(m);
-		_game->getSavedGame()->getMissionSites()->push_back(m);
+		_game->getSavedGame()->addMissionSite(m);
 	}
 
 	if (_craft)
@@ -665,6 +667,31 @@ void NewBattleState::btnRandomClick(Action *)
 	_slrAlienTech->setValue(RNG::generate(0, _game->getMod()->getAlienItemLevels().size()-1));
 }
 
+/**
+ * Selects a mission type and picks one of its terrains
+ * at random, the way the Random button does.
+ * @param type Deployment name.
+ * @return False if the mission type isn't in the list
+ * or has no terrains to pick from.
+ */
+bool NewBattleState::selectMission(const std::string &type)
+{
+	auto i = std::find(_missionTypes.begin(), _missionTypes.end(), type);
+	if (i == _missionTypes.end())
+	{
+		return false;
+	}
+	_cbxMission->setSelected(i - _missionTypes.begin());
+	cbxMissionChange(0);
+	if (_terrainTypes.empty())
+	{
+		return false;
+	}
+	_cbxTerrain->setSelected(RNG::generate(0, _terrainTypes.size() - 1));
+	cbxTerrainChange(0);
+	return true;
+}
+
 /**
  * Shows the Craft Info screen.
  * @param action Pointer to an action.
@@ -84,6 +84,8 @@ public:
 	void btnCancelClick(Action *action);
 	/// Handler for clicking the Randomize button.
 	void btnRandomClick(Action *action);
+	/// Selects a mission type with a random terrain.
+	bool selectMission(const std::string &type);
 	/// Handler for clicking the Equip Craft button.
 	void btnEquipClick(Action *action);
 	/// Handler for changing the Mission combobox.
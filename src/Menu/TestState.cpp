@@ -147,6 +147,7 @@ TestState::TestState()
 	_testCases.push_back("STR_PALETTE_CHECK");
 	_testCases.push_back("STR_SCRIPT_TAGS");
 	_testCases.push_back("STR_MAP_RESOURCES");
+	_testCases.push_back("STR_MEMORY_USAGE");
 
 	_cbxTestCase->setOptions(_testCases, true);
 	_cbxTestCase->onChange((ActionHandler)&TestState::cbxTestCaseChange);
@@ -202,6 +203,7 @@ void TestState::btnRunClick(Action *action)
 		case 2: testCase2(); break;
 		case 3: testCase3(); break;
 		case 4: testCase4(); break;
+		case 5: testCase5(); break;
 		default: break;
 	}
 }
@@ -229,6 +231,26 @@ void TestState::cbxPaletteAction(Action *action)
 	_game->pushState(new TestPaletteState(palette, type));
 }
 
+void TestState::testCase5()
+{
+	std::vector<ResourceUsage> byType, byMod;
+	_game->getMod()->getResourceUsage(byType, byMod);
+	_game->getMod()->logResourceUsage();
+
+	auto addRows = [&](const std::vector<ResourceUsage> &usages)
+	{
+		for (const auto& usage : usages)
+		{
+			std::ostringstream ss;
+			ss << usage.name << ": " << usage.count << ", " << Unicode::formatNumber(usage.bytes / 1024) << " KB";
+			_lstOutput->addRow(1, ss.str().c_str());
+		}
+	};
+	addRows(byType);
+	_lstOutput->addRow(1, "");
+	addRows(byMod);
+}
+
 void TestState::testCase4()
 {
 	_lstOutput->addRow(1, tr("STR_TESTS_STARTING").c_str());
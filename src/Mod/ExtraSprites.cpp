@@ -25,6 +25,8 @@
 #include "../Engine/Logger.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Unicode.h"
+#include "../Engine/Parallel.h"
+#include "../Engine/SDL2Helpers.h"
 #include "Mod.h"
 
 namespace OpenXcom
@@ -168,12 +170,211 @@ bool ExtraSprites::isImageFile(const std::string &filename)
 	return false;
 }
 
+/**
+ * Gets the sorted image files of a sprite folder.
+ * @param folder Folder name, ending with a slash.
+ * @return Image filenames, without the folder.
+ */
+static std::vector<std::string> getFolderImages(const std::string &folder)
+{
+	std::vector<std::string> contents;
+	for (const auto& f : FileMap::getVFolderContents(folder))
+	{
+		if (ExtraSprites::isImageFile(f))
+		{
+			contents.push_back(f);
+		}
+	}
+	std::sort(contents.begin(), contents.end(), Unicode::naturalCompare);
+	return contents;
+}
+
+/**
+ * Adds the files that loading this sprite will read to a list.
+ * @param files List of filenames.
+ */
+void ExtraSprites::getImageFiles(std::vector<std::string> &files) const
+{
+	if (_singleImage)
+	{
+		if (!_sprites.empty())
+		{
+			files.push_back(_sprites.begin()->second);
+		}
+		return;
+	}
+	for (const auto& pair : _sprites)
+	{
+		const auto& fileName = pair.second;
+		if (fileName[fileName.length() - 1] == '/')
+		{
+			for (const auto& name : getFolderImages(fileName))
+			{
+				files.push_back(fileName + name);
+			}
+		}
+		else
+		{
+			files.push_back(fileName);
+		}
+	}
+}
+
+/**
+ * Reads a PNG file into memory. Must be called from the main
+ * thread, since the virtual file system isn't thread-safe.
+ * @param file Image filename.
+ * @return False if the file isn't a PNG or can't be read.
+ */
+bool PendingImage::read(const std::string &file)
+{
+	if (!CrossPlatform::compareExt(file, "png"))
+		return false;
+	SDL_RWops *rw = FileMap::getRWops(file);
+	if (!rw)
+		return false;
+	fileName = file;
+	data = SDL_LoadFile_RW(rw, &size, SDL_TRUE);
+	return data != 0;
+}
+
+/**
+ * Finds a PNG file without reading it yet, so decode() can read it
+ * on another thread. Must be called from the main thread. Files in
+ * a zip are still read right away, since the zip reader isn't
+ * thread-safe, but plain files don't need the virtual file system.
+ * @param file Image filename.
+ * @return False if the file isn't a PNG or can't be found.
+ */
+bool PendingImage::locate(const std::string &file)
+{
+	if (!CrossPlatform::compareExt(file, "png"))
+		return false;
+	const FileMap::FileRecord *record = FileMap::at(file);
+	if (!record)
+		return false;
+	if (record->zip)
+		return read(file);
+	fileName = file;
+	path = record->fullpath;
+	return true;
+}
+
+/**
+ * Decodes the file read into memory, reading it first if
+ * it was only located. Can be called from any thread.
+ */
+void PendingImage::decode()
+{
+	if (!data && !path.empty())
+	{
+		SDL_RWops *rw = SDL_RWFromFile(path.c_str(), "rb");
+		if (rw)
+		{
+			data = SDL_LoadFile_RW(rw, &size, SDL_TRUE);
+		}
+		if (!data)
+		{
+			return;
+		}
+	}
+	auto image = std::make_unique<Surface>();
+	if (image->loadPng(data, size, message))
+	{
+		surface = std::move(image);
+	}
+}
+
+/**
+ * Frees the file read into memory and stores the decoded image,
+ * if any. Must be called from the main thread, since it logs.
+ * @param images Map to store the decoded image in.
+ */
+void PendingImage::finish(PreloadedImages &images)
+{
+	SDL_free(data);
+	data = 0;
+	if (surface)
+	{
+		if (!message.empty())
+		{
+			Log(LOG_WARNING) << "Image " << fileName << message;
+		}
+		images[fileName] = std::move(surface);
+	}
+}
+
+/**
+ * Decodes a list of PNG files on several threads at once, so
+ * loading sprites afterwards only has to move them into place.
+ * The files are read in batches on this thread, since the virtual
+ * file system isn't thread-safe, and then decoded in parallel.
+ * Files that aren't PNGs or fail to decode are left out, so
+ * they get loaded (and any errors reported) the regular way.
+ * @param files Filenames to decode.
+ * @param images Map to store the decoded images in.
+ */
+void ExtraSprites::preloadImages(const std::vector<std::string> &files, PreloadedImages &images)
+{
+	const size_t BATCH_SIZE = 256;
+
+	std::vector<PendingImage> pending;
+	for (size_t start = 0; start < files.size(); start += BATCH_SIZE)
+	{
+		pending.clear();
+		for (size_t i = start; i < files.size() && i < start + BATCH_SIZE; ++i)
+		{
+			if (images.find(files[i]) != images.end())
+				continue;
+			PendingImage image;
+			if (image.read(files[i]))
+			{
+				pending.push_back(std::move(image));
+			}
+		}
+
+		Parallel::forEach(pending.size(), [&](size_t i)
+		{
+			pending[i].decode();
+		});
+
+		for (auto& image : pending)
+		{
+			image.finish(images);
+		}
+	}
+}
+
+/**
+ * Loads an image file into a surface, taking
+ * it from the preloaded images if available.
+ * @param surface Surface to load into.
+ * @param fileName Image filename.
+ * @param preloaded Preloaded images, if any.
+ */
+void ExtraSprites::loadImage(Surface *surface, const std::string &fileName, PreloadedImages *preloaded) const
+{
+	if (preloaded != 0)
+	{
+		auto i = preloaded->find(fileName);
+		if (i != preloaded->end())
+		{
+			Log(LOG_VERBOSE) << "Loading image: " << fileName << " (preloaded)";
+			*surface = std::move(*i->second);
+			preloaded->erase(i);
+			return;
+		}
+	}
+	surface->loadImage(fileName);
+}
+
 /**
  * Loads the external sprite into a new or existing surface.
  * @param surface Existing surface.
+ * @param preloaded Images decoded ahead of time, if any.
  * @return New surface.
  */
-Surface *ExtraSprites::loadSurface(Surface *surface)
+Surface *ExtraSprites::loadSurface(Surface *surface, PreloadedImages *preloaded)
 {
 	if (!_singleImage)
 		return surface;
@@ -189,16 +390,17 @@ Surface *ExtraSprites::loadSurface(Surface *surface)
 		delete surface;
 	}
 	surface = new Surface(_width, _height);
-	surface->loadImage(_sprites.begin()->second);
+	loadImage(surface, _sprites.begin()->second, preloaded);
 	return surface;
 }
 
 /**
  * Loads the external sprite into a new or existing surface set.
  * @param set Existing surface set.
+ * @param preloaded Images decoded ahead of time, if any.
  * @return New surface set.
  */
-SurfaceSet *ExtraSprites::loadSurfaceSet(SurfaceSet *set)
+SurfaceSet *ExtraSprites::loadSurfaceSet(SurfaceSet *set, PreloadedImages *preloaded)
 {
 	if (_singleImage)
 		return set;
@@ -232,16 +434,11 @@ SurfaceSet *ExtraSprites::loadSurfaceSet(SurfaceSet *set)
 		{
 			Log(LOG_VERBOSE) << "Loading surface set from folder: " << fileName << " starting at frame: " << startFrame;
 			int offset = startFrame;
-			std::vector<std::string> contents;
-			for (const auto& f: FileMap::getVFolderContents(fileName)) { contents.push_back(f); }
-			std::sort(contents.begin(), contents.end(), Unicode::naturalCompare);
-			for (const auto& name : contents)
+			for (const auto& name : getFolderImages(fileName))
 			{
-				if (!isImageFile(name))
-					continue;
 				try
 				{
-					getFrame(set, offset)->loadImage(fileName + name);
+					loadImage(getFrame(set, offset), fileName + name, preloaded);
 					offset++;
 				}
 				catch (Exception &e)
@@ -254,12 +451,12 @@ SurfaceSet *ExtraSprites::loadSurfaceSet(SurfaceSet *set)
 		{
 			if (!subdivision)
 			{
-				getFrame(set, startFrame)->loadImage(fileName);
+				loadImage(getFrame(set, startFrame), fileName, preloaded);
 			}
 			else
 			{
 				Surface temp = Surface(_width, _height);
-				temp.loadImage(fileName);
+				loadImage(&temp, fileName, preloaded);
 				int xDivision = _width / _subX;
 				int yDivision = _height / _subY;
 				int frames = xDivision * yDivision;
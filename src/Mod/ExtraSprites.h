@@ -20,6 +20,9 @@
 #include <yaml-cpp/yaml.h>
 #include <string>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace OpenXcom
 {
@@ -28,6 +31,31 @@ class Surface;
 class SurfaceSet;
 struct ModData;
 
+/// Images decoded ahead of time, by filename.
+typedef std::unordered_map<std::string, std::unique_ptr<Surface> > PreloadedImages;
+
+/**
+ * A PNG file read into memory, so it can be
+ * decoded on another thread.
+ */
+struct PendingImage
+{
+	std::string fileName, path;
+	void *data = 0;
+	size_t size = 0;
+	std::unique_ptr<Surface> surface;
+	std::string message;
+
+	/// Reads a PNG file into memory.
+	bool read(const std::string &file);
+	/// Finds a PNG file, to be read when it's decoded.
+	bool locate(const std::string &file);
+	/// Decodes the file.
+	void decode();
+	/// Frees the file and stores the decoded image.
+	void finish(PreloadedImages &images);
+};
+
 /**
  * For adding a set of extra sprite data to the game.
  */
@@ -43,6 +71,7 @@ private:
 	bool _loaded;
 
 	Surface *getFrame(SurfaceSet *set, int index) const;
+	void loadImage(Surface *surface, const std::string &fileName, PreloadedImages *preloaded) const;
 public:
 	/// Creates a blank external sprite set.
 	ExtraSprites();
@@ -66,12 +95,18 @@ public:
 	int getSubY() const;
 	/// Has this sprite been loaded?
 	bool isLoaded() const;
+	/// Marks the sprite as not loaded, after its surface is freed.
+	void unload() { _loaded = false; }
 	/// Checks if a filename is a valid image file.
 	static bool isImageFile(const std::string &filename);
+	/// Gets the image files the sprite is loaded from.
+	void getImageFiles(std::vector<std::string> &files) const;
+	/// Decodes PNG files on several threads at once.
+	static void preloadImages(const std::vector<std::string> &files, PreloadedImages &images);
 	/// Load the external sprite into a surface.
-	Surface *loadSurface(Surface *surface);
+	Surface *loadSurface(Surface *surface, PreloadedImages *preloaded = 0);
 	/// Load the external sprite into a surface set.
-	SurfaceSet *loadSurfaceSet(SurfaceSet *set);
+	SurfaceSet *loadSurfaceSet(SurfaceSet *set, PreloadedImages *preloaded = 0);
 	/// Gets mod data that define this surface.
 	const ModData* getModOwner() { return _current; }
 };
@@ -40,10 +40,13 @@
 #include "../Engine/ShaderMove.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Logger.h"
+#include "../Engine/Profiler.h"
 #include "../Engine/ScriptBind.h"
 #include "../Engine/Collections.h"
 #include "SoundDefinition.h"
 #include "ExtraSprites.h"
+#include "ResourcePrefetcher.h"
+#include "TerrainCache.h"
 #include "CustomPalettes.h"
 #include "ExtraSounds.h"
 #include "../Engine/AdlibMusic.h"
@@ -374,8 +377,10 @@ Mod::Mod() :
 	_baseDefenseMapFromLocation(0), _disableUnderwaterSounds(false), _enableUnitResponseSounds(false), _pediaReplaceCraftFuelWithRangeType(-1),
 	_facilityListOrder(0), _craftListOrder(0), _itemCategoryListOrder(0), _itemListOrder(0),
 	_researchListOrder(0),  _manufactureListOrder(0), _soldierBonusListOrder(0), _transformationListOrder(0), _ufopaediaListOrder(0), _invListOrder(0), _soldierListOrder(0),
-	_modCurrent(0), _statePalette(0)
+	_modCurrent(0), _statePalette(0), _stateChanges(0), _trackLazySurfaces(false)
 {
+	_prefetcher = new ResourcePrefetcher();
+	_terrainCache = new TerrainCache(this);
 	_muteMusic = new Music();
 	_muteSound = new Sound();
 	_globe = new RuleGlobe();
@@ -519,6 +524,8 @@ Mod::Mod() :
  */
 Mod::~Mod()
 {
+	delete _prefetcher;
+	delete _terrainCache;
 	delete _muteMusic;
 	delete _muteSound;
 	delete _globe;
@@ -778,24 +785,324 @@ Font *Mod::getFont(const std::string &name, bool error) const
 
 /**
  * Loads any extra sprites associated to a surface when
- * it's first requested.
+ * it's first requested, using the prefetched images if any.
+ * Surfaces only ever requested by states can be freed later
+ * by trimSurfaces(), any other request keeps them for good,
+ * since the rules, units, cursor, etc. hold on to them.
  * @param name Surface name.
+ * @param stateLocal Is the pointer only kept by the calling state?
  */
-void Mod::lazyLoadSurface(const std::string &name)
+void Mod::lazyLoadSurface(const std::string &name, bool stateLocal)
 {
 	if (Options::lazyLoadResources)
 	{
 		auto i = _extraSprites.find(name);
 		if (i != _extraSprites.end())
 		{
+			if (_trackLazySurfaces && Options::oxceResourceBudget > 0)
+			{
+				auto use = _lazySurfaceUse.find(name);
+				if (!stateLocal)
+				{
+					if (use != _lazySurfaceUse.end())
+					{
+						_lazySurfaceUse.erase(use);
+					}
+					_pinnedSurfaces.insert(name);
+				}
+				else if (use != _lazySurfaceUse.end())
+				{
+					use->second = _stateChanges;
+				}
+				else if (_pinnedSurfaces.find(name) == _pinnedSurfaces.end() &&
+					!i->second.front()->isLoaded() && _surfaces.find(name) == _surfaces.end() && _sets.find(name) == _sets.end())
+				{
+					// made only of mod images, so it can be freed and loaded again
+					_lazySurfaceUse[name] = _stateChanges;
+				}
+			}
+			if (_prefetcher->isPending(name))
+			{
+				_prefetcher->take(name, _prefetched);
+			}
 			for (auto* extraSprites : i->second)
 			{
-				loadExtraSprite(extraSprites);
+				loadExtraSprite(extraSprites, &_prefetched);
 			}
 		}
 	}
 }
 
+/**
+ * Lets the mod know some surfaces will be needed soon, so with
+ * lazy loading their images get decoded in the background instead
+ * of all at once when first requested, which would only block
+ * if they're requested before they're ready.
+ * Names without any extra sprites are ignored.
+ * @param names Names of surfaces and surface sets.
+ */
+void Mod::prefetchSurfaces(const std::vector<std::string> &names)
+{
+	if (!Options::lazyLoadResources)
+	{
+		return;
+	}
+
+	std::vector<std::pair<std::string, std::vector<std::string> > > resources;
+	for (const auto& name : names)
+	{
+		auto i = _extraSprites.find(name);
+		if (i == _extraSprites.end() || _prefetcher->isPending(name))
+		{
+			continue;
+		}
+		std::vector<std::string> files;
+		for (auto* extraSprites : i->second)
+		{
+			if (!extraSprites->isLoaded())
+			{
+				extraSprites->getImageFiles(files);
+			}
+		}
+		if (!files.empty())
+		{
+			resources.push_back(std::make_pair(name, files));
+		}
+	}
+	if (!resources.empty())
+	{
+		_prefetcher->prefetch(resources);
+	}
+}
+
+namespace
+{
+
+/**
+ * Gets the memory taken by the pixels of a surface.
+ * @param surface Pointer to the surface.
+ * @return Size in bytes.
+ */
+size_t getSurfaceBytes(const Surface *surface)
+{
+	return (size_t)surface->getPitch() * surface->getHeight();
+}
+
+/**
+ * Gets the memory taken by the pixels of all the frames in a surface set.
+ * @param set Pointer to the surface set.
+ * @return Size in bytes.
+ */
+size_t getSurfaceSetBytes(const SurfaceSet *set)
+{
+	size_t bytes = 0;
+	for (size_t i = 0; i < set->getTotalFrames(); ++i)
+	{
+		const Surface *frame = set->getFrame(i);
+		if (frame)
+		{
+			bytes += getSurfaceBytes(frame);
+		}
+	}
+	return bytes;
+}
+
+/**
+ * Adds a resource to a usage entry.
+ * @param usage Usage entries by name.
+ * @param name Name of the entry.
+ * @param bytes Size of the resource.
+ */
+void addResourceUsage(std::map<std::string, ResourceUsage> &usage, const std::string &name, size_t bytes)
+{
+	ResourceUsage &entry = usage[name];
+	entry.name = name;
+	entry.count++;
+	entry.bytes += bytes;
+}
+
+}
+
+/**
+ * Adds up the memory taken by the loaded images, sounds, palettes
+ * and transparency tables. Surfaces and sounds changed by mods count
+ * towards the last mod that changed them, everything else towards
+ * the master mod. Music is streamed by SDL_mixer, so only the
+ * tracks are counted.
+ * @param byType Gets the usage of each kind of resource.
+ * @param byMod Gets the usage of each mod that has any resources.
+ */
+void Mod::getResourceUsage(std::vector<ResourceUsage> &byType, std::vector<ResourceUsage> &byMod) const
+{
+	std::map<std::string, ResourceUsage> types, mods;
+	const std::string &master = _modData.empty() ? STR_NULL : _modData.front().name;
+	auto getOwner = [&](const std::string &name) -> const std::string&
+	{
+		auto i = _extraSprites.find(name);
+		if (i != _extraSprites.end() && !i->second.empty() && i->second.back()->getModOwner())
+		{
+			return i->second.back()->getModOwner()->name;
+		}
+		return master;
+	};
+
+	for (const auto& pair : _surfaces)
+	{
+		size_t bytes = getSurfaceBytes(pair.second);
+		addResourceUsage(types, "Surfaces", bytes);
+		addResourceUsage(mods, getOwner(pair.first), bytes);
+	}
+	for (const auto& pair : _sets)
+	{
+		size_t bytes = getSurfaceSetBytes(pair.second);
+		addResourceUsage(types, "Surface sets", bytes);
+		addResourceUsage(mods, getOwner(pair.first), bytes);
+	}
+	for (const auto& pair : _sounds)
+	{
+		size_t bytes = pair.second->getTotalSize();
+		const std::string *owner = &master;
+		for (const auto& extraSounds : _extraSounds)
+		{
+			if (extraSounds.first == pair.first && extraSounds.second->getModOwner())
+			{
+				owner = &extraSounds.second->getModOwner()->name;
+			}
+		}
+		addResourceUsage(types, "Sound sets", bytes);
+		addResourceUsage(mods, *owner, bytes);
+	}
+	for (size_t i = 0; i < _musics.size(); ++i)
+	{
+		addResourceUsage(types, "Music tracks", 0);
+	}
+	for (size_t i = 0; i < _palettes.size(); ++i)
+	{
+		addResourceUsage(types, "Palettes", sizeof(SDL_Color) * 256);
+		addResourceUsage(mods, master, sizeof(SDL_Color) * 256);
+	}
+	for (const auto& lut : _transparencyLUTs)
+	{
+		addResourceUsage(types, "Transparency LUTs", lut.size());
+		addResourceUsage(mods, master, lut.size());
+	}
+
+	byType.clear();
+	for (const auto& pair : types)
+	{
+		byType.push_back(pair.second);
+	}
+	byMod.clear();
+	for (const auto& modData : _modData)
+	{
+		auto i = mods.find(modData.name);
+		if (i != mods.end())
+		{
+			byMod.push_back(i->second);
+		}
+	}
+}
+
+/**
+ * Logs how much memory the loaded resources take,
+ * by kind of resource and by mod.
+ */
+void Mod::logResourceUsage() const
+{
+	std::vector<ResourceUsage> byType, byMod;
+	getResourceUsage(byType, byMod);
+	size_t total = 0;
+	for (const auto& usage : byType)
+	{
+		total += usage.bytes;
+	}
+	Log(LOG_INFO) << "Loaded resources take " << total / 1024 << " KB:";
+	for (const auto& usage : byType)
+	{
+		Log(LOG_INFO) << "- " << usage.name << ": " << usage.count << ", " << usage.bytes / 1024 << " KB";
+	}
+	for (const auto& usage : byMod)
+	{
+		Log(LOG_INFO) << "- mod '" << usage.name << "': " << usage.count << ", " << usage.bytes / 1024 << " KB";
+	}
+}
+
+/**
+ * Frees the least recently used surfaces that were lazily loaded
+ * only from mod images, while the loaded images take more than
+ * the oxceResourceBudget option (in MB, 0 = no limit). Only the ones
+ * requested through getStateSurface() and nothing else are freed,
+ * and only when the game replaces all its states, so none of the
+ * states holding on to them are left. The ones asked for since the
+ * previous time are kept, the new state may already be using them.
+ * They're loaded again from disk when needed.
+ */
+void Mod::trimSurfaces()
+{
+	unsigned current = _stateChanges++;
+	if (Options::oxceResourceBudget <= 0 || _lazySurfaceUse.empty())
+	{
+		return;
+	}
+
+	size_t budget = (size_t)Options::oxceResourceBudget * 1024 * 1024;
+	size_t total = 0;
+	for (const auto& pair : _surfaces)
+	{
+		total += getSurfaceBytes(pair.second);
+	}
+	for (const auto& pair : _sets)
+	{
+		total += getSurfaceSetBytes(pair.second);
+	}
+	if (total <= budget)
+	{
+		return;
+	}
+
+	std::vector<std::pair<unsigned, std::string> > unused;
+	for (const auto& pair : _lazySurfaceUse)
+	{
+		if (pair.second < current)
+		{
+			unused.push_back(std::make_pair(pair.second, pair.first));
+		}
+	}
+	std::sort(unused.begin(), unused.end());
+
+	size_t freed = 0;
+	int count = 0;
+	for (const auto& pair : unused)
+	{
+		if (total - freed <= budget)
+		{
+			break;
+		}
+		const std::string &name = pair.second;
+		auto surface = _surfaces.find(name);
+		if (surface != _surfaces.end())
+		{
+			freed += getSurfaceBytes(surface->second);
+			delete surface->second;
+			_surfaces.erase(surface);
+		}
+		auto set = _sets.find(name);
+		if (set != _sets.end())
+		{
+			freed += getSurfaceSetBytes(set->second);
+			delete set->second;
+			_sets.erase(set);
+		}
+		for (auto* extraSprites : _extraSprites[name])
+		{
+			extraSprites->unload();
+		}
+		_lazySurfaceUse.erase(name);
+		count++;
+	}
+	Log(LOG_VERBOSE) << "Freed " << count << " surfaces (" << freed / 1024 << " KB) to stay within the resource budget";
+}
+
 /**
  * Returns a specific surface from the mod.
  * @param name Name of the surface.
@@ -803,10 +1110,34 @@ void Mod::lazyLoadSurface(const std::string &name)
  */
 Surface *Mod::getSurface(const std::string &name, bool error)
 {
-	lazyLoadSurface(name);
+	lazyLoadSurface(name, false);
+	return getRule(name, "Sprite", _surfaces, error);
+}
+
+/**
+ * Returns a specific surface from the mod, for a state that only
+ * keeps it as long as it exists, so it can be freed after the
+ * state is gone to stay within the resource budget.
+ * @param name Name of the surface.
+ * @return Pointer to the surface.
+ */
+Surface *Mod::getStateSurface(const std::string &name, bool error)
+{
+	lazyLoadSurface(name, true);
 	return getRule(name, "Sprite", _surfaces, error);
 }
 
+/**
+ * Checks if a surface exists in the mod, or will once it's
+ * lazily loaded, without loading it.
+ * @param name Name of the surface.
+ * @return True if getSurface() would find it.
+ */
+bool Mod::hasSurface(const std::string &name) const
+{
+	return _surfaces.find(name) != _surfaces.end() || _extraSprites.find(name) != _extraSprites.end();
+}
+
 /**
  * Returns a specific surface set from the mod.
  * @param name Name of the surface set.
@@ -814,7 +1145,7 @@ Surface *Mod::getSurface(const std::string &name, bool error)
  */
 SurfaceSet *Mod::getSurfaceSet(const std::string &name, bool error)
 {
-	lazyLoadSurface(name);
+	lazyLoadSurface(name, false);
 	return getRule(name, "Sprite Set", _sets, error);
 }
 
@@ -1993,6 +2324,7 @@ static void throwModOnErrorHelper(const std::string& modId, const std::string& e
  */
 void Mod::loadAll()
 {
+	PROFILE_SCOPE("Mod::loadAll");
 	ModScript parser{ _scriptGlobal, this };
 	const auto& mods = FileMap::getRulesets();
 
@@ -2293,6 +2625,9 @@ void Mod::loadAll()
 
 	sortLists();
 	modResources();
+	// anything loaded up to here may have been changed by modResources()
+	_trackLazySurfaces = true;
+	logResourceUsage();
 }
 
 /**
@@ -3668,7 +4003,7 @@ SavedGame *Mod::newSave(GameDifficulty diff) const
 			RuleSoldier* ruleSoldier = getSoldier(randomTypes[i], true);
 			int nationality = save->selectSoldierNationalityByLocation(this, ruleSoldier, nullptr); // -1 (unfortunately the first base is not placed yet)
 			Soldier *soldier = genSoldier(save, ruleSoldier, nationality);
-			base->getSoldiers()->push_back(soldier);
+			base->addSoldier(soldier);
 			// Award soldier a special 'original eight' commendation
 			if (_commendations.find("STR_MEDAL_ORIGINAL8_NAME") != _commendations.end())
 			{
@@ -5777,12 +6112,37 @@ void Mod::loadExtraResources()
 	if (!Options::lazyLoadResources)
 	{
 		Log(LOG_INFO) << "Loading extra resources from ruleset...";
+		// Sprites of the same type must be loaded in mod order, so mods are done
+		// one at a time, decoding all their images in parallel beforehand
+		std::map<const ModData*, std::vector<ExtraSprites*> > modSprites;
 		for (auto& pair : _extraSprites)
 		{
 			for (auto* extraSprites : pair.second)
 			{
-				loadExtraSprite(extraSprites);
+				modSprites[extraSprites->getModOwner()].push_back(extraSprites);
+			}
+		}
+		for (const auto& modData : _modData)
+		{
+			auto i = modSprites.find(&modData);
+			if (i == modSprites.end())
+				continue;
+
+			Uint64 start = Profiler::now();
+			std::vector<std::string> files;
+			for (auto* extraSprites : i->second)
+			{
+				extraSprites->getImageFiles(files);
 			}
+			PreloadedImages preloaded;
+			ExtraSprites::preloadImages(files, preloaded);
+			Uint64 decoded = Profiler::now();
+			for (auto* extraSprites : i->second)
+			{
+				loadExtraSprite(extraSprites, &preloaded);
+			}
+			Uint64 end = Profiler::now();
+			Log(LOG_INFO) << "Loaded " << files.size() << " images for mod '" << modData.name << "' in " << (end - start) / 1000 << "ms (" << (decoded - start) / 1000 << "ms decoding)";
 		}
 	}
 
@@ -5888,7 +6248,12 @@ void Mod::loadExtraResources()
 	Window::soundPopup[2] = getSound("GEO.CAT", Mod::WINDOW_POPUP[2]);
 }
 
-void Mod::loadExtraSprite(ExtraSprites *spritePack)
+/**
+ * Loads an external sprite into its surface or surface set.
+ * @param spritePack Sprite to load.
+ * @param preloaded Images decoded ahead of time, if any.
+ */
+void Mod::loadExtraSprite(ExtraSprites *spritePack, PreloadedImages *preloaded)
 {
 	if (spritePack->isLoaded())
 		return;
@@ -5902,7 +6267,7 @@ void Mod::loadExtraSprite(ExtraSprites *spritePack)
 			surface = i->second;
 		}
 
-		_surfaces[spritePack->getType()] = spritePack->loadSurface(surface);
+		_surfaces[spritePack->getType()] = spritePack->loadSurface(surface, preloaded);
 		if (_statePalette)
 		{
 			if (spritePack->getType().find("_CPAL") == std::string::npos)
@@ -5920,7 +6285,7 @@ void Mod::loadExtraSprite(ExtraSprites *spritePack)
 			set = i->second;
 		}
 
-		_sets[spritePack->getType()] = spritePack->loadSurfaceSet(set);
+		_sets[spritePack->getType()] = spritePack->loadSurfaceSet(set, preloaded);
 		if (_statePalette)
 		{
 			if (spritePack->getType().find("_CPAL") == std::string::npos)
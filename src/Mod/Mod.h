@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -34,6 +35,7 @@
 #include "RuleAlienMission.h"
 #include "RuleBaseFacilityFunctions.h"
 #include "RuleItem.h"
+#include "ExtraSprites.h"
 
 namespace OpenXcom
 {
@@ -82,6 +84,8 @@ class RuleAlienMission;
 class Base;
 class MCDPatch;
 class ExtraSprites;
+class ResourcePrefetcher;
+class TerrainCache;
 class ExtraSounds;
 class CustomPalettes;
 class ExtraStrings;
@@ -122,6 +126,17 @@ struct ModData
 	size_t size;
 };
 
+/**
+ * Memory taken by one kind of loaded resource,
+ * or by all the resources of one mod.
+ */
+struct ResourceUsage
+{
+	std::string name;
+	size_t count = 0;
+	size_t bytes = 0;
+};
+
 /**
  * Helper exception representing the final message with all the required context for the end user to fix the errors in rulesets
  */
@@ -307,6 +322,13 @@ private:
 	std::vector<ModData> _modData;
 	ModData* _modCurrent;
 	const SDL_Color *_statePalette;
+	ResourcePrefetcher *_prefetcher;
+	TerrainCache *_terrainCache;
+	PreloadedImages _prefetched;
+	std::map<std::string, unsigned> _lazySurfaceUse;
+	std::set<std::string> _pinnedSurfaces;
+	unsigned _stateChanges;
+	bool _trackLazySurfaces;
 
 	std::vector<std::string> _psiRequirements; // it's a cache for psiStrengthEval
 	std::vector<const Armor*> _armorsForSoldiersCache;
@@ -369,9 +391,9 @@ private:
 	/// Loads resources from extra rulesets.
 	void loadExtraResources();
 	/// Loads surfaces on demand.
-	void lazyLoadSurface(const std::string &name);
+	void lazyLoadSurface(const std::string &name, bool stateLocal);
 	/// Loads an external sprite.
-	void loadExtraSprite(ExtraSprites *spritePack);
+	void loadExtraSprite(ExtraSprites *spritePack, PreloadedImages *preloaded = 0);
 	/// Applies mods to vanilla resources.
 	void modResources();
 	/// Sorts all our lists according to their weight.
@@ -454,8 +476,20 @@ public:
 	Font *getFont(const std::string &name, bool error = true) const;
 	/// Gets a particular surface.
 	Surface *getSurface(const std::string &name, bool error = true);
+	/// Gets a particular surface that only the calling state holds on to.
+	Surface *getStateSurface(const std::string &name, bool error = true);
+	/// Checks if a surface exists, without loading it.
+	bool hasSurface(const std::string &name) const;
 	/// Gets a particular surface set.
 	SurfaceSet *getSurfaceSet(const std::string &name, bool error = true);
+	/// Starts loading surfaces and surface sets in the background.
+	void prefetchSurfaces(const std::vector<std::string> &names);
+	/// Gets the memory taken by the loaded resources.
+	void getResourceUsage(std::vector<ResourceUsage> &byType, std::vector<ResourceUsage> &byMod) const;
+	/// Logs the memory taken by the loaded resources.
+	void logResourceUsage() const;
+	/// Frees unused lazily loaded surfaces over the memory budget.
+	void trimSurfaces();
 	/// Gets a particular music.
 	Music *getMusic(const std::string &name, bool error = true) const;
 	/// Gets the available music tracks.
@@ -1023,6 +1057,8 @@ public:
 	int getStartingDifficulty() const { return _startingDifficulty; }
 	/// Gets an MCDPatch.
 	MCDPatch *getMCDPatch(const std::string &id) const;
+	/// Gets the terrain kept loaded between battles.
+	TerrainCache *getTerrainCache() const { return _terrainCache; }
 	/// Gets the list of external Sprites.
 	const std::map<std::string, std::vector<ExtraSprites *> > &getExtraSprites() const;
 	/// Gets the list of custom palettes.
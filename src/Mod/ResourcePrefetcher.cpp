@@ -0,0 +1,261 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ResourcePrefetcher.h"
+#include <algorithm>
+#include "../Engine/Logger.h"
+#include "../Engine/Parallel.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/Surface.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates a prefetcher with nothing to do.
+ * The workers are only started when needed.
+ */
+ResourcePrefetcher::ResourcePrefetcher() : _quit(false)
+{
+	_mutex = SDL_CreateMutex();
+	_queued = SDL_CreateCond();
+	_decoded = SDL_CreateCond();
+}
+
+/**
+ * Stops the workers, since they use the batches,
+ * and throws away the images nobody took.
+ */
+ResourcePrefetcher::~ResourcePrefetcher()
+{
+	SDL_LockMutex(_mutex);
+	_queue.clear();
+	_quit = true;
+	SDL_CondBroadcast(_queued);
+	SDL_UnlockMutex(_mutex);
+	for (auto* thread : _workers)
+	{
+		SDL_WaitThread(thread, 0);
+	}
+
+	PreloadedImages unused;
+	for (auto& batch : _batches)
+	{
+		for (auto& image : batch.images)
+		{
+			image.finish(unused);
+		}
+	}
+	SDL_DestroyCond(_decoded);
+	SDL_DestroyCond(_queued);
+	SDL_DestroyMutex(_mutex);
+}
+
+/**
+ * Takes images from the queue and decodes them, in the
+ * order they were requested, until the prefetcher quits.
+ * Images the main thread already started on are skipped.
+ * @param data Pointer to the prefetcher.
+ * @return Always 0.
+ */
+int ResourcePrefetcher::work(void *data)
+{
+	ResourcePrefetcher *self = (ResourcePrefetcher*)data;
+	SDL_LockMutex(self->_mutex);
+	while (!self->_quit)
+	{
+		if (self->_queue.empty())
+		{
+			SDL_CondWait(self->_queued, self->_mutex);
+			continue;
+		}
+		Batch *batch = self->_queue.front().first;
+		size_t i = self->_queue.front().second;
+		self->_queue.pop_front();
+		if (batch->states[i] != IMAGE_QUEUED)
+		{
+			continue;
+		}
+		batch->states[i] = IMAGE_DECODING;
+		SDL_UnlockMutex(self->_mutex);
+
+		batch->images[i].decode();
+
+		SDL_LockMutex(self->_mutex);
+		batch->states[i] = IMAGE_DONE;
+		SDL_CondBroadcast(self->_decoded);
+	}
+	SDL_UnlockMutex(self->_mutex);
+	return 0;
+}
+
+/**
+ * Makes sure an image of a batch is decoded. If no worker
+ * got to it yet, it's decoded right here instead of waiting
+ * for the images queued before it.
+ * @param batch Batch of the image.
+ * @param i Index of the image.
+ */
+void ResourcePrefetcher::wait(Batch &batch, size_t i)
+{
+	SDL_LockMutex(_mutex);
+	if (batch.states[i] == IMAGE_QUEUED)
+	{
+		batch.states[i] = IMAGE_DECODING;
+		SDL_UnlockMutex(_mutex);
+
+		batch.images[i].decode();
+
+		SDL_LockMutex(_mutex);
+		batch.states[i] = IMAGE_DONE;
+	}
+	while (batch.states[i] != IMAGE_DONE)
+	{
+		SDL_CondWait(_decoded, _mutex);
+	}
+	SDL_UnlockMutex(_mutex);
+}
+
+/**
+ * Waits for a batch to be fully decoded, then stores
+ * the images nobody took yet and removes the batch.
+ * @param batch Batch to finish.
+ * @param images Map to store the images in.
+ */
+void ResourcePrefetcher::finish(std::list<Batch>::iterator batch, PreloadedImages &images)
+{
+	for (size_t i = 0; i < batch->images.size(); ++i)
+	{
+		wait(*batch, i);
+		batch->images[i].finish(images);
+	}
+	// the workers skip done images, but mustn't find the batch gone
+	SDL_LockMutex(_mutex);
+	Batch *removed = &*batch;
+	_queue.erase(std::remove_if(_queue.begin(), _queue.end(), [=](const std::pair<Batch*, size_t> &job) { return job.first == removed; }), _queue.end());
+	SDL_UnlockMutex(_mutex);
+	_batches.erase(batch);
+}
+
+/**
+ * Finds the image files of some resources and queues
+ * them to be read and decoded by the workers.
+ * @param resources Resource names with their image files.
+ */
+void ResourcePrefetcher::prefetch(const std::vector<std::pair<std::string, std::vector<std::string> > > &resources)
+{
+	_batches.emplace_back();
+	Batch &batch = _batches.back();
+	for (const auto& resource : resources)
+	{
+		size_t begin = batch.images.size();
+		for (const auto& file : resource.second)
+		{
+			PendingImage image;
+			if (image.locate(file))
+			{
+				batch.images.push_back(std::move(image));
+			}
+		}
+		batch.resources[resource.first] = std::make_pair(begin, batch.images.size());
+	}
+	batch.states.assign(batch.images.size(), IMAGE_QUEUED);
+
+	if (_workers.empty())
+	{
+		// the main thread keeps one core to itself
+		int threads = std::max(Parallel::getThreadCount() - 1, 1);
+		for (int t = 0; t < threads; ++t)
+		{
+			SDL_Thread *thread = SDL_CreateThread(work, this);
+			if (thread != 0)
+			{
+				_workers.push_back(thread);
+			}
+		}
+	}
+	if (!_workers.empty())
+	{
+		SDL_LockMutex(_mutex);
+		for (size_t i = 0; i < batch.images.size(); ++i)
+		{
+			_queue.push_back(std::make_pair(&batch, i));
+		}
+		SDL_CondBroadcast(_queued);
+		SDL_UnlockMutex(_mutex);
+	}
+	// with no workers, the images get decoded when they're taken
+	Log(LOG_VERBOSE) << "Prefetching " << batch.images.size() << " images for " << resources.size() << " resources";
+}
+
+/**
+ * Checks if a resource is waiting to be taken from a prefetch.
+ * @param name Resource name.
+ * @return True if it's in a batch.
+ */
+bool ResourcePrefetcher::isPending(const std::string &name) const
+{
+	for (const auto& batch : _batches)
+	{
+		if (batch.resources.find(name) != batch.resources.end())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Takes the decoded images of a resource, waiting only for
+ * those that aren't done yet. Batches are removed once all
+ * their resources have been taken.
+ * @param name Resource name.
+ * @param images Map to store the images in.
+ */
+void ResourcePrefetcher::take(const std::string &name, PreloadedImages &images)
+{
+	for (auto batch = _batches.begin(); batch != _batches.end(); ++batch)
+	{
+		auto resource = batch->resources.find(name);
+		if (resource == batch->resources.end())
+		{
+			continue;
+		}
+
+		Uint64 start = Profiler::now();
+		for (size_t i = resource->second.first; i < resource->second.second; ++i)
+		{
+			wait(*batch, i);
+			batch->images[i].finish(images);
+		}
+		Uint64 waited = Profiler::now() - start;
+		if (waited > 1000)
+		{
+			Log(LOG_VERBOSE) << "Waited " << waited / 1000 << "ms for prefetched " << name;
+		}
+
+		batch->resources.erase(resource);
+		if (batch->resources.empty())
+		{
+			finish(batch, images);
+		}
+		return;
+	}
+}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <deque>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
+#include "ExtraSprites.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Reads and decodes the images of lazily loaded resources on
+ * background threads before they're needed, so opening a screen
+ * doesn't stall on loading all its sprites at once.
+ * All the requests share one pool of worker threads, started with
+ * the first request. Files are only located on the main thread when
+ * the prefetch is requested, since the virtual file system isn't
+ * thread-safe, and read by the workers.
+ */
+class ResourcePrefetcher
+{
+private:
+	/// Progress of an image.
+	enum ImageState : Uint8 { IMAGE_QUEUED, IMAGE_DECODING, IMAGE_DONE };
+	/// Resources requested together.
+	struct Batch
+	{
+		std::vector<PendingImage> images;
+		std::vector<ImageState> states;
+		std::map<std::string, std::pair<size_t, size_t> > resources;
+	};
+	std::list<Batch> _batches;
+	std::deque<std::pair<Batch*, size_t> > _queue;
+	std::vector<SDL_Thread*> _workers;
+	SDL_mutex *_mutex;
+	SDL_cond *_queued, *_decoded;
+	bool _quit;
+
+	/// Decodes queued images until the prefetcher is destroyed.
+	static int work(void *data);
+	/// Makes sure an image is decoded, decoding it here if no worker started on it.
+	void wait(Batch &batch, size_t i);
+	/// Waits for a batch to finish and takes its remaining images.
+	void finish(std::list<Batch>::iterator batch, PreloadedImages &images);
+public:
+	/// Creates an idle prefetcher.
+	ResourcePrefetcher();
+	/// Stops the workers and throws away the prefetched images.
+	~ResourcePrefetcher();
+	/// Starts decoding the image files of some resources.
+	void prefetch(const std::vector<std::pair<std::string, std::vector<std::string> > > &resources);
+	/// Is a resource being prefetched?
+	bool isPending(const std::string &name) const;
+	/// Waits for the images of a resource and takes them.
+	void take(const std::string &name, PreloadedImages &images);
+};
+
+}
@@ -736,6 +736,8 @@ void RuleItem::load(const YAML::Node &node, Mod *mod, const ModScript& parsers)
  */
 void RuleItem::afterLoad(const Mod* mod)
 {
+	_nameId = StringId(_name);
+
 	mod->verifySpriteOffset(_type, _bigSprite, "BIGOBS.PCK");
 	mod->verifySpriteOffset(_type, _floorSprite, "FLOOROB.PCK");
 	mod->verifySpriteOffset(_type, _handSprite, "HANDOB.PCK");
@@ -26,6 +26,7 @@
 #include "ModScript.h"
 #include "RuleResearch.h"
 #include "RuleBaseFacilityFunctions.h"
+#include "../Engine/StringId.h"
 
 namespace OpenXcom
 {
@@ -318,6 +319,7 @@ public:
 
 private:
 	std::string _type, _name, _nameAsAmmo; // two types of objects can have the same name
+	StringId _nameId;
 	std::string _requiresBuyCountry;
 	std::vector<std::string> _requiresName;
 	std::vector<std::string> _requiresBuyName;
@@ -463,6 +465,8 @@ public:
 	const std::string &getType() const;
 	/// Gets the item's name.
 	const std::string &getName() const;
+	/// Gets the item's name as an interned string ID.
+	StringId getNameId() const { return _nameId; }
 	/// Gets the item's name when loaded in weapon.
 	const std::string &getNameAsAmmo() const;
 	/// Gets the item's requirements.
@@ -0,0 +1,328 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TerrainCache.h"
+#include <iterator>
+#include <unordered_set>
+#include "Mod.h"
+#include "MapData.h"
+#include "MapDataSet.h"
+#include "../Engine/Exception.h"
+#include "../Engine/FileMap.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/Parallel.h"
+#include "../Engine/SurfaceSet.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty terrain cache.
+ * @param mod Pointer to the mod the terrain comes from.
+ */
+TerrainCache::TerrainCache(Mod *mod) : _mod(mod), _blockSize(0)
+{
+}
+
+/**
+ * The datasets belong to the mod, so they're left alone.
+ */
+TerrainCache::~TerrainCache()
+{
+}
+
+/**
+ * Gets the memory budget of the cache.
+ * @return Size in bytes.
+ */
+size_t TerrainCache::getBudget()
+{
+	return (size_t)std::max(Options::oxceTerrainCacheSize, 0) * 1024 * 1024;
+}
+
+/**
+ * Gets roughly how much memory a loaded terrain dataset uses,
+ * counting its tile objects and sprites.
+ * @param set Pointer to the dataset.
+ * @return Size in bytes.
+ */
+size_t TerrainCache::getDataSetSize(MapDataSet *set)
+{
+	size_t size = set->getSize() * sizeof(MapData);
+	if (set->getSurfaceset())
+	{
+		size += set->getSurfaceset()->getTotalFrames() * 32 * 40;
+	}
+	return size;
+}
+
+/**
+ * Gets how much memory a decoded map block file uses.
+ * @param block The file contents.
+ * @return Size in bytes.
+ */
+size_t TerrainCache::getBlockSize(const MapBlockFile &block)
+{
+	return block.tiles.size() + block.routes.size() * sizeof(RouteNode);
+}
+
+/**
+ * Gets how much memory the cached terrain uses, not counting
+ * the datasets of a battle in progress.
+ * @return Size in bytes.
+ */
+size_t TerrainCache::getSize() const
+{
+	size_t size = _blockSize;
+	for (auto* set : _dataSets)
+	{
+		size += getDataSetSize(set);
+	}
+	return size;
+}
+
+/**
+ * Unloads the least recently used datasets and then forgets
+ * the least recently used map block files until the cache fits.
+ * The last file read is always kept, it's about to be used.
+ */
+void TerrainCache::trim()
+{
+	size_t budget = getBudget();
+	size_t size = getSize();
+	while (size > budget && !_dataSets.empty())
+	{
+		MapDataSet *set = _dataSets.back();
+		size -= getDataSetSize(set);
+		set->unloadData();
+		_dataSetIndex.erase(set);
+		_dataSets.pop_back();
+	}
+	while (size > budget && _blocks.size() > 1)
+	{
+		size_t blockSize = getBlockSize(_blocks.back().second);
+		size -= blockSize;
+		_blockSize -= blockSize;
+		_blockIndex.erase(_blocks.back().first);
+		_blocks.pop_back();
+	}
+}
+
+/**
+ * Loads a terrain dataset for a battle. If it's still loaded from
+ * an earlier battle it's taken out of the cache, so it can't be
+ * unloaded while in use.
+ * @param set Pointer to the dataset.
+ */
+void TerrainCache::load(MapDataSet *set)
+{
+	auto i = _dataSetIndex.find(set);
+	if (i != _dataSetIndex.end())
+	{
+		_dataSets.erase(i->second);
+		_dataSetIndex.erase(i);
+	}
+	set->loadData(_mod->getMCDPatch(set->getName()));
+}
+
+/**
+ * Lets go of a terrain dataset when the battle using it is over.
+ * It stays loaded for the next battle if the budget allows.
+ * @param set Pointer to the dataset.
+ */
+void TerrainCache::release(MapDataSet *set)
+{
+	if (getBudget() == 0)
+	{
+		set->unloadData();
+		return;
+	}
+	if (_dataSetIndex.find(set) == _dataSetIndex.end())
+	{
+		_dataSets.push_front(set);
+		_dataSetIndex[set] = _dataSets.begin();
+	}
+	trim();
+}
+
+/**
+ * Decodes a MAP or RMP file, telling them apart by the extension.
+ * A partial record at the end is ignored, like it always was.
+ * @param filename Path of the file.
+ * @param data The raw file contents.
+ * @param block Decoded contents.
+ * @return False if the file is invalid.
+ */
+bool TerrainCache::decode(const std::string &filename, const std::string &data, MapBlockFile &block)
+{
+	const Uint8 *bytes = (const Uint8*)data.data();
+	if (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".RMP") == 0)
+	{
+		const size_t RECORD_SIZE = 24;
+		block.routes.resize(data.size() / RECORD_SIZE);
+		for (size_t i = 0; i < block.routes.size(); ++i)
+		{
+			const Uint8 *value = bytes + i * RECORD_SIZE;
+			RouteNode &node = block.routes[i];
+			node.x = value[1];
+			node.y = value[0];
+			node.z = value[2];
+			for (int j = 0; j < 5; ++j)
+			{
+				node.links[j] = value[4 + j * 3];
+			}
+			node.type = value[19];
+			node.rank = value[20];
+			node.flags = value[21];
+			node.reserved = value[22];
+			node.priority = value[23];
+		}
+		return true;
+	}
+
+	if (data.size() < 3)
+	{
+		return false;
+	}
+	block.sizeY = (int)data[0];
+	block.sizeX = (int)data[1];
+	block.sizeZ = (int)data[2];
+	size_t records = (data.size() - 3) / 4;
+	block.tiles.assign(bytes + 3, bytes + 3 + records * 4);
+	return true;
+}
+
+/**
+ * Reads a whole file from the virtual file system.
+ * @param filename Path of the file.
+ * @return The raw file contents.
+ */
+std::string TerrainCache::read(const std::string &filename)
+{
+	auto file = FileMap::getIStream(filename);
+	return std::string((std::istreambuf_iterator<char>(*file)), std::istreambuf_iterator<char>());
+}
+
+/**
+ * Adds a decoded file to the front of the cache.
+ * @param filename Path of the file.
+ * @param block Decoded contents.
+ */
+void TerrainCache::add(const std::string &filename, MapBlockFile &&block)
+{
+	_blockSize += getBlockSize(block);
+	_blocks.emplace_front(filename, std::move(block));
+	_blockIndex[filename] = _blocks.begin();
+}
+
+/**
+ * Gets MAP and RMP files that are about to be used ready all at once.
+ * Reading them has to be done one at a time, since the virtual file
+ * system isn't thread-safe, but they're decoded on several threads.
+ * They're kept apart from the cache until getBlockFile() asks for
+ * them, so the budget can't throw them out before they're used.
+ * Files that are missing or invalid are skipped here, so the
+ * error comes up only if the block actually gets used.
+ * @param filenames Paths of the files.
+ */
+void TerrainCache::decodeAhead(const std::vector<std::string> &filenames)
+{
+	std::vector<std::pair<std::string, std::string> > files;
+	std::unordered_set<std::string> seen;
+	for (const auto& filename : filenames)
+	{
+		if (_blockIndex.find(filename) == _blockIndex.end() && _decoded.find(filename) == _decoded.end() &&
+			seen.insert(filename).second && FileMap::fileExists(filename))
+		{
+			files.emplace_back(filename, read(filename));
+		}
+	}
+
+	std::vector<MapBlockFile> blocks(files.size());
+	std::vector<char> valid(files.size());
+	Parallel::forEach(files.size(), [&](size_t i)
+	{
+		valid[i] = decode(files[i].first, files[i].second, blocks[i]);
+	});
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		if (valid[i])
+		{
+			_decoded[files[i].first] = std::move(blocks[i]);
+		}
+	}
+}
+
+/**
+ * Forgets the files decoded ahead of time that
+ * didn't get used, once the map is generated.
+ */
+void TerrainCache::forgetDecoded()
+{
+	_decoded.clear();
+}
+
+/**
+ * Gets the contents of a MAP or RMP file, reading it
+ * if it isn't in the cache or decoded ahead already.
+ * @param filename Path of the file.
+ * @return The map block size and tile records, or the nodes.
+ */
+const TerrainCache::MapBlockFile &TerrainCache::getBlockFile(const std::string &filename)
+{
+	auto i = _blockIndex.find(filename);
+	if (i != _blockIndex.end())
+	{
+		_blocks.splice(_blocks.begin(), _blocks, i->second);
+		return i->second->second;
+	}
+
+	auto decoded = _decoded.find(filename);
+	if (decoded != _decoded.end())
+	{
+		add(filename, std::move(decoded->second));
+		_decoded.erase(decoded);
+	}
+	else
+	{
+		MapBlockFile block;
+		if (!decode(filename, read(filename), block))
+		{
+			throw Exception("Invalid MAP file: " + filename);
+		}
+		add(filename, std::move(block));
+	}
+	if (getBudget() == 0)
+	{
+		// nothing is kept, apart from the file about to be used
+		while (_blocks.size() > 1)
+		{
+			_blockSize -= getBlockSize(_blocks.back().second);
+			_blockIndex.erase(_blocks.back().first);
+			_blocks.pop_back();
+		}
+	}
+	else
+	{
+		trim();
+	}
+	return _blocks.front().second;
+}
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+class Mod;
+class MapDataSet;
+
+/**
+ * Keeps terrain loaded between battles, so generating the next
+ * mission doesn't have to read and decode the same MCD, PCK, MAP and
+ * RMP files again. Terrain datasets stay loaded after the battle using
+ * them ends, and map block files are kept decoded, both in least
+ * recently used order within a memory budget (the oxceTerrainCacheSize
+ * option, in MB; 0 turns the cache off).
+ */
+class TerrainCache
+{
+public:
+	/// A spawn or patrol node of an RMP file.
+	struct RouteNode
+	{
+		Uint8 x, y, z;
+		/// Linked node numbers, 251 and up are special values.
+		Uint8 links[5];
+		Uint8 type, rank, flags, reserved, priority;
+	};
+	/// The contents of a MAP or RMP file.
+	struct MapBlockFile
+	{
+		int sizeX = 0, sizeY = 0, sizeZ = 0;
+		/// MAP files: four bytes per tile, one for each tile part.
+		std::vector<Uint8> tiles;
+		/// RMP files: the nodes, in file order.
+		std::vector<RouteNode> routes;
+	};
+private:
+	typedef std::list<std::pair<std::string, MapBlockFile> > BlockList;
+
+	Mod *_mod;
+	std::list<MapDataSet*> _dataSets;
+	std::unordered_map<MapDataSet*, std::list<MapDataSet*>::iterator> _dataSetIndex;
+	BlockList _blocks;
+	std::unordered_map<std::string, BlockList::iterator> _blockIndex;
+	size_t _blockSize;
+	std::unordered_map<std::string, MapBlockFile> _decoded;
+
+	/// Gets the memory budget in bytes.
+	static size_t getBudget();
+	/// Gets roughly how much memory a loaded terrain dataset uses.
+	static size_t getDataSetSize(MapDataSet *set);
+	/// Gets how much memory a decoded map block file uses.
+	static size_t getBlockSize(const MapBlockFile &block);
+	/// Decodes a MAP or RMP file.
+	static bool decode(const std::string &filename, const std::string &data, MapBlockFile &block);
+	/// Reads a whole file.
+	static std::string read(const std::string &filename);
+	/// Adds a decoded file as the most recently used one.
+	void add(const std::string &filename, MapBlockFile &&block);
+	/// Unloads datasets and forgets map block files until the cache fits its budget.
+	void trim();
+public:
+	/// Creates an empty terrain cache.
+	TerrainCache(Mod *mod);
+	/// Cleans up the terrain cache.
+	~TerrainCache();
+	/// Loads a terrain dataset for a battle.
+	void load(MapDataSet *set);
+	/// Lets go of a terrain dataset once a battle is over.
+	void release(MapDataSet *set);
+	/// Reads and decodes several MAP and RMP files at once, ahead of their use.
+	void decodeAhead(const std::vector<std::string> &filenames);
+	/// Forgets the files decoded ahead that didn't get used.
+	void forgetDecoded();
+	/// Gets the contents of a MAP or RMP file.
+	const MapBlockFile &getBlockFile(const std::string &filename);
+	/// Gets how much memory the cache uses.
+	size_t getSize() const;
+};
+
+}
@@ -218,7 +218,7 @@ void AlienMission::think(Game &engine, const Globe &globe)
 	{
 		//Some missions may not spawn a UFO!
 		ufo->setMissionWaveNumber(_nextWave);
-		game.getUfos()->push_back(ufo);
+		game.addUfo(ufo);
 	}
 	else if ((mod.getDeployment(wave.ufoType) && !mod.getUfo(wave.ufoType) && !mod.getDeployment(wave.ufoType)->getMarkerName().empty()) // a mission site that we want to spawn directly
 			|| (_rule.getObjective() == OBJECTIVE_SITE && wave.objective)) // or we want to spawn one at random according to our terrain
@@ -1431,7 +1431,7 @@ MissionSite *AlienMission::spawnMissionSite(SavedGame &game, const Mod &mod, con
 		missionSite->setAlienRace(_race);
 		missionSite->setTexture(area.texture);
 		missionSite->setCity(area.name);
-		game.getMissionSites()->push_back(missionSite);
+		game.addMissionSite(missionSite);
 
 		if (Options::oxceGeoscapeDebugLogMaxEntries > 0)
 		{
@@ -54,7 +54,10 @@ namespace OpenXcom
  * Initializes an empty base.
  * @param mod Pointer to mod.
  */
-Base::Base(const Mod *mod) : Target(), _mod(mod), _scientists(0), _engineers(0), _inBattlescape(false),
+Base::Base(const Mod *mod) : Target(), _mod(mod),
+	_soldierIndex([](const Soldier *soldier) { return soldier->getId(); }),
+	_craftIndex([](const Craft *craft) { return craft->getUniqueId(); }),
+	_scientists(0), _engineers(0), _inBattlescape(false),
 	_retaliationTarget(false), _retaliationMission(nullptr), _fakeUnderwater(false)
 {
 	_items = new ItemContainer();
@@ -129,13 +132,14 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 		{
 			Craft *c = new Craft(_mod->getCraft(type), this);
 			c->load(*i, _mod->getScriptGlobal(), _mod, save);
-			_crafts.push_back(c);
+			addCraft(c);
 		}
 		else
 		{
 			Log(LOG_ERROR) << "Failed to load craft " << type;
 		}
 	}
+	updateActiveCrafts();
 
 	for (YAML::const_iterator i = node["soldiers"].begin(); i != node["soldiers"].end(); ++i)
 	{
@@ -147,17 +151,9 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 			s->setCraft(0);
 			if (const YAML::Node &craft = (*i)["craft"])
 			{
-				CraftId craftId = Craft::loadId(craft);
-				for (auto* xcraft : _crafts)
-				{
-					if (xcraft->getUniqueId() == craftId)
-					{
-						s->setCraft(xcraft);
-						break;
-					}
-				}
+				s->setCraft(findCraft(Craft::loadId(craft)));
 			}
-			_soldiers.push_back(s);
+			addSoldier(s);
 		}
 		else
 		{
@@ -423,6 +419,59 @@ std::vector<Soldier*> *Base::getSoldiers()
 	return &_soldiers;
 }
 
+/**
+ * Adds a soldier to the end of the base's list.
+ * @param soldier Pointer to soldier.
+ */
+void Base::addSoldier(Soldier *soldier)
+{
+	_soldiers.push_back(soldier);
+	_soldierIndex.add(soldier);
+}
+
+/**
+ * Removes a soldier from the base (does not destroy it!).
+ * @param soldierIt Position of the soldier in the base's list.
+ * @return Position of the next soldier.
+ */
+std::vector<Soldier*>::iterator Base::removeSoldier(std::vector<Soldier*>::iterator soldierIt)
+{
+	_soldierIndex.remove(*soldierIt, _soldiers);
+	return _soldiers.erase(soldierIt);
+}
+
+/**
+ * Finds a soldier in the base by their unique ID.
+ * @param id Soldier ID.
+ * @return Pointer to the soldier, or null if there's none.
+ */
+Soldier *Base::findSoldier(int id) const
+{
+	_soldierIndex.check(_soldiers);
+	return _soldierIndex.find(id);
+}
+
+/**
+ * Adds a craft to the end of the base's list.
+ * @param craft Pointer to craft.
+ */
+void Base::addCraft(Craft *craft)
+{
+	_crafts.push_back(craft);
+	_craftIndex.add(craft);
+}
+
+/**
+ * Finds a craft in the base by its unique ID.
+ * @param id Craft type and ID.
+ * @return Pointer to the craft, or null if there's none.
+ */
+Craft *Base::findCraft(const CraftId &id) const
+{
+	_craftIndex.check(_crafts);
+	return _craftIndex.find(id);
+}
+
 /**
  * Pre-calculates soldier stats with various bonuses.
  */
@@ -572,7 +621,7 @@ int Base::getAvailableSoldiers(bool checkCombatReadiness, bool includeWounded) c
 		{
 			total++;
 		}
-		else if (checkCombatReadiness && ((soldier->getCraft() != 0 && soldier->getCraft()->getStatus() != "STR_OUT") ||
+		else if (checkCombatReadiness && ((soldier->getCraft() != 0 && soldier->getCraft()->getStatus() != CS_OUT) ||
 			(soldier->getCraft() == 0 && (soldier->hasFullHealth() || (includeWounded && soldier->canDefendBase())))))
 		{
 			total++;
@@ -1142,7 +1191,7 @@ int Base::getCraftCountForProduction(const RuleCraft *craft) const
 	int total = 0;
 	for (const auto* xcraft : _crafts)
 	{
-		if (xcraft->getRules() == craft && xcraft->getStatus() != "STR_OUT")
+		if (xcraft->getRules() == craft && xcraft->getStatus() != CS_OUT)
 		{
 			total++;
 		}
@@ -1585,7 +1634,7 @@ void Base::setupDefenses(AlienMission* am)
 	// add vehicles that are in the crafts of the base, if it's not out
 	for (auto* xcraft : _crafts)
 	{
-		if (xcraft->getStatus() != "STR_OUT")
+		if (xcraft->getStatus() != CS_OUT)
 		{
 			for (auto* vehicle : *xcraft->getVehicles())
 			{
@@ -1885,7 +1934,12 @@ void Base::destroyFacility(BASEFACILITIESITERATOR facility)
 			Collections::deleteIf(_crafts, 1,
 				[&](Craft* c)
 				{
-					return c == (*facility)->getCraftForDrawing();
+					if (c == (*facility)->getCraftForDrawing())
+					{
+						_craftIndex.remove(c, _crafts);
+						return true;
+					}
+					return false;
 				}
 			);
 		}
@@ -2505,10 +2559,32 @@ std::vector<Craft*>::iterator Base::removeCraft(Craft *craft, bool unload)
 	{
 		if (*c == craft)
 		{
-			return _crafts.erase(c);
+			_craftIndex.remove(craft, _crafts);
+			c = _crafts.erase(c);
+			updateActiveCrafts();
+			return c;
 		}
 	}
 	return c;
 }
 
+/**
+ * Updates the list of the base's crafts that are out on
+ * missions, so the geoscape doesn't have to go through all the
+ * crafts of all the bases to find them. Called whenever a craft
+ * changes status or is added or removed, keeping the order of
+ * the crafts in the base.
+ */
+void Base::updateActiveCrafts()
+{
+	_activeCrafts.clear();
+	for (auto* craft : _crafts)
+	{
+		if (craft->getStatus() == CS_OUT)
+		{
+			_activeCrafts.push_back(craft);
+		}
+	}
+}
+
 }
@@ -23,6 +23,7 @@
 #include <map>
 #include <yaml-cpp/yaml.h>
 #include "../Mod/RuleBaseFacilityFunctions.h"
+#include "IdIndex.h"
 
 #ifndef BASEFACILITIESITERATOR
 #define BASEFACILITIESITERATOR std::vector<BaseFacility*>::iterator
@@ -95,7 +96,9 @@ private:
 	const Mod *_mod;
 	std::vector<BaseFacility*> _facilities;
 	std::vector<Soldier*> _soldiers;
-	std::vector<Craft*> _crafts;
+	std::vector<Craft*> _crafts, _activeCrafts;
+	IdIndex<int, Soldier> _soldierIndex;
+	IdIndex<std::pair<std::string, int>, Craft, TypeIdHash> _craftIndex;
 	std::vector<Transfer*> _transfers;
 	ItemContainer *_items;
 	int _scientists, _engineers;
@@ -134,12 +137,26 @@ public:
 	std::vector<BaseFacility*> *getFacilities();
 	/// Gets the base's soldiers.
 	std::vector<Soldier*> *getSoldiers();
+	/// Adds a soldier to the base.
+	void addSoldier(Soldier *soldier);
+	/// Removes a soldier from the base.
+	std::vector<Soldier*>::iterator removeSoldier(std::vector<Soldier*>::iterator soldierIt);
+	/// Finds a soldier in the base by ID.
+	Soldier *findSoldier(int id) const;
 	/// Pre-calculates soldier stats with various bonuses.
 	void prepareSoldierStatsWithBonuses();
 	/// Gets the base's crafts.
 	std::vector<Craft*> *getCrafts() {	return &_crafts; }
 	/// Gets the base's crafts.
 	const std::vector<Craft*> *getCrafts() const { return &_crafts; }
+	/// Adds a craft to the base.
+	void addCraft(Craft *craft);
+	/// Finds a craft in the base by ID.
+	Craft *findCraft(const std::pair<std::string, int> &id) const;
+	/// Gets the base's crafts that are out on missions.
+	const std::vector<Craft*> &getActiveCrafts() const { return _activeCrafts; }
+	/// Updates the list of crafts out on missions.
+	void updateActiveCrafts();
 	/// Gets the base's transfers.
 	std::vector<Transfer*> *getTransfers() { return &_transfers; }
 	/// Gets the base's transfers.
@@ -0,0 +1,125 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/**
+ * Keeps objects that live no longer than a battle in blocks
+ * of memory, instead of allocating each one from the heap.
+ * A destroyed object leaves its slot to the next one created,
+ * and the blocks are only freed along with the pool, so setting
+ * up and tearing down a battle takes a handful of heap calls.
+ * Objects created here must be destroyed here, never deleted.
+ */
+template<typename T>
+class BattleObjectPool
+{
+private:
+	/// Number of objects in each block.
+	static const size_t BLOCK_SIZE = 256;
+	union Slot
+	{
+		Slot *next;
+		alignas(T) unsigned char object[sizeof(T)];
+	};
+	std::vector<Slot*> _blocks;
+	Slot *_free;
+	size_t _created;
+
+	/// Adds a block of free slots.
+	void addBlock()
+	{
+		Slot *block = new Slot[BLOCK_SIZE];
+		_blocks.push_back(block);
+		for (size_t i = BLOCK_SIZE; i > 0; --i)
+		{
+			block[i - 1].next = _free;
+			_free = &block[i - 1];
+		}
+	}
+public:
+	/// Creates an empty pool.
+	BattleObjectPool() : _free(0), _created(0)
+	{
+	}
+	/// Frees all the blocks, every object must be destroyed by now.
+	~BattleObjectPool()
+	{
+		for (auto* block : _blocks)
+		{
+			delete[] block;
+		}
+	}
+	BattleObjectPool(const BattleObjectPool&) = delete;
+	BattleObjectPool& operator=(const BattleObjectPool&) = delete;
+
+	/**
+	 * Creates a new object in a free slot.
+	 * @param args Arguments for the object's constructor.
+	 * @return Pointer to the new object.
+	 */
+	template<typename... Args>
+	T *create(Args&&... args)
+	{
+		if (!_free)
+		{
+			addBlock();
+		}
+		Slot *slot = _free;
+		_free = slot->next;
+		try
+		{
+			T *obj = new (slot->object) T(std::forward<Args>(args)...);
+			_created++;
+			return obj;
+		}
+		catch (...)
+		{
+			slot->next = _free;
+			_free = slot;
+			throw;
+		}
+	}
+	/**
+	 * Destroys an object and frees up its slot.
+	 * @param obj Pointer to an object created by this pool, or null.
+	 */
+	void destroy(T *obj)
+	{
+		if (obj)
+		{
+			obj->~T();
+			Slot *slot = reinterpret_cast<Slot*>(obj);
+			slot->next = _free;
+			_free = slot;
+		}
+	}
+	/// Gets the number of objects created so far.
+	size_t getCreated() const { return _created; }
+	/// Gets the number of blocks taken from the heap.
+	size_t getBlocks() const { return _blocks.size(); }
+};
+
+}
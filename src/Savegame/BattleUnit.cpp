@@ -45,8 +45,10 @@
 #include "../Mod/RuleStartingCondition.h"
 #include "Soldier.h"
 #include "Tile.h"
+#include "UnitVisibility.h"
 #include "SavedGame.h"
 #include "SavedBattleGame.h"
+#include "UnitGrid.h"
 #include "../Engine/ShaderDraw.h"
 #include "BattleUnitStatistics.h"
 #include "../fmath.h"
@@ -2295,25 +2297,13 @@ void BattleUnit::resetTimeUnitsAndEnergy()
  */
 bool BattleUnit::addToVisibleUnits(BattleUnit *unit)
 {
-	bool add = true;
-	for (auto* bu : _unitsSpottedThisTurn)
-	{
-		if (bu == unit)
-		{
-			add = false;
-			break;
-		}
-	}
-	if (add)
+	if (UnitVisibility::set(_visibility->spotted, unit->_visibilityIndex))
 	{
 		_unitsSpottedThisTurn.push_back(unit);
 	}
-	for (auto* bu : _visibleUnits)
+	if (!UnitVisibility::set(_visibility->units, unit->_visibilityIndex))
 	{
-		if (bu == unit)
-		{
-			return false;
-		}
+		return false;
 	}
 	_visibleUnits.push_back(unit);
 	return true;
@@ -2326,7 +2316,8 @@ bool BattleUnit::addToVisibleUnits(BattleUnit *unit)
 */
 bool BattleUnit::removeFromVisibleUnits(BattleUnit *unit)
 {
-	if (!_visibleUnits.size()) {
+	if (!UnitVisibility::reset(_visibility->units, unit->_visibilityIndex))
+	{
 		return false;
 	}
 	auto i = std::find(_visibleUnits.begin(), _visibleUnits.end(), unit);
@@ -2352,7 +2343,38 @@ bool BattleUnit::hasVisibleUnit(const BattleUnit *unit) const
 		//Units of same faction are always visible, but not stored in the visible unit list
 		return true;
 	}
-	return std::find(_visibleUnits.begin(), _visibleUnits.end(), unit) != _visibleUnits.end();
+	return isOnVisibleUnits(unit);
+}
+
+/**
+ * Checks if the given unit is on the list of visible units,
+ * unlike hasVisibleUnit() units of the same faction aren't.
+ * @param unit The unit to check.
+ * @return true if on the visible list.
+ */
+bool BattleUnit::isOnVisibleUnits(const BattleUnit *unit) const
+{
+	return UnitVisibility::test(_visibility->units, unit->_visibilityIndex);
+}
+
+/**
+ * Checks if the given unit was spotted by this unit this turn,
+ * even if it's not in view anymore.
+ * @param unit The unit to check.
+ * @return true if on the list of units spotted this turn.
+ */
+bool BattleUnit::hasSpottedUnit(const BattleUnit *unit) const
+{
+	return UnitVisibility::test(_visibility->spotted, unit->_visibilityIndex);
+}
+
+/**
+ * Counts the units on the list of visible units.
+ * @return Number of visible units.
+ */
+size_t BattleUnit::getVisibleUnitsCount() const
+{
+	return UnitVisibility::count(_visibility->units);
 }
 
 /**
@@ -2369,6 +2391,7 @@ std::vector<BattleUnit*> *BattleUnit::getVisibleUnits()
  */
 void BattleUnit::clearVisibleUnits()
 {
+	UnitVisibility::clear(_visibility->units);
 	_visibleUnits.clear();
 }
 
@@ -2380,7 +2403,7 @@ void BattleUnit::clearVisibleUnits()
 bool BattleUnit::addToVisibleTiles(Tile *tile)
 {
 	//Only add once, otherwise we're going to mess up the visibility value and make trouble for the AI (if sneaky).
-	if (_visibleTilesLookup.insert(tile).second)
+	if (UnitVisibility::set(_visibility->tiles, tile->getSavedGame()->getTileIndex(tile->getPosition())))
 	{
 		tile->setVisible(1);
 		_visibleTiles.push_back(tile);
@@ -2389,6 +2412,16 @@ bool BattleUnit::addToVisibleTiles(Tile *tile)
 	return false;
 }
 
+/**
+ * Checks if this unit has marked the tile as within its view.
+ * @param tile The tile to check.
+ * @return true if the tile is on the list of visible tiles.
+ */
+bool BattleUnit::hasVisibleTile(const Tile *tile) const
+{
+	return UnitVisibility::test(_visibility->tiles, tile->getSavedGame()->getTileIndex(tile->getPosition()));
+}
+
 /**
  * Get the pointer to the vector of visible tiles.
  * @return pointer to vector.
@@ -2406,8 +2439,8 @@ void BattleUnit::clearVisibleTiles()
 	for (auto* tile : _visibleTiles)
 	{
 		tile->setVisible(-1);
+		UnitVisibility::reset(_visibility->tiles, tile->getSavedGame()->getTileIndex(tile->getPosition()));
 	}
-	_visibleTilesLookup.clear();
 	_visibleTiles.clear();
 }
 
@@ -2731,6 +2764,7 @@ void BattleUnit::prepareNewTurn(bool fullProcess)
 	}
 
 	_isSurrendering = false;
+	UnitVisibility::clear(_visibility->spotted);
 	_unitsSpottedThisTurn.clear();
 	_meleeAttackedBy.clear();
 
@@ -3263,6 +3297,8 @@ void BattleUnit::updateTileFloorState(SavedBattleGame *saveBattleGame)
  */
 void BattleUnit::setTile(Tile *tile, SavedBattleGame *saveBattleGame)
 {
+	// even if the tile is the same, it may have been set by setInventoryTile()
+	saveBattleGame->getUnitGrid()->update(this, tile);
 	if (_tile == tile)
 	{
 		return;
@@ -5851,9 +5887,7 @@ void getVisibleUnitsCountScript(BattleUnit *bu, int &ret)
 {
 	if (bu)
 	{
-
-		auto visibleUnits = bu->getVisibleUnits();
-		ret = visibleUnits->size();
+		ret = bu->getVisibleUnitsCount();
 	}
 }
 
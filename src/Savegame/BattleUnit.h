@@ -19,7 +19,6 @@
  */
 #include <vector>
 #include <string>
-#include <unordered_set>
 #include "../Battlescape/Position.h"
 #include "../Mod/Armor.h"
 #include "../Mod/RuleItem.h"
@@ -52,6 +51,7 @@ template<typename, typename...> class ScriptParser;
 class ScriptWorkerBlit;
 struct BattleUnitStatistics;
 struct StatAdjustment;
+struct UnitVisibility;
 
 /**
  * Placeholder class for future functionality.
@@ -91,7 +91,8 @@ private:
 	int _walkPhase, _fallPhase;
 	std::vector<BattleUnit *> _visibleUnits, _unitsSpottedThisTurn;
 	std::vector<Tile *> _visibleTiles;
-	std::unordered_set<Tile *> _visibleTilesLookup;
+	UnitVisibility *_visibility = nullptr;
+	size_t _visibilityIndex = 0;
 	int _tu, _energy, _health, _morale, _stunlevel, _mana;
 	bool _kneeled, _floating, _dontReselect;
 	bool _haveNoFloorBelow = false;
@@ -348,6 +349,12 @@ public:
 	bool removeFromVisibleUnits(BattleUnit *unit);
 	/// Is the given unit among this unit's visible units?
 	bool hasVisibleUnit(const BattleUnit *unit) const;
+	/// Is the given unit on the list of visible units?
+	bool isOnVisibleUnits(const BattleUnit *unit) const;
+	/// Has the given unit been spotted by this unit this turn?
+	bool hasSpottedUnit(const BattleUnit *unit) const;
+	/// Gets the number of visible units.
+	size_t getVisibleUnitsCount() const;
 	/// Get the list of visible units.
 	std::vector<BattleUnit*> *getVisibleUnits();
 	/// Clear visible units.
@@ -355,14 +362,15 @@ public:
 	/// Add unit to visible tiles.
 	bool addToVisibleTiles(Tile *tile);
 	/// Has this unit marked this tile as within its view?
-	bool hasVisibleTile(Tile *tile) const
-	{
-		return _visibleTilesLookup.find(tile) != _visibleTilesLookup.end(); //find?
-	}
+	bool hasVisibleTile(const Tile *tile) const;
 	/// Get the list of visible tiles.
 	const std::vector<Tile*> *getVisibleTiles();
 	/// Clear visible tiles.
 	void clearVisibleTiles();
+	/// Sets where the battle keeps what this unit can see.
+	void setVisibility(UnitVisibility *visibility, size_t index) { _visibility = visibility; _visibilityIndex = index; }
+	/// Gets the index of this unit in the visibility bits of other units.
+	size_t getVisibilityIndex() const { return _visibilityIndex; }
 	/// Calculate psi attack accuracy.
 	static int getPsiAccuracy(BattleActionAttack::ReadOnly attack);
 	/// Calculate firing accuracy.
@@ -78,6 +78,14 @@ namespace YAML
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Status strings, in the same order as CraftStatus.
+const char *const CRAFT_STATUS_STRINGS[] = { "STR_READY", "STR_OUT", "STR_REPAIRS", "STR_REFUELLING", "STR_REARMING" };
+
+}
+
 /**
  * Initializes a craft of the specified type and
  * assigns it the latest craft ID available.
@@ -88,7 +96,7 @@ namespace OpenXcom
 Craft::Craft(const RuleCraft *rules, Base *base, int id) : MovingTarget(),
 	_rules(rules), _base(base), _fuel(0), _damage(0), _shield(0),
 	_interceptionOrder(0), _takeoff(0), _weapons(),
-	_status("STR_READY"), _lowFuel(false), _mission(false),
+	_status(CS_READY), _lowFuel(false), _mission(false),
 	_inBattlescape(false), _inDogfight(false), _stats(),
 	_isAutoPatrolling(false), _lonAuto(0.0), _latAuto(0.0),
 	_skinIndex(0)
@@ -213,7 +221,17 @@ void Craft::load(const YAML::Node &node, const ScriptGlobal *shared, const Mod *
 			Log(LOG_ERROR) << "Failed to load vehicles item " << type;
 		}
 	}
-	_status = node["status"].as<std::string>(_status);
+	if (const YAML::Node &status = node["status"])
+	{
+		std::string statusString = status.as<std::string>();
+		for (int i = CS_READY; i <= CS_REARMING; ++i)
+		{
+			if (statusString == CRAFT_STATUS_STRINGS[i])
+			{
+				_status = (CraftStatus)i;
+			}
+		}
+	}
 	_lowFuel = node["lowFuel"].as<bool>(_lowFuel);
 	_mission = node["mission"].as<bool>(_mission);
 	_interceptionOrder = node["interceptionOrder"].as<int>(_interceptionOrder);
@@ -253,14 +271,10 @@ void Craft::load(const YAML::Node &node, const ScriptGlobal *shared, const Mod *
 			if (type == "STR_ALIEN_TERROR")
 				type = "STR_TERROR_SITE";
 			bool found = false;
-			for (auto* ms : *save->getMissionSites())
+			if (MissionSite *ms = save->getMissionSite(type, id))
 			{
-				if (found) break; // loop finished
-				if (ms->getId() == id && ms->getDeployment()->getMarkerName() == type)
-				{
-					setDestination(ms);
-					found = true;
-				}
+				setDestination(ms);
+				found = true;
 			}
 			for (auto* ab : *save->getAlienBases())
 			{
@@ -312,19 +326,10 @@ void Craft::finishLoading(const YAML::Node &node, SavedGame *save)
 		std::string type = dest["type"].as<std::string>();
 		int id = dest["id"].as<int>();
 
-		bool found = false;
-		for (auto* xbase : *save->getBases())
+		Craft *escortee = save->getCraft(CraftId(type, id));
+		if (escortee)
 		{
-			if (found) break; // loop finished
-			for (auto* xcraft : *xbase->getCrafts())
-			{
-				if (found) break; // loop finished
-				if (xcraft->getId() == id && xcraft->getRules()->getType() == type)
-				{
-					setDestination(xcraft);
-					found = true;
-				}
-			}
+			setDestination(escortee);
 		}
 	}
 }
@@ -375,7 +380,7 @@ YAML::Node Craft::save(const ScriptGlobal *shared) const
 	{
 		node["vehicles"].push_back(vehicle->save());
 	}
-	node["status"] = _status;
+	node["status"] = getStatusString();
 	if (_lowFuel)
 		node["lowFuel"] = _lowFuel;
 	if (_mission)
@@ -471,7 +476,7 @@ std::string Craft::getDefaultName(Language *lang) const
  */
 int Craft::getMarker() const
 {
-	if (_status != "STR_OUT")
+	if (_status != CS_OUT)
 		return -1;
 	else if (_rules->getMarker() == -1)
 		return 1;
@@ -494,7 +499,16 @@ Base *Craft::getBase() const
  */
 void Craft::setBase(Base *base, bool move)
 {
+	Base *oldBase = _base;
 	_base = base;
+	if (oldBase && oldBase != base)
+	{
+		oldBase->updateActiveCrafts();
+	}
+	if (base)
+	{
+		base->updateActiveCrafts();
+	}
 	if (move)
 	{
 		_lon = base->getLongitude();
@@ -503,21 +517,30 @@ void Craft::setBase(Base *base, bool move)
 }
 
 /**
- * Returns the current status of the craft.
+ * Returns the string the current status of the craft
+ * is saved and translated with.
  * @return Status string.
  */
-std::string Craft::getStatus() const
+const char *Craft::getStatusString() const
 {
-	return _status;
+	return CRAFT_STATUS_STRINGS[_status];
 }
 
 /**
- * Changes the current status of the craft.
- * @param status Status string.
+ * Changes the current status of the craft,
+ * keeping the base's list of crafts out on missions up to date.
+ * @param status Status.
  */
-void Craft::setStatus(const std::string &status)
+void Craft::setStatus(CraftStatus status)
 {
-	_status = status;
+	if (_status != status)
+	{
+		_status = status;
+		if (_base)
+		{
+			_base->updateActiveCrafts();
+		}
+	}
 }
 
 /**
@@ -544,7 +567,7 @@ std::string Craft::getAltitude() const
  */
 void Craft::setDestination(Target *dest)
 {
-	if (_status != "STR_OUT")
+	if (_status != CS_OUT)
 	{
 		_takeoff = 60;
 	}
@@ -1064,7 +1087,7 @@ void Craft::evacuateCrew(const Mod *mod)
 				t->setSoldier(soldier);
 				_base->getTransfers()->push_back(t);
 				// next
-				iter = _base->getSoldiers()->erase(iter);
+				iter = _base->removeSoldier(iter);
 			}
 			else
 			{
@@ -1139,19 +1162,19 @@ void Craft::checkup()
 
 	if (_damage > 0)
 	{
-		_status = "STR_REPAIRS";
+		setStatus(CS_REPAIRS);
 	}
 	else if (available != full)
 	{
-		_status = "STR_REARMING";
+		setStatus(CS_REARMING);
 	}
 	else if (_fuel < _stats.fuelMax)
 	{
-		_status = "STR_REFUELLING";
+		setStatus(CS_REFUELLING);
 	}
 	else
 	{
-		_status = "STR_READY";
+		setStatus(CS_READY);
 	}
 }
 
@@ -1271,7 +1294,7 @@ void Craft::repair()
 	setDamage(_damage - _rules->getRepairRate());
 	if (_damage <= 0)
 	{
-		_status = "STR_REARMING";
+		setStatus(CS_REARMING);
 	}
 }
 
@@ -1303,7 +1326,7 @@ std::string Craft::refuel()
 				fuel = item;
 				if (_fuel > 0)
 				{
-					_status = "STR_READY";
+					setStatus(CS_READY);
 				}
 				else
 				{
@@ -1314,12 +1337,12 @@ std::string Craft::refuel()
 	}
 	if (_fuel >= _stats.fuelMax)
 	{
-		_status = "STR_READY";
+		setStatus(CS_READY);
 		for (const auto* cw : _weapons)
 		{
 			if (cw && cw->isRearming())
 			{
-				_status = "STR_REARMING";
+				setStatus(CS_REARMING);
 				break;
 			}
 		}
@@ -1340,7 +1363,7 @@ const RuleItem* Craft::rearm()
 	{
 		if (iter == _weapons.end())
 		{
-			_status = "STR_REFUELLING";
+			setStatus(CS_REFUELLING);
 			break;
 		}
 		CraftWeapon* cw = (*iter);
@@ -1818,7 +1841,7 @@ void Craft::reuseItem(const RuleItem* item)
 	// (And we don't want to interrupt any out-of-base status.)
 
 	// The only states we are willing to interrupt are "ready" and "refuelling"
-	if (_status != "STR_READY" && _status != "STR_REFUELLING")
+	if (_status != CS_READY && _status != CS_REFUELLING)
 	{
 		return;
 	}
@@ -1829,17 +1852,17 @@ void Craft::reuseItem(const RuleItem* item)
 		if (cw != 0 && item == cw->getRules()->getClipItem() && cw->getAmmo() < cw->getRules()->getAmmoMax() && !cw->isDisabled())
 		{
 			cw->setRearming(true);
-			_status = "STR_REARMING";
+			setStatus(CS_REARMING);
 		}
 	}
 
 	// Only consider refuelling if everything else is complete
-	if (_status != "STR_READY")
+	if (_status != CS_READY)
 		return;
 
 	// Check if it's fuel to refuel the craft
 	if (item->getType() == _rules->getRefuelItem() && _fuel < _stats.fuelMax)
-		_status = "STR_REFUELLING";
+		setStatus(CS_REFUELLING);
 }
 
 /**
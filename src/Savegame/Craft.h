@@ -46,6 +46,9 @@ class ScriptGlobal;
 
 enum UfoDetection : int;
 
+/// What a craft is doing, saved and shown as the matching STR_ string.
+enum CraftStatus : int { CS_READY, CS_OUT, CS_REPAIRS, CS_REFUELLING, CS_REARMING };
+
 typedef std::pair<Position, int> SoldierDeploymentData;
 
 struct VehicleDeploymentData
@@ -80,7 +83,7 @@ private:
 	ItemContainer *_items;
 	ItemContainer *_tempSoldierItems;
 	std::vector<Vehicle*> _vehicles;
-	std::string _status;
+	CraftStatus _status;
 	bool _lowFuel, _mission, _inBattlescape, _inDogfight;
 	double _speedMaxRadian;
 	RuleCraftStats _stats;
@@ -127,9 +130,11 @@ public:
 	/// Sets the craft's base.
 	void setBase(Base *base, bool move = true);
 	/// Gets the craft's status.
-	std::string getStatus() const;
+	CraftStatus getStatus() const { return _status; }
+	/// Gets the craft's status string.
+	const char *getStatusString() const;
 	/// Sets the craft's status.
-	void setStatus(const std::string &status);
+	void setStatus(CraftStatus status);
 	/// Gets the craft's altitude.
 	std::string getAltitude() const;
 	/// Sets the craft's destination.
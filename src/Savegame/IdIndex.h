@@ -0,0 +1,113 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cassert>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/// Hashes IDs made of a type and a number, like CraftId.
+struct TypeIdHash
+{
+	size_t operator()(const std::pair<std::string, int> &id) const
+	{
+		return std::hash<std::string>()(id.first) * 31 + std::hash<int>()(id.second);
+	}
+};
+
+/**
+ * Finds the objects of a list by ID, like the soldiers of a base,
+ * without going through all of them every time. Whoever owns the
+ * list has to add and remove the objects here too, and IDs can't
+ * change while an object is in the list. Like a search of the list,
+ * the first object with an ID is the one found.
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key> >
+class IdIndex
+{
+public:
+	typedef Key (*GetKey)(const T*);
+private:
+	GetKey _getKey;
+	std::unordered_map<Key, T*, Hash> _objects;
+public:
+	/// Creates an empty index.
+	IdIndex(GetKey getKey) : _getKey(getKey)
+	{
+	}
+	/// Adds an object added at the end of the list.
+	void add(T *object)
+	{
+		_objects.emplace(_getKey(object), object);
+	}
+	/**
+	 * Removes an object about to be removed from the list.
+	 * If the list has another object with the same ID, it's found instead.
+	 * @param object Pointer to the object.
+	 * @param list The indexed list, still with the object in it.
+	 */
+	void remove(const T *object, const std::vector<T*> &list)
+	{
+		Key key = _getKey(object);
+		auto i = _objects.find(key);
+		if (i == _objects.end() || i->second != object)
+		{
+			return;
+		}
+		_objects.erase(i);
+		for (auto* other : list)
+		{
+			if (other != object && _getKey(other) == key)
+			{
+				_objects.emplace(key, other);
+				break;
+			}
+		}
+	}
+	/// Finds an object by ID, or null if there's none.
+	T *find(const Key &key) const
+	{
+		auto i = _objects.find(key);
+		return i != _objects.end() ? i->second : nullptr;
+	}
+	/// Checks the index matches the list, in debug builds only.
+	void check(const std::vector<T*> &list) const
+	{
+#ifndef NDEBUG
+		std::unordered_map<Key, T*, Hash> first;
+		for (auto* object : list)
+		{
+			first.emplace(_getKey(object), object);
+		}
+		assert(first.size() == _objects.size() && "ID index out of sync");
+		for (const auto& i : first)
+		{
+			assert(find(i.first) == i.second && "ID index out of sync");
+		}
+#else
+		(void)list;
+#endif
+	}
+};
+}
@@ -148,8 +148,8 @@ productionProgress_e Production::step(Base * b, SavedGame * g, const Mod *m, Lan
 			{
 				Craft *craft = new Craft(ruleCraft, b, g->getId(ruleCraft->getType()));
 				craft->initFixedWeapons(m);
-				craft->setStatus("STR_REFUELLING");
-				b->getCrafts()->push_back(craft);
+				craft->setStatus(CS_REFUELLING);
+				b->addCraft(craft);
 			}
 			else
 			{
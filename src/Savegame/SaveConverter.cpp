@@ -691,7 +691,7 @@ void SaveConverter::loadDatLoc()
 			mission->setAlienRace(_rules->getCrews()[dat]);
 			mission->setSecondsRemaining(timer * 3600);
 			mission->setDetected(detected);
-			_save->getMissionSites()->push_back(mission);
+			_save->addMissionSite(mission);
 			target = mission;
 		}
 		if (target != 0)
@@ -943,8 +943,8 @@ void SaveConverter::loadDatCraft()
 				if (base != 0xFFFF)
 				{
 					Base *b = dynamic_cast<Base*>(_targets[base]);
+					b->addCraft(craft);
 					craft->setBase(b, false);
-					b->getCrafts()->push_back(craft);
 				}
 			}
 			Ufo *ufo = dynamic_cast<Ufo*>(_targets[i]);
@@ -1005,7 +1005,7 @@ void SaveConverter::loadDatCraft()
 					ufo->setSecondsRemaining(0);
 				}
 
-				_save->getUfos()->push_back(ufo);
+				_save->addUfo(ufo);
 			}
 		}
 	}
@@ -1087,7 +1087,7 @@ void SaveConverter::loadDatSoldier()
 			if (base != 0xFFFF)
 			{
 				Base *b = dynamic_cast<Base*>(_targets[base]);
-				b->getSoldiers()->push_back(soldier);
+				b->addSoldier(soldier);
 			}
 			if (craft != 0xFFFF)
 			{
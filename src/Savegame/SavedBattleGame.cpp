@@ -26,15 +26,18 @@
 #include "SavedGame.h"
 #include "Tile.h"
 #include "HitLog.h"
+#include "UnitGrid.h"
 #include "Node.h"
 #include "../Mod/MapDataSet.h"
 #include "../Battlescape/Pathfinding.h"
 #include "../Battlescape/TileEngine.h"
+#include "../Battlescape/AIThreatMap.h"
 #include "../Battlescape/BattlescapeState.h"
 #include "../Battlescape/BattlescapeGame.h"
 #include "../Battlescape/Position.h"
 #include "../Battlescape/Inventory.h"
 #include "../Mod/Mod.h"
+#include "../Mod/TerrainCache.h"
 #include "../Mod/Armor.h"
 #include "../Engine/Game.h"
 #include "../Engine/Sound.h"
@@ -63,7 +66,7 @@ namespace OpenXcom
 SavedBattleGame::SavedBattleGame(Mod *rule, Language *lang, bool isPreview) :
 	_isPreview(isPreview), _craftPos(), _craftZ(0), _craftForPreview(nullptr),
 	_battleState(0), _rule(rule), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _selectedUnit(0),
-	_lastSelectedUnit(0), _pathfinding(0), _tileEngine(0),
+	_lastSelectedUnit(0), _pathfinding(0), _tileEngine(0), _threatMap(0),
 	_reinforcementsItemLevel(0), _startingCondition(nullptr), _enviroEffects(nullptr), _ecEnabledFriendly(false), _ecEnabledHostile(false), _ecEnabledNeutral(false),
 	_globalShade(0), _side(FACTION_PLAYER), _turn(0), _bughuntMinTurn(20), _animFrame(0), _nameDisplay(false),
 	_debugMode(false), _bughuntMode(false), _aborted(false), _itemId(0),
@@ -82,6 +85,7 @@ SavedBattleGame::SavedBattleGame(Mod *rule, Language *lang, bool isPreview) :
 	}
 	_baseItems = new ItemContainer();
 	_hitLog = new HitLog(lang);
+	_unitGrid = new UnitGrid(&_units);
 
 	setRandomHiddenMovementBackground(0);
 }
@@ -93,36 +97,39 @@ SavedBattleGame::~SavedBattleGame()
 {
 	for (auto* mds : _mapDataSets)
 	{
-		mds->unloadData();
+		_rule->getTerrainCache()->release(mds);
 	}
 	for (auto* node : _nodes)
 	{
-		delete node;
+		_nodePool.destroy(node);
 	}
 	for (auto* bu : _units)
 	{
-		delete bu;
+		_unitPool.destroy(bu);
 	}
 	for (auto bi : _items)
 	{
-		delete bi;
+		_itemPool.destroy(bi);
 	}
 	for (auto* bi : _recoverGuaranteed)
 	{
-		delete bi;
+		_itemPool.destroy(bi);
 	}
 	for (auto* bi : _recoverConditional)
 	{
-		delete bi;
+		_itemPool.destroy(bi);
 	}
 	for (auto* bi : _deleted)
 	{
-		delete bi;
+		_itemPool.destroy(bi);
 	}
+	Log(LOG_VERBOSE) << "Battle objects: " << getPooledObjects() << " created in " << getPoolBlocks() << " heap blocks";
 	delete _pathfinding;
 	delete _tileEngine;
+	delete _threatMap;
 	delete _baseItems;
 	delete _hitLog;
+	delete _unitGrid;
 }
 
 /**
@@ -234,7 +241,7 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
 	}
 	for (YAML::const_iterator i = node["nodes"].begin(); i != node["nodes"].end(); ++i)
 	{
-		Node *n = new Node();
+		Node *n = _nodePool.create();
 		n->load(*i);
 		_nodes.push_back(n);
 	}
@@ -248,7 +255,7 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
 		if (id < BattleUnit::MAX_SOLDIER_ID) // Unit is linked to a geoscape soldier
 		{
 			// look up the matching soldier
-			unit = new BattleUnit(mod, savedGame->getSoldier(id), _depth, nullptr);
+			unit = createUnit(mod, savedGame->getSoldier(id), _depth, nullptr);
 		}
 		else
 		{
@@ -256,7 +263,7 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
 			std::string armor = (*i)["genUnitArmor"].as<std::string>();
 			// create a new Unit.
 			if(!mod->getUnit(type) || !mod->getArmor(armor)) continue;
-			unit = new BattleUnit(mod, mod->getUnit(type), originalFaction, id, nullptr, mod->getArmor(armor), mod->getStatAdjustment(savedGame->getDifficulty()), _depth, nullptr);
+			unit = createUnit(mod, mod->getUnit(type), originalFaction, id, nullptr, mod->getArmor(armor), mod->getStatAdjustment(savedGame->getDifficulty()), _depth, nullptr);
 		}
 		unit->load(*i, this->getMod(), this->getMod()->getScriptGlobal());
 		// Handling of special built-in weapons will be done during and after the load of items
@@ -309,7 +316,7 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
 			{
 				int id = (*i)["id"].as<int>();
 				_itemId = std::max(_itemId, id);
-				BattleItem *item = new BattleItem(mod->getItem(type), &id);
+				BattleItem *item = _itemPool.create(mod->getItem(type), &id);
 				item->load(*i, mod, this->getMod()->getScriptGlobal());
 				int owner = (*i)["owner"].as<int>(-1);
 				int prevOwner = (*i)["previousOwner"].as<int>(-1);
@@ -482,7 +489,7 @@ void SavedBattleGame::loadMapResources(Mod *mod)
 {
 	for (auto* mds : _mapDataSets)
 	{
-		mds->loadData(mod->getMCDPatch(mds->getName()));
+		mod->getTerrainCache()->load(mds);
 	}
 
 	int mdsID, mdID;
@@ -665,6 +672,16 @@ YAML::Node SavedBattleGame::save() const
 	return node;
 }
 
+/**
+ * Calculates a checksum of the entire battle state, used
+ * to check that replays and benchmarks stay deterministic.
+ * @return MD5 hash as a hex string.
+ */
+std::string SavedBattleGame::getChecksum() const
+{
+	return SavedGame::checksum(save());
+}
+
 /**
  * Initializes the array of tiles and creates a pathfinding object.
  * @param mapsize_x
@@ -676,7 +693,7 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	// Clear old map data
 	for (auto* node : _nodes)
 	{
-		delete node;
+		_nodePool.destroy(node);
 	}
 
 	_nodes.clear();
@@ -692,6 +709,11 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	_mapsize_z = mapsize_z;
 
 	_tiles.clear();
+	_fireTiles.clear();
+	_smokeTiles.clear();
+	_dangerousTiles.clear();
+	_tileHotData.resize(_mapsize_z * _mapsize_y * _mapsize_x);
+	_unitGrid->reset(_mapsize_x, _mapsize_y);
 	_tiles.reserve(_mapsize_z * _mapsize_y * _mapsize_x);
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
@@ -708,9 +730,11 @@ void SavedBattleGame::initUtilities(Mod *mod, bool craftInventory)
 {
 	delete _pathfinding;
 	delete _tileEngine;
+	delete _threatMap;
 	_baseCraftInventory = craftInventory;
 	_pathfinding = craftInventory ? nullptr : new Pathfinding(this);
 	_tileEngine = new TileEngine(this, mod);
+	_threatMap = craftInventory ? nullptr : new AIThreatMap(this);
 }
 
 /**
@@ -1068,6 +1092,24 @@ TileEngine *SavedBattleGame::getTileEngine() const
 	return _tileEngine;
 }
 
+/**
+ * Gets the threat map shared by the AI units.
+ * @return Pointer to the threat map.
+ */
+AIThreatMap *SavedBattleGame::getAIThreatMap() const
+{
+	return _threatMap;
+}
+
+/**
+ * Gets the grid of units on the map, for finding the units around a position.
+ * @return Pointer to the unit grid.
+ */
+UnitGrid *SavedBattleGame::getUnitGrid() const
+{
+	return _unitGrid;
+}
+
 /**
  * Gets the array of mapblocks.
  * @return Pointer to the array of mapblocks.
@@ -1945,10 +1987,10 @@ BattleItem *SavedBattleGame::createItemForUnit(const RuleItem *rule, BattleUnit
 		return nullptr;
 	}
 
-	BattleItem *item = new BattleItem(rule, getCurrentItemId());
+	BattleItem *item = _itemPool.create(rule, getCurrentItemId());
 	if (!unit->addItem(item, _rule, false, fixedWeapon, fixedWeapon))
 	{
-		delete item;
+		_itemPool.destroy(item);
 		item = nullptr;
 	}
 	else
@@ -1969,7 +2011,7 @@ BattleItem *SavedBattleGame::createItemForUnitSpecialBuiltin(const RuleItem *rul
 		return nullptr;
 	}
 
-	BattleItem *item = new BattleItem(rule, getCurrentItemId());
+	BattleItem *item = _itemPool.create(rule, getCurrentItemId());
 	item->setOwner(unit);
 	item->setSlot(nullptr);
 	_items.push_back(item);
@@ -1991,7 +2033,7 @@ BattleItem *SavedBattleGame::createItemForTile(const RuleItem *rule, Tile *tile)
 {
 	// Note: this is allowed also in preview mode; for items spawned from map blocks (and friendly units spawned from such items)
 
-	BattleItem *item = new BattleItem(rule, getCurrentItemId());
+	BattleItem *item = _itemPool.create(rule, getCurrentItemId());
 	if (tile)
 	{
 		RuleInventory *ground = _rule->getInventoryGround();
@@ -2009,7 +2051,62 @@ BattleItem *SavedBattleGame::createItemForTile(const RuleItem *rule, Tile *tile)
  */
 BattleItem *SavedBattleGame::createTempItem(const RuleItem *rule)
 {
-	return new BattleItem(rule, getCurrentItemId());
+	return _itemPool.create(rule, getCurrentItemId());
+}
+
+/**
+ * Gives a unit just created for the battle a visibility index and
+ * a place to keep what it can see. The places stay where they are
+ * for the whole battle, and the indexes are never reused, so bits
+ * left behind by a destroyed unit can't be mistaken for another one.
+ * @param unit Pointer to the new unit.
+ * @return The same unit.
+ */
+BattleUnit *SavedBattleGame::addUnitVisibility(BattleUnit *unit)
+{
+	_unitVisibility.emplace_back();
+	unit->setVisibility(&_unitVisibility.back(), _unitVisibility.size() - 1);
+	return unit;
+}
+
+/**
+ * Destroys a unit created by the battle that was never added to
+ * the unit list, or was taken out of it.
+ * @param unit Pointer to the unit.
+ */
+void SavedBattleGame::destroyUnit(BattleUnit *unit)
+{
+	_unitPool.destroy(unit);
+}
+
+/**
+ * Destroys an item created by the battle that isn't in any
+ * of the item lists.
+ * @param item Pointer to the item.
+ */
+void SavedBattleGame::destroyItem(BattleItem *item)
+{
+	_itemPool.destroy(item);
+}
+
+/**
+ * Gets how many units, items and nodes were created for the
+ * battle, each of which used to be a separate heap allocation.
+ * @return Number of objects.
+ */
+size_t SavedBattleGame::getPooledObjects() const
+{
+	return _nodePool.getCreated() + _unitPool.getCreated() + _itemPool.getCreated();
+}
+
+/**
+ * Gets how many blocks of memory were taken from the heap
+ * to hold the battle's units, items and nodes.
+ * @return Number of blocks.
+ */
+size_t SavedBattleGame::getPoolBlocks() const
+{
+	return _nodePool.getBlocks() + _unitPool.getBlocks() + _itemPool.getBlocks();
 }
 
 /**
@@ -2021,7 +2118,7 @@ BattleItem *SavedBattleGame::createTempItem(const RuleItem *rule)
  */
 BattleUnit *SavedBattleGame::createTempUnit(const Unit *rules, UnitFaction faction, int nextUnitId)
 {
-	BattleUnit *newUnit = new BattleUnit(
+	BattleUnit *newUnit = createUnit(
 		getMod(),
 		const_cast<Unit*>(rules),
 		faction,
@@ -2328,12 +2425,18 @@ void SavedBattleGame::prepareNewTurn()
 	std::vector<Tile*> tilesOnFire;
 	std::vector<Tile*> tilesOnSmoke;
 
-	// prepare a list of tiles on fire
-	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+	// prepare a list of tiles on fire, and forget the ones that went out
+	for (auto i = _fireTiles.begin(); i != _fireTiles.end(); )
 	{
-		if (getTile(i)->getFire() > 0)
+		Tile *tile = getTile(*i);
+		if (tile->getFire() > 0)
+		{
+			tilesOnFire.push_back(tile);
+			++i;
+		}
+		else
 		{
-			tilesOnFire.push_back(getTile(i));
+			i = _fireTiles.erase(i);
 		}
 	}
 
@@ -2398,14 +2501,24 @@ void SavedBattleGame::prepareNewTurn()
 	}
 
 	// prepare a list of tiles on fire/with smoke in them (smoke acts as fire intensity)
-	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+	for (auto i = _smokeTiles.begin(); i != _smokeTiles.end(); )
 	{
-		if (getTile(i)->getSmoke() > 0)
+		Tile *tile = getTile(*i);
+		if (tile->getSmoke() > 0)
+		{
+			tilesOnSmoke.push_back(tile);
+			++i;
+		}
+		else
 		{
-			tilesOnSmoke.push_back(getTile(i));
+			i = _smokeTiles.erase(i);
 		}
+	}
+	for (int i : _dangerousTiles)
+	{
 		getTile(i)->setDangerous(false);
 	}
+	_dangerousTiles.clear();
 
 	// now make the smoke spread.
 	for (auto* tileOnSmoke : tilesOnSmoke)
@@ -2462,7 +2575,7 @@ void SavedBattleGame::prepareNewTurn()
 	if (!tilesOnFire.empty() || !tilesOnSmoke.empty())
 	{
 		// do damage to units, average out the smoke, etc.
-		for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
+		for (int i : _smokeTiles)
 		{
 			if (getTile(i)->getSmoke() != 0)
 				getTile(i)->prepareNewTurn(getDepth() == 0);
@@ -2622,8 +2735,7 @@ bool SavedBattleGame::eyesOnTarget(UnitFaction faction, BattleUnit* unit)
 	{
 		if (bu->getFaction() != faction) continue;
 
-		auto* vis = bu->getVisibleUnits();
-		if (std::find(vis->begin(), vis->end(), unit) != vis->end()) return true;
+		if (bu->isOnVisibleUnits(unit)) return true;
 		// aliens know the location of all XCom agents sighted by all other aliens due to sharing locations over their space-walkie-talkies
 	}
 
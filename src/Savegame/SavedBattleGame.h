@@ -17,10 +17,15 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
+#include <deque>
+#include <set>
 #include <vector>
 #include <string>
 #include <yaml-cpp/yaml.h>
 #include "Tile.h"
+#include "BattleObjectPool.h"
+#include "UnitVisibility.h"
 #include "../Mod/AlienDeployment.h"
 #include "../Mod/RuleCraft.h"
 
@@ -36,6 +41,8 @@ class BattlescapeGame;
 class Position;
 class Pathfinding;
 class TileEngine;
+class AIThreatMap;
+class UnitGrid;
 class RuleStartingCondition;
 class RuleEnviroEffects;
 class BattleItem;
@@ -49,6 +56,43 @@ class HitLog;
 enum HitLogEntryType : int;
 struct BattlescapeTally;
 
+/**
+ * Copies of the tile fields read most by the FOV, lighting and pathfinding
+ * loops, stored as compact arrays indexed like the tiles. A whole tile spans
+ * several cache lines, so walking these arrays is much cheaper than walking
+ * the tiles. Tile keeps them up to date whenever the fields change,
+ * so they are read-only for everyone else.
+ */
+struct TileHotData
+{
+	std::vector<Sint8> terrainLevel;
+	std::vector<Uint8> smoke;
+	std::vector<Uint8> fire;
+	/// LL_MAX layers for each tile.
+	std::vector<Uint8> light;
+
+	/// Sets up the arrays for a number of empty tiles, the way a new Tile starts out.
+	void resize(size_t count)
+	{
+		terrainLevel.assign(count, 0);
+		smoke.assign(count, 0);
+		fire.assign(count, 0);
+		light.assign(count * LL_MAX, 0);
+	}
+
+	/// Gets the brightest light of a tile up to a layer, like Tile::getLightMulti.
+	int getLightMulti(int index, LightLayers layer) const
+	{
+		const Uint8 *l = &light[index * LL_MAX];
+		int max = 0;
+		for (int i = layer; i >= 0; --i)
+		{
+			max = std::max(max, (int)l[i]);
+		}
+		return max;
+	}
+};
+
 /**
  * The battlescape data that gets written to disk when the game is saved.
  * A saved game holds all the variable info in a game like mapdata,
@@ -73,12 +117,20 @@ private:
 	int _mapsize_x, _mapsize_y, _mapsize_z;
 	std::vector<MapDataSet*> _mapDataSets;
 	std::vector<Tile> _tiles;
+	TileHotData _tileHotData;
+	std::set<int> _fireTiles, _smokeTiles, _dangerousTiles;
 	BattleUnit *_selectedUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
 	std::vector<BattleUnit*> _units;
 	std::vector<BattleItem*> _items, _deleted;
+	BattleObjectPool<Node> _nodePool;
+	BattleObjectPool<BattleUnit> _unitPool;
+	BattleObjectPool<BattleItem> _itemPool;
+	std::deque<UnitVisibility> _unitVisibility;
 	Pathfinding *_pathfinding;
 	TileEngine *_tileEngine;
+	AIThreatMap *_threatMap;
+	UnitGrid *_unitGrid;
 	std::string _missionType, _strTarget, _strCraftOrBase, _alienCustomDeploy, _alienCustomMission;
 	std::string _lastUsedMapScript;
 	int _alienItemLevel = 0;
@@ -129,6 +181,8 @@ private:
 	BattleUnit *selectPlayerUnit(int dir, bool checkReselect = false, bool setReselect = false, bool checkInventory = false);
 	/// Run newTurnUnit and newTurnItem scripts
 	void newTurnUpdateScripts();
+	/// Gives a new unit somewhere to keep what it can see.
+	BattleUnit *addUnitVisibility(BattleUnit *unit);
 public:
 	/// Creates a new battle save, based on the current generic save.
 	SavedBattleGame(Mod *rule, Language *lang, bool isPreview = false);
@@ -138,6 +192,8 @@ public:
 	void load(const YAML::Node& node, Mod *mod, SavedGame* savedGame);
 	/// Saves a saved battle game to YAML.
 	YAML::Node save() const;
+	/// Gets a checksum of the battle state.
+	std::string getChecksum() const;
 	/// Sets the dimensions of the map and initializes it.
 	void initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool resetTerrain = true);
 	/// Initialises the pathfinding and tile engine.
@@ -288,6 +344,11 @@ public:
 		return &_tiles[getTileIndex(pos)];
 	}
 
+	/// Gets the compact copies of the tile fields used by the battlescape algorithms.
+	const TileHotData &getTileHotData() const { return _tileHotData; }
+	/// Gets the compact copies of the tile fields, for the tiles to update.
+	TileHotData &getTileHotData() { return _tileHotData; }
+
 	/*
 	 * Gets a pointer to the tiles, a tile is the smallest component of battlescape.
 	 * @param pos Index position, less than `getMapSizeXYZ()`.
@@ -376,6 +437,10 @@ public:
 	Pathfinding *getPathfinding() const;
 	/// Gets a pointer to the tile engine.
 	TileEngine *getTileEngine() const;
+	/// Gets a pointer to the AI threat map.
+	AIThreatMap *getAIThreatMap() const;
+	/// Gets a pointer to the grid of units on the map.
+	UnitGrid *getUnitGrid() const;
 	/// Gets the playing side.
 	UnitFaction getSide() const;
 	/// Can unit use that weapon?
@@ -442,6 +507,20 @@ public:
 	BattleUnit *createTempUnit(const Unit *rules, UnitFaction faction, int nextUnitId = -1);
 	/// Converts a unit into a unit of another type.
 	BattleUnit *convertUnit(BattleUnit *unit);
+	/// Creates a new node owned by the battle.
+	template<typename... Args>
+	Node *createNode(Args&&... args) { return _nodePool.create(std::forward<Args>(args)...); }
+	/// Creates a new unit owned by the battle.
+	template<typename... Args>
+	BattleUnit *createUnit(Args&&... args) { return addUnitVisibility(_unitPool.create(std::forward<Args>(args)...)); }
+	/// Destroys a unit that isn't part of the battle.
+	void destroyUnit(BattleUnit *unit);
+	/// Destroys an item that isn't part of the battle.
+	void destroyItem(BattleItem *item);
+	/// Gets the number of units, items and nodes created for the battle.
+	size_t getPooledObjects() const;
+	/// Gets the number of heap blocks holding the battle's units, items and nodes.
+	size_t getPoolBlocks() const;
 
 	/// Sets whether the mission was aborted.
 	void setAborted(bool flag);
@@ -461,6 +540,12 @@ public:
 	Node *getPatrolNode(bool scout, BattleUnit *unit, Node *fromNode);
 	/// Carries out new turn preparations.
 	void prepareNewTurn();
+	/// Remembers a tile that caught fire.
+	void addFireTile(const Tile *tile) { _fireTiles.insert(getTileIndex(tile->getPosition())); }
+	/// Remembers a tile that got smoke in it.
+	void addSmokeTile(const Tile *tile) { _smokeTiles.insert(getTileIndex(tile->getPosition())); }
+	/// Remembers a tile that was flagged as dangerous.
+	void addDangerousTile(const Tile *tile) { _dangerousTiles.insert(getTileIndex(tile->getPosition())); }
 	/// Revives unconscious units (health check).
 	void reviveUnconsciousUnits(bool noTU = false);
 	/// Removes the body item that corresponds to the unit.
@@ -24,6 +24,7 @@
 #include <ctime>
 #include <yaml-cpp/yaml.h>
 #include "../version.h"
+#include "../md5.h"
 #include "../Engine/Logger.h"
 #include "../Mod/Mod.h"
 #include "../Engine/RNG.h"
@@ -52,6 +53,7 @@
 #include "../Mod/RuleSoldierTransformation.h"
 #include "Production.h"
 #include "MissionSite.h"
+#include "../Mod/AlienDeployment.h"
 #include "AlienBase.h"
 #include "AlienStrategy.h"
 #include "AlienMission.h"
@@ -138,6 +140,16 @@ bool haveReserchVector(const std::vector<const RuleResearch*> &vec,  const std::
 	return find != vec.end();
 }
 
+/**
+ * Mission site IDs are only unique per marker.
+ * @param site Pointer to mission site.
+ * @return Marker name of the mission site's deployment and mission site ID.
+ */
+std::pair<std::string, int> getMissionSiteKey(const MissionSite *site)
+{
+	return std::make_pair(site->getDeployment()->getMarkerName(), site->getId());
+}
+
 }
 
 /**
@@ -147,7 +159,10 @@ SavedGame::SavedGame() :
 	_difficulty(DIFF_BEGINNER), _end(END_NONE), _ironman(false), _globeLon(0.0), _globeLat(0.0), _globeZoom(0),
 	_battleGame(0), _previewBase(nullptr), _debug(false), _warned(false),
 	_togglePersonalLight(true), _toggleNightVision(false), _toggleBrightness(0),
-	_monthsPassed(-1), _selectedBase(0), _autosales(), _disableSoldierEquipment(false), _alienContainmentChecked(false)
+	_monthsPassed(-1), _selectedBase(0), _autosales(), _disableSoldierEquipment(false), _alienContainmentChecked(false),
+	_deadSoldierIndex([](const Soldier *soldier) { return soldier->getId(); }),
+	_ufoIndex([](const Ufo *ufo) { return ufo->getUniqueId(); }),
+	_missionSiteIndex(getMissionSiteKey)
 {
 	_time = new GameTime(6, 1, 1, 1999, 12, 0, 0);
 	_alienStrategy = new AlienStrategy();
@@ -524,7 +539,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		{
 			Ufo *u = new Ufo(mod->getUfo(type), 0);
 			u->load(*i, mod->getScriptGlobal(), *mod, *this);
-			_ufos.push_back(u);
+			addUfo(u);
 		}
 		else
 		{
@@ -565,7 +580,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		{
 			MissionSite *m = new MissionSite(mod->getAlienMission(type), mod->getDeployment(deployment), nullptr);
 			m->load(*i);
-			_missionSites.push_back(m);
+			addMissionSite(m);
 		}
 		else
 		{
@@ -582,7 +597,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		{
 			MissionSite *m = new MissionSite(mod->getAlienMission(type), mod->getDeployment(deployment), mod->getDeployment(alienWeaponDeploy));
 			m->load(*i);
-			_missionSites.push_back(m);
+			addMissionSite(m);
 		}
 		else
 		{
@@ -655,15 +670,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		int uniqueUfoId = (*i)["uniqueId"].as<int>(0);
 		if (uniqueUfoId > 0)
 		{
-			Ufo *ufo = 0;
-			for (auto* u : _ufos)
-			{
-				if (u->getUniqueId() == uniqueUfoId)
-				{
-					ufo = u;
-					break;
-				}
-			}
+			Ufo *ufo = getUfoByUniqueId(uniqueUfoId);
 			if (ufo)
 			{
 				ufo->finishLoading(*i, *this);
@@ -694,6 +701,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 			Soldier *soldier = new Soldier(mod->getSoldier(type), nullptr, 0 /*nationality*/);
 			soldier->load(*i, mod, this, mod->getScriptGlobal());
 			_deadSoldiers.push_back(soldier);
+			_deadSoldierIndex.add(soldier);
 		}
 		else
 		{
@@ -839,6 +847,23 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	out << brief;
 	// Saves the full game data to the save
 	out << YAML::BeginDoc;
+	out << saveData(mod);
+
+	std::string filepath = Options::getMasterUserFolder() + filename;
+	if (!CrossPlatform::writeFile(filepath, out.c_str()))
+	{
+		throw Exception("Failed to save " + filepath);
+	}
+}
+
+/**
+ * Saves the full game data, without the brief info
+ * used in the saves list.
+ * @param mod Pointer to the mod.
+ * @return YAML node.
+ */
+YAML::Node SavedGame::saveData(Mod *mod) const
+{
 	YAML::Node node;
 	node["difficulty"] = (int)_difficulty;
 	node["end"] = (int)_end;
@@ -1001,15 +1026,33 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 		node["battleGame"] = _battleGame->save();
 	}
 	_scriptValues.save(node, mod->getScriptGlobal());
+	return node;
+}
 
-	out << node;
-
+/**
+ * Calculates a checksum of the full game data.
+ * @param mod Pointer to the mod.
+ * @return MD5 hash as a hex string.
+ */
+std::string SavedGame::getChecksum(Mod *mod) const
+{
+	return checksum(saveData(mod));
+}
 
-	std::string filepath = Options::getMasterUserFolder() + filename;
-	if (!CrossPlatform::writeFile(filepath, out.c_str()))
-	{
-		throw Exception("Failed to save " + filepath);
-	}
+/**
+ * Calculates a checksum of some saved game data, as it would be
+ * written to a save file, along with the random number generator's state.
+ * Two runs from the same start must always give the same checksums.
+ * @param node Saved data.
+ * @return MD5 hash as a hex string.
+ */
+std::string SavedGame::checksum(const YAML::Node &node)
+{
+	YAML::Emitter out;
+	out << node;
+	std::ostringstream ss;
+	ss << out.c_str() << "\nrng: " << RNG::getSeed();
+	return md5(ss.str());
 }
 
 /**
@@ -1449,6 +1492,27 @@ const std::vector<Ufo*> *SavedGame::getUfos() const
 	return &_ufos;
 }
 
+/**
+ * Adds a UFO to the end of the list of alien UFOs.
+ * @param ufo Pointer to UFO.
+ */
+void SavedGame::addUfo(Ufo *ufo)
+{
+	_ufos.push_back(ufo);
+	_ufoIndex.add(ufo);
+}
+
+/**
+ * Removes a UFO from the list of alien UFOs (does not destroy it!).
+ * @param ufoIt Position of the UFO in the list.
+ * @return Position of the next UFO.
+ */
+std::vector<Ufo*>::iterator SavedGame::removeUfo(std::vector<Ufo*>::iterator ufoIt)
+{
+	_ufoIndex.remove(*ufoIt, _ufos);
+	return _ufos.erase(ufoIt);
+}
+
 /**
  * Returns the list of craft waypoints.
  * @return Pointer to waypoint list.
@@ -1467,6 +1531,27 @@ std::vector<MissionSite*> *SavedGame::getMissionSites()
 	return &_missionSites;
 }
 
+/**
+ * Adds a mission site to the end of the list of mission sites.
+ * @param site Pointer to mission site.
+ */
+void SavedGame::addMissionSite(MissionSite *site)
+{
+	_missionSites.push_back(site);
+	_missionSiteIndex.add(site);
+}
+
+/**
+ * Removes a mission site from the list of mission sites (does not destroy it!).
+ * @param siteIt Position of the mission site in the list.
+ * @return Position of the next mission site.
+ */
+std::vector<MissionSite*>::iterator SavedGame::removeMissionSite(std::vector<MissionSite*>::iterator siteIt)
+{
+	_missionSiteIndex.remove(*siteIt, _missionSites);
+	return _missionSites.erase(siteIt);
+}
+
 /**
  * Get pointer to the battleGame object.
  * @return Pointer to the battleGame object.
@@ -2310,7 +2395,8 @@ bool SavedGame::isSoldierTypeHired(const std::string& soldierType) const
 }
 
 /**
- * Returns pointer to the Soldier given it's unique ID.
+ * Returns pointer to the Soldier given it's unique ID,
+ * from any base or the memorial.
  * @param id A soldier's unique id.
  * @return Pointer to Soldier.
  */
@@ -2318,22 +2404,56 @@ Soldier *SavedGame::getSoldier(int id) const
 {
 	for (auto* xbase : _bases)
 	{
-		for (auto* soldier : *xbase->getSoldiers())
+		Soldier *soldier = xbase->findSoldier(id);
+		if (soldier)
 		{
-			if (soldier->getId() == id)
-			{
-				return soldier;
-			}
+			return soldier;
 		}
 	}
-	for (auto* soldier : _deadSoldiers)
+	_deadSoldierIndex.check(_deadSoldiers);
+	return _deadSoldierIndex.find(id);
+}
+
+/**
+ * Returns the craft in any base with the specified unique ID.
+ * @param id Craft type and ID.
+ * @return Pointer to the craft, or null if there's none.
+ */
+Craft *SavedGame::getCraft(const CraftId &id) const
+{
+	for (auto* xbase : _bases)
 	{
-		if (soldier->getId() == id)
+		Craft *craft = xbase->findCraft(id);
+		if (craft)
 		{
-			return soldier;
+			return craft;
 		}
 	}
-	return 0;
+	return nullptr;
+}
+
+/**
+ * Returns the UFO with the specified unique ID.
+ * @param uniqueId Unique ID of the UFO.
+ * @return Pointer to the UFO, or null if there's none.
+ */
+Ufo *SavedGame::getUfoByUniqueId(int uniqueId) const
+{
+	_ufoIndex.check(_ufos);
+	return _ufoIndex.find(uniqueId);
+}
+
+/**
+ * Returns the mission site with the specified marker and ID,
+ * since the IDs are only unique per marker.
+ * @param markerName Marker name of the mission site's deployment.
+ * @param id Mission site ID.
+ * @return Pointer to the mission site, or null if there's none.
+ */
+MissionSite *SavedGame::getMissionSite(const std::string &markerName, int id) const
+{
+	_missionSiteIndex.check(_missionSites);
+	return _missionSiteIndex.find(std::make_pair(markerName, id));
 }
 
 /**
@@ -2885,6 +3005,17 @@ std::vector<Soldier*> *SavedGame::getDeadSoldiers()
 	return &_deadSoldiers;
 }
 
+/**
+ * Removes a soldier from the list of dead soldiers (does not destroy them!).
+ * @param soldierIt Position of the soldier in the list.
+ * @return Position of the next dead soldier.
+ */
+std::vector<Soldier*>::iterator SavedGame::removeDeadSoldier(std::vector<Soldier*>::iterator soldierIt)
+{
+	_deadSoldierIndex.remove(*soldierIt, _deadSoldiers);
+	return _deadSoldiers.erase(soldierIt);
+}
+
 /**
  * Calculates and returns a list of all active soldiers.
  * @return All active soldiers.
@@ -3062,7 +3193,8 @@ std::vector<Soldier*>::iterator SavedGame::killSoldier(bool resetArmor, Soldier
 			{
 				soldier->die(new SoldierDeath(*_time, cause));
 				_deadSoldiers.push_back(soldier);
-				return xbase->getSoldiers()->erase(soldierIt);
+				_deadSoldierIndex.add(soldier);
+				return xbase->removeSoldier(soldierIt);
 			}
 		}
 	}
@@ -3225,8 +3357,8 @@ void SavedGame::deleteRetaliationMission(AlienMission* am, Base* base)
 		Ufo* ufo = (*iter);
 		if (ufo->getMission() == am)
 		{
+			iter = removeUfo(iter);
 			delete ufo;
-			iter = _ufos.erase(iter);
 		}
 		else
 		{
@@ -27,6 +27,7 @@
 #include "../Mod/RuleAlienMission.h"
 #include "../Mod/RuleEvent.h"
 #include "../Savegame/Craft.h"
+#include "../Savegame/IdIndex.h"
 #include "../Mod/RuleManufacture.h"
 #include "../Mod/RuleBaseFacility.h"
 #include "../Mod/RuleCraft.h"
@@ -173,6 +174,9 @@ private:
 	bool _disableSoldierEquipment;
 	bool _alienContainmentChecked;
 	ScriptValues<SavedGame> _scriptValues;
+	IdIndex<int, Soldier> _deadSoldierIndex;
+	IdIndex<int, Ufo> _ufoIndex;
+	IdIndex<std::pair<std::string, int>, MissionSite, TypeIdHash> _missionSiteIndex;
 
 	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
 public:
@@ -189,6 +193,12 @@ public:
 	void load(const std::string &filename, Mod *mod, Language *lang);
 	/// Saves a saved game to YAML.
 	void save(const std::string &filename, Mod *mod) const;
+	/// Saves the game data to a YAML node.
+	YAML::Node saveData(Mod *mod) const;
+	/// Gets a checksum of the game data and the RNG state.
+	std::string getChecksum(Mod *mod) const;
+	/// Gets a checksum of some saved data and the RNG state.
+	static std::string checksum(const YAML::Node &node);
 	/// Gets the game name.
 	std::string getName() const;
 	/// Sets the game name.
@@ -261,10 +271,18 @@ public:
 	std::vector<Ufo*> *getUfos();
 	/// Gets the list of UFOs.
 	const std::vector<Ufo*> *getUfos() const;
+	/// Adds a UFO to the list.
+	void addUfo(Ufo *ufo);
+	/// Removes a UFO from the list.
+	std::vector<Ufo*>::iterator removeUfo(std::vector<Ufo*>::iterator ufoIt);
 	/// Gets the list of waypoints.
 	std::vector<Waypoint*> *getWaypoints();
 	/// Gets the list of mission sites.
 	std::vector<MissionSite*> *getMissionSites();
+	/// Adds a mission site to the list.
+	void addMissionSite(MissionSite *site);
+	/// Removes a mission site from the list.
+	std::vector<MissionSite*>::iterator removeMissionSite(std::vector<MissionSite*>::iterator siteIt);
 	/// Gets the current battle game.
 	SavedBattleGame *getSavedBattle();
 	/// Sets the current battle game.
@@ -343,6 +361,12 @@ public:
 	bool isSoldierTypeHired(const std::string& soldierType) const;
 	/// Gets the soldier matching this ID.
 	Soldier *getSoldier(int id) const;
+	/// Gets the craft matching this ID.
+	Craft *getCraft(const CraftId &id) const;
+	/// Gets the UFO matching this unique ID.
+	Ufo *getUfoByUniqueId(int uniqueId) const;
+	/// Gets the mission site matching this marker and ID.
+	MissionSite *getMissionSite(const std::string &markerName, int id) const;
 	/// Handles the higher promotions.
 	bool handlePromotions(std::vector<Soldier*> &participants, const Mod *mod);
 	/// Checks how many soldiers of a rank exist and which one has the highest score.
@@ -435,6 +459,8 @@ public:
 	bool wasEventGenerated(const std::string& eventName);
 	/// Gets the list of dead soldiers.
 	std::vector<Soldier*> *getDeadSoldiers();
+	/// Removes a soldier from the list of dead soldiers.
+	std::vector<Soldier*>::iterator removeDeadSoldier(std::vector<Soldier*>::iterator soldierIt);
 	/// Gets a list of all active soldiers.
 	std::vector<Soldier*> getAllActiveSoldiers() const;
 	/// Gets the last selected player base.
@@ -83,6 +83,7 @@ void SoldierDiary::load(const YAML::Node& node, const Mod *mod)
 			_killList.push_back(new BattleUnitKills(*i));
 	}
 	_missionIdList = node["missionIdList"].as<std::vector<int> >(_missionIdList);
+	_totals = Totals();
 	_daysWoundedTotal = node["daysWoundedTotal"].as<int>(_daysWoundedTotal);
 	_totalShotByFriendlyCounter = node["totalShotByFriendlyCounter"].as<int>(_totalShotByFriendlyCounter);
 	_totalShotFriendlyCounter = node["totalShotFriendlyCounter"].as<int>(_totalShotFriendlyCounter);
@@ -220,9 +221,10 @@ void SoldierDiary::updateDiary(BattleUnitStatistics *unitStatistics, std::vector
 	if (unitStatistics->MIA)
 		_MIA++;
 	_woundsHealedTotal += unitStatistics->woundsHealed;
-	if (getUFOTotal(allMissionStatistics).size() >= rules->getUfosList().size())
+	size_t ufoTotal = getUFOTotal(allMissionStatistics).size();
+	if (ufoTotal >= rules->getUfosList().size())
 		_allUFOs = 1;
-	if ((getUFOTotal(allMissionStatistics).size() + getTypeTotal(allMissionStatistics).size()) == (rules->getUfosList().size() + rules->getDeploymentsList().size() - 2))
+	if ((ufoTotal + getTypeTotal(allMissionStatistics).size()) == (rules->getUfosList().size() + rules->getDeploymentsList().size() - 2))
 		_allMissionTypes = 1;
 	if (getCountryTotal(allMissionStatistics).size() == rules->getCountriesList().size())
 		_globeTrotter = true;
@@ -377,18 +379,19 @@ bool SoldierDiary::manageCommendations(Mod *mod, std::vector<MissionStatistics*>
 			// And because they loop over a map<> (this allows for maximum moddability).
 			else if (critName == "totalKillsWithAWeapon" || critName == "totalMissionsInARegion" || critName == "totalKillsByRace" || critName == "totalKillsByRank")
 			{
-				std::map<std::string, int> tempTotal;
+				std::map<std::string, int> regionTotal;
+				const std::map<std::string, int> *tempTotal = &regionTotal;
 				if (critName == "totalKillsWithAWeapon")
-					tempTotal = getWeaponTotal();
+					tempTotal = &updateKillTotals().weapon;
 				else if (critName == "totalMissionsInARegion")
-					tempTotal = getRegionTotal(missionStatistics);
+					regionTotal = getRegionTotal(missionStatistics);
 				else if (critName == "totalKillsByRace")
-					tempTotal = getAlienRaceTotal();
+					tempTotal = &updateKillTotals().race;
 				else if (critName == "totalKillsByRank")
-					tempTotal = getAlienRankTotal();
+					tempTotal = &updateKillTotals().rank;
 				// Loop over the temporary map.
 				// Match nouns and decoration levels.
-				for (const auto& pair : tempTotal)
+				for (const auto& pair : *tempTotal)
 				{
 					int criteria = -1;
 					const auto& noun = pair.first;
@@ -628,11 +631,125 @@ bool SoldierDiary::manageCommendations(Mod *mod, std::vector<MissionStatistics*>
 	return ret;
 }
 
+/**
+ * Brings the kill totals up to date, only going over
+ * the kills added since the last time.
+ * @return Diary totals.
+ */
+const SoldierDiary::Totals &SoldierDiary::updateKillTotals() const
+{
+	Totals &t = _totals;
+	for (; t.kills < _killList.size(); ++t.kills)
+	{
+		const auto* buk = _killList[t.kills];
+		t.rank[buk->rank]++;
+		t.race[buk->race]++;
+		if (buk->faction == FACTION_HOSTILE)
+		{
+			t.weapon[buk->weapon]++;
+			t.weaponAmmo[buk->weaponAmmo]++;
+			switch (buk->status)
+			{
+			case STATUS_DEAD: t.killTotal++; break;
+			case STATUS_UNCONSCIOUS: t.stunTotal++; break;
+			case STATUS_PANICKING: t.panickTotal++; break;
+			case STATUS_TURNING: t.controlTotal++; break;
+			default: break;
+			}
+		}
+	}
+	return t;
+}
+
+/**
+ * Brings the trap and reaction fire kill totals up to date,
+ * only going over the kills added since the last time.
+ * @param mod Pointer to the mod, for the weapon rules.
+ * @return Diary totals.
+ */
+const SoldierDiary::Totals &SoldierDiary::updateKillTypeTotals(const Mod *mod) const
+{
+	Totals &t = _totals;
+	if (t.mod != mod)
+	{
+		t.mod = mod;
+		t.modKills = 0;
+		t.trapKillTotal = 0;
+		t.reactionFireKillTotal = 0;
+	}
+	for (; t.modKills < _killList.size(); ++t.modKills)
+	{
+		const auto* buk = _killList[t.modKills];
+		if (!buk->hostileTurn())
+		{
+			continue;
+		}
+		const RuleItem *item = mod->getItem(buk->weapon);
+		if (item == 0 || item->getBattleType() == BT_GRENADE || item->getBattleType() == BT_PROXIMITYGRENADE)
+		{
+			t.trapKillTotal++;
+		}
+		else
+		{
+			t.reactionFireKillTotal++;
+		}
+	}
+	return t;
+}
+
+/**
+ * Brings the list of the soldier's missions up to date, only
+ * looking up the missions added since the last time.
+ * A mission appears once for each time its id is in the diary,
+ * same as the original lookups matching every id to every mission.
+ * @param missionStatistics List of all the mission statistics.
+ * @return Statistics of the soldier's missions.
+ */
+const std::vector<const MissionStatistics*> &SoldierDiary::updateMissions(const std::vector<MissionStatistics*> *missionStatistics) const
+{
+	Totals &t = _totals;
+	if (t.missionStatistics != missionStatistics || t.missionStatisticsSize != missionStatistics->size() || t.missionIds > _missionIdList.size())
+	{
+		// a missing id might be in the new statistics, start over
+		t.missionStatistics = missionStatistics;
+		t.missionStatisticsSize = missionStatistics->size();
+		t.missionIds = 0;
+		t.missions.clear();
+		t.uniqueMissions.clear();
+	}
+	auto add = [&](const MissionStatistics *ms)
+	{
+		if (std::find(t.uniqueMissions.begin(), t.uniqueMissions.end(), ms) == t.uniqueMissions.end())
+		{
+			t.uniqueMissions.push_back(ms);
+		}
+		t.missions.push_back(ms);
+	};
+	for (; t.missionIds < _missionIdList.size(); ++t.missionIds)
+	{
+		int missionId = _missionIdList[t.missionIds];
+		// ids are normally the index of the mission in the list
+		if (missionId >= 0 && (size_t)missionId < missionStatistics->size() && (*missionStatistics)[missionId]->id == missionId)
+		{
+			add((*missionStatistics)[missionId]);
+			continue;
+		}
+		for (const auto* ms : *missionStatistics)
+		{
+			if (ms->id == missionId)
+			{
+				add(ms);
+			}
+		}
+	}
+	return t.missions;
+}
+
 /**
  * Get vector of mission ids.
  * @return Vector of mission ids.
  */
-std::vector<int> &SoldierDiary::getMissionIdList()
+const std::vector<int> &SoldierDiary::getMissionIdList() const
 {
 	return _missionIdList;
 }
@@ -641,7 +758,7 @@ std::vector<int> &SoldierDiary::getMissionIdList()
  * Get vector of kills.
  * @return vector of BattleUnitKills
  */
-std::vector<BattleUnitKills*> &SoldierDiary::getKills()
+const std::vector<BattleUnitKills*> &SoldierDiary::getKills() const
 {
 	return _killList;
 }
@@ -652,12 +769,7 @@ std::vector<BattleUnitKills*> &SoldierDiary::getKills()
  */
 std::map<std::string, int> SoldierDiary::getAlienRankTotal()
 {
-	std::map<std::string, int> list;
-	for (const auto* buk : _killList)
-	{
-		list[buk->rank]++;
-	}
-	return list;
+	return updateKillTotals().rank;
 }
 
 /**
@@ -665,12 +777,7 @@ std::map<std::string, int> SoldierDiary::getAlienRankTotal()
  */
 std::map<std::string, int> SoldierDiary::getAlienRaceTotal()
 {
-	std::map<std::string, int> list;
-	for (const auto* buk : _killList)
-	{
-		list[buk->race]++;
-	}
-	return list;
+	return updateKillTotals().race;
 }
 
 /**
@@ -678,13 +785,7 @@ std::map<std::string, int> SoldierDiary::getAlienRaceTotal()
  */
 std::map<std::string, int> SoldierDiary::getWeaponTotal()
 {
-	std::map<std::string, int> list;
-	for (const auto* buk : _killList)
-	{
-		if (buk->faction == FACTION_HOSTILE)
-			list[buk->weapon]++;
-	}
-	return list;
+	return updateKillTotals().weapon;
 }
 
 /**
@@ -692,13 +793,7 @@ std::map<std::string, int> SoldierDiary::getWeaponTotal()
  */
 std::map<std::string, int> SoldierDiary::getWeaponAmmoTotal()
 {
-	std::map<std::string, int> list;
-	for (const auto* buk : _killList)
-	{
-		if (buk->faction == FACTION_HOSTILE)
-			list[buk->weaponAmmo]++;
-	}
-	return list;
+	return updateKillTotals().weaponAmmo;
 }
 
 /**
@@ -709,15 +804,9 @@ std::map<std::string, int> SoldierDiary::getRegionTotal(std::vector<MissionStati
 {
 	std::map<std::string, int> regionTotal;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int missionId : _missionIdList)
-		{
-			if (missionId == ms->id)
-			{
-				regionTotal[ms->region]++;
-			}
-		}
+		regionTotal[ms->region]++;
 	}
 
 	return regionTotal;
@@ -731,15 +820,9 @@ std::map<std::string, int> SoldierDiary::getCountryTotal(std::vector<MissionStat
 {
 	std::map<std::string, int> countryTotal;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int missionId : _missionIdList)
-		{
-			if (missionId == ms->id)
-			{
-				countryTotal[ms->country]++;
-			}
-		}
+		countryTotal[ms->country]++;
 	}
 
 	return countryTotal;
@@ -753,15 +836,9 @@ std::map<std::string, int> SoldierDiary::getTypeTotal(std::vector<MissionStatist
 {
 	std::map<std::string, int> typeTotal;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int missionId : _missionIdList)
-		{
-			if (missionId == ms->id)
-			{
-				typeTotal[ms->type]++;
-			}
-		}
+		typeTotal[ms->type]++;
 	}
 
 	return typeTotal;
@@ -775,15 +852,9 @@ std::map<std::string, int> SoldierDiary::getUFOTotal(std::vector<MissionStatisti
 {
 	std::map<std::string, int> ufoTotal;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int missionId : _missionIdList)
-		{
-			if (missionId == ms->id)
-			{
-				ufoTotal[ms->ufo]++;
-			}
-		}
+		ufoTotal[ms->ufo]++;
 	}
 
 	return ufoTotal;
@@ -794,17 +865,7 @@ std::map<std::string, int> SoldierDiary::getUFOTotal(std::vector<MissionStatisti
  */
 int SoldierDiary::getKillTotal() const
 {
-	int killTotal = 0;
-
-	for (const auto* buk : _killList)
-	{
-		if (buk->status == STATUS_DEAD && buk->faction == FACTION_HOSTILE)
-		{
-			killTotal++;
-		}
-	}
-
-	return killTotal;
+	return updateKillTotals().killTotal;
 }
 
 /**
@@ -823,16 +884,14 @@ int SoldierDiary::getMissionTotalFiltered(std::vector<MissionStatistics*>* missi
 	if (!rule->getMissionTypeNames().empty())
 	{
 		int total = 0;
-		for (const auto* ms : *missionStatistics)
+		updateMissions(missionStatistics);
+		for (const auto* ms : _totals.uniqueMissions)
 		{
 			if (ms->success)
 			{
-				if (std::find(_missionIdList.begin(), _missionIdList.end(), ms->id) != _missionIdList.end())
+				if (std::find(rule->getMissionTypeNames().begin(), rule->getMissionTypeNames().end(), ms->type) != rule->getMissionTypeNames().end())
 				{
-					if (std::find(rule->getMissionTypeNames().begin(), rule->getMissionTypeNames().end(), ms->type) != rule->getMissionTypeNames().end())
-					{
-						++total;
-					}
+					++total;
 				}
 			}
 		}
@@ -841,16 +900,14 @@ int SoldierDiary::getMissionTotalFiltered(std::vector<MissionStatistics*>* missi
 	else if (!rule->getMissionMarkerNames().empty())
 	{
 		int total = 0;
-		for (const auto* ms : *missionStatistics)
+		updateMissions(missionStatistics);
+		for (const auto* ms : _totals.uniqueMissions)
 		{
 			if (ms->success)
 			{
-				if (std::find(_missionIdList.begin(), _missionIdList.end(), ms->id) != _missionIdList.end())
+				if (std::find(rule->getMissionMarkerNames().begin(), rule->getMissionMarkerNames().end(), ms->markerName) != rule->getMissionMarkerNames().end())
 				{
-					if (std::find(rule->getMissionMarkerNames().begin(), rule->getMissionMarkerNames().end(), ms->markerName) != rule->getMissionMarkerNames().end())
-					{
-						++total;
-					}
+					++total;
 				}
 			}
 		}
@@ -868,17 +925,11 @@ int SoldierDiary::getWinTotal(std::vector<MissionStatistics*> *missionStatistics
 {
 	int winTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int missionId : _missionIdList)
+		if (ms->success)
 		{
-			if (missionId == ms->id)
-			{
-				if (ms->success)
-				{
-					winTotal++;
-				}
-			}
+			winTotal++;
 		}
 	}
 
@@ -890,17 +941,7 @@ int SoldierDiary::getWinTotal(std::vector<MissionStatistics*> *missionStatistics
  */
 int SoldierDiary::getStunTotal() const
 {
-	int stunTotal = 0;
-
-	for (const auto* buk : _killList)
-	{
-		if (buk->status == STATUS_UNCONSCIOUS && buk->faction == FACTION_HOSTILE)
-		{
-			stunTotal++;
-		}
-	}
-
-	return stunTotal;
+	return updateKillTotals().stunTotal;
 }
 
 /**
@@ -908,17 +949,7 @@ int SoldierDiary::getStunTotal() const
  */
 int SoldierDiary::getPanickTotal() const
 {
-	int panickTotal = 0;
-
-	for (const auto* buk : _killList)
-	{
-		if (buk->status == STATUS_PANICKING && buk->faction == FACTION_HOSTILE)
-		{
-			panickTotal++;
-		}
-	}
-
-	return panickTotal;
+	return updateKillTotals().panickTotal;
 }
 
 /**
@@ -926,17 +957,7 @@ int SoldierDiary::getPanickTotal() const
  */
 int SoldierDiary::getControlTotal() const
 {
-	int controlTotal = 0;
-
-	for (const auto* buk : _killList)
-	{
-		if (buk->status == STATUS_TURNING && buk->faction == FACTION_HOSTILE)
-		{
-			controlTotal++;
-		}
-	}
-
-	return controlTotal;
+	return updateKillTotals().controlTotal;
 }
 
 /**
@@ -1027,18 +1048,7 @@ int SoldierDiary::getAccuracy() const
  */
 int SoldierDiary::getTrapKillTotal(Mod *mod) const
 {
-	int trapKillTotal = 0;
-
-	for (const auto* buk : _killList)
-	{
-		RuleItem *item = mod->getItem(buk->weapon);
-		if (buk->hostileTurn() && (item == 0 || item->getBattleType() == BT_GRENADE || item->getBattleType() == BT_PROXIMITYGRENADE))
-		{
-			trapKillTotal++;
-		}
-	}
-
-	return trapKillTotal;
+	return updateKillTypeTotals(mod).trapKillTotal;
 }
 
 /**
@@ -1046,18 +1056,7 @@ int SoldierDiary::getTrapKillTotal(Mod *mod) const
  */
  int SoldierDiary::getReactionFireKillTotal(Mod *mod) const
  {
-	int reactionFireKillTotal = 0;
-
-	for (const auto* buk : _killList)
-	{
-		RuleItem *item = mod->getItem(buk->weapon);
-		if (buk->hostileTurn() && item != 0 && item->getBattleType() != BT_GRENADE && item->getBattleType() != BT_PROXIMITYGRENADE)
-		{
-			reactionFireKillTotal++;
-		}
-	}
-
-	return reactionFireKillTotal;
+	return updateKillTypeTotals(mod).reactionFireKillTotal;
  }
 
 /**
@@ -1069,17 +1068,11 @@ int SoldierDiary::getTerrorMissionTotal(std::vector<MissionStatistics*> *mission
 	/// Not a UFO, not the base, not the alien base or colony
 	int terrorMissionTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
+		if (ms->success && !ms->isBaseDefense() && !ms->isUfoMission() && !ms->isAlienBase())
 		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && !ms->isBaseDefense() && !ms->isUfoMission() && !ms->isAlienBase())
-				{
-					terrorMissionTotal++;
-				}
-			}
+			terrorMissionTotal++;
 		}
 	}
 
@@ -1094,17 +1087,11 @@ int SoldierDiary::getNightMissionTotal(std::vector<MissionStatistics*> *missionS
 {
 	int nightMissionTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
+		if (ms->success && ms->isDarkness(mod) && !ms->isBaseDefense() && !ms->isAlienBase())
 		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->isDarkness(mod) && !ms->isBaseDefense() && !ms->isAlienBase())
-				{
-					nightMissionTotal++;
-				}
-			}
+			nightMissionTotal++;
 		}
 	}
 
@@ -1119,17 +1106,11 @@ int SoldierDiary::getNightTerrorMissionTotal(std::vector<MissionStatistics*> *mi
 {
 	int nightTerrorMissionTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
+		if (ms->success && ms->isDarkness(mod) && !ms->isBaseDefense() && !ms->isUfoMission() && !ms->isAlienBase())
 		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->isDarkness(mod) && !ms->isBaseDefense() && !ms->isUfoMission() && !ms->isAlienBase())
-				{
-					nightTerrorMissionTotal++;
-				}
-			}
+			nightTerrorMissionTotal++;
 		}
 	}
 
@@ -1144,17 +1125,11 @@ int SoldierDiary::getBaseDefenseMissionTotal(std::vector<MissionStatistics*> *mi
 {
 	int baseDefenseMissionTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
+		if (ms->success && ms->isBaseDefense())
 		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->isBaseDefense())
-				{
-					baseDefenseMissionTotal++;
-				}
-			}
+			baseDefenseMissionTotal++;
 		}
 	}
 
@@ -1169,17 +1144,11 @@ int SoldierDiary::getAlienBaseAssaultTotal(std::vector<MissionStatistics*> *miss
 {
 	int alienBaseAssaultTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
+		if (ms->success && ms->isAlienBase())
 		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->isAlienBase())
-				{
-					alienBaseAssaultTotal++;
-				}
-			}
+			alienBaseAssaultTotal++;
 		}
 	}
 
@@ -1194,17 +1163,11 @@ int SoldierDiary::getImportantMissionTotal(std::vector<MissionStatistics*> *miss
 {
 	int importantMissionTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
+		if (ms->success && ms->type != "STR_UFO_CRASH_RECOVERY")
 		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->type != "STR_UFO_CRASH_RECOVERY")
-				{
-					importantMissionTotal++;
-				}
-			}
+			importantMissionTotal++;
 		}
 	}
 
@@ -1219,15 +1182,9 @@ int SoldierDiary::getScoreTotal(std::vector<MissionStatistics*> *missionStatisti
 {
 	int scoreTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id)
-			{
-				scoreTotal += ms->score;
-			}
-		}
+		scoreTotal += ms->score;
 	}
 
 	return scoreTotal;
@@ -1241,14 +1198,11 @@ int SoldierDiary::getValiantCruxTotal(std::vector<MissionStatistics*> *missionSt
 {
 	int valiantCruxTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
+		if (ms->valiantCrux)
 		{
-			if (misionId == ms->id && ms->valiantCrux)
-			{
-				valiantCruxTotal++;
-			}
+			valiantCruxTotal++;
 		}
 	}
 
@@ -1263,15 +1217,9 @@ int SoldierDiary::getLootValueTotal(std::vector<MissionStatistics*> *missionStat
 {
 	int lootValueTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto* ms : updateMissions(missionStatistics))
 	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id)
-			{
-				lootValueTotal += ms->lootValue;
-			}
-		}
+		lootValueTotal += ms->lootValue;
 	}
 
 	return lootValueTotal;
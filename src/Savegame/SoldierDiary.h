@@ -76,6 +76,18 @@ public:
 class SoldierDiary
 {
 private:
+	/// Totals derived from the kill and mission lists, brought up to date as the lists grow.
+	/// The lists are only changed by load(), which starts the totals over, and updateDiary(), which appends.
+	struct Totals
+	{
+		const std::vector<MissionStatistics*> *missionStatistics = nullptr;
+		size_t missionStatisticsSize = 0, missionIds = 0, kills = 0, modKills = 0;
+		const Mod *mod = nullptr;
+		std::vector<const MissionStatistics*> missions, uniqueMissions;
+		std::map<std::string, int> rank, race, weapon, weaponAmmo;
+		int killTotal = 0, stunTotal = 0, panickTotal = 0, controlTotal = 0, trapKillTotal = 0, reactionFireKillTotal = 0;
+	};
+	mutable Totals _totals;
 	std::vector<SoldierCommendations*> _commendations;
 	std::vector<BattleUnitKills*> _killList;
 	std::vector<int> _missionIdList;
@@ -85,6 +97,12 @@ private:
 		_woundsHealedTotal, _allUFOs, _allMissionTypes, _statGainTotal, _revivedUnitTotal, _wholeMedikitTotal, _braveryGainTotal, _bestOfRank, _MIA,
 		_martyrKillsTotal, _postMortemKills, _slaveKillsTotal, _bestSoldier, _revivedSoldierTotal, _revivedHostileTotal, _revivedNeutralTotal;
 	bool _globeTrotter;
+	/// Brings the kill totals up to date.
+	const Totals &updateKillTotals() const;
+	/// Brings the trap and reaction fire kill totals up to date.
+	const Totals &updateKillTypeTotals(const Mod *mod) const;
+	/// Brings the list of the soldier's missions up to date.
+	const std::vector<const MissionStatistics*> &updateMissions(const std::vector<MissionStatistics*> *missionStatistics) const;
 public:
 	/// Construct a diary.
 	SoldierDiary();
@@ -137,9 +155,9 @@ public:
 	/// Get the total months in service.
 	int getMonthsService() const;
 	/// Get the mission id list.
-	std::vector<int> &getMissionIdList();
+	const std::vector<int> &getMissionIdList() const;
 	/// Get the kill list.
-	std::vector<BattleUnitKills*> &getKills();
+	const std::vector<BattleUnitKills*> &getKills() const;
 	/// Award special commendation to the original 8 soldiers.
 	void awardOriginalEightCommendation(const Mod* mod);
 	/// Award posthumous best-of rank commendation.
@@ -71,6 +71,45 @@ Tile::Tile(Position pos, SavedBattleGame* save): _save(save), _pos(pos)
 	_cache.isNoFloor = 1;
 	_cache.isGravLift = 0;
 	_cache.isLadder = 0;
+	// the battle's compact tile data starts out matching an empty tile
+}
+
+/**
+ * Copies the terrain level of the tile to the compact arrays
+ * of the battle. Each of these only copies the field that
+ * changed, as some change in the lighting and smoke loops.
+ */
+void Tile::updateHotTerrainLevel()
+{
+	_save->getTileHotData().terrainLevel[_save->getTileIndex(_pos)] = _cache.terrainLevel;
+}
+
+/**
+ * Copies the smoke of the tile to the compact arrays of the battle.
+ */
+void Tile::updateHotSmoke()
+{
+	_save->getTileHotData().smoke[_save->getTileIndex(_pos)] = _smoke;
+}
+
+/**
+ * Copies the fire of the tile to the compact arrays of the battle.
+ */
+void Tile::updateHotFire()
+{
+	_save->getTileHotData().fire[_save->getTileIndex(_pos)] = _fire;
+}
+
+/**
+ * Copies the light of the tile to the compact arrays of the battle.
+ */
+void Tile::updateHotLight()
+{
+	Uint8 *light = &_save->getTileHotData().light[_save->getTileIndex(_pos) * LL_MAX];
+	for (int layer = 0; layer < LL_MAX; layer++)
+	{
+		light[layer] = _light[layer];
+	}
 }
 
 /**
@@ -95,6 +134,10 @@ void Tile::load(const YAML::Node &node)
 	}
 	_fire = node["fire"].as<int>(_fire);
 	_smoke = node["smoke"].as<int>(_smoke);
+	if (_fire)
+		_save->addFireTile(this);
+	if (_smoke)
+		_save->addSmokeTile(this);
 	if (node["discovered"])
 	{
 		for (int i = 0; i < 3; i++)
@@ -115,6 +158,8 @@ void Tile::load(const YAML::Node &node)
 	{
 		_animationOffset = RNG::seedless(0, 3);
 	}
+	updateHotSmoke();
+	updateHotFire();
 }
 
 /**
@@ -135,6 +180,10 @@ void Tile::loadBinary(Uint8 *buffer, Tile::SerializationKey& serKey)
 
 	_smoke = unserializeInt(&buffer, serKey._smoke);
 	_fire = unserializeInt(&buffer, serKey._fire);
+	if (_fire)
+		_save->addFireTile(this);
+	if (_smoke)
+		_save->addSmokeTile(this);
 
 	Uint8 boolFields = unserializeInt(&buffer, serKey.boolFields);
 	_objectsCache[O_WESTWALL].discovered = (boolFields & 1) ? 1 : 0;
@@ -146,6 +195,8 @@ void Tile::loadBinary(Uint8 *buffer, Tile::SerializationKey& serKey)
 	{
 		_animationOffset = RNG::seedless(0, 3);
 	}
+	updateHotSmoke();
+	updateHotFire();
 }
 
 
@@ -251,6 +302,7 @@ void Tile::setMapData(MapData *dat, int mapDataID, int mapDataSetID, TilePart pa
 			_cache.bigWall = 0;
 		}
 		_cache.terrainLevel = level;
+		updateHotTerrainLevel();
 	}
 	if (part == O_WESTWALL || part == O_NORTHWALL || part == O_OBJECT)
 	{
@@ -451,6 +503,7 @@ bool Tile::isDiscovered(TilePart part) const
 void Tile::resetLight(LightLayers layer)
 {
 	_light[layer] = 0;
+	updateHotLight();
 }
 
 /**
@@ -463,6 +516,7 @@ void Tile::resetLightMulti(LightLayers layer)
 	{
 		_light[l] = 0;
 	}
+	updateHotLight();
 }
 
 /**
@@ -473,7 +527,10 @@ void Tile::resetLightMulti(LightLayers layer)
 void Tile::addLight(int light, LightLayers layer)
 {
 	if (_light[layer] < light)
+	{
 		_light[layer] = light;
+		updateHotLight();
+	}
 }
 
 /**
@@ -676,6 +733,10 @@ void Tile::ignite(int power)
 				_overlaps = 1;
 				_fire = getFuel() + 1;
 				_animationOffset = RNG::generate(0,3);
+				_save->addFireTile(this);
+				_save->addSmokeTile(this);
+				updateHotSmoke();
+				updateHotFire();
 			}
 		}
 	}
@@ -755,6 +816,9 @@ void Tile::setFire(int fire)
 {
 	_fire = Clamp(fire, 0, 255);
 	_animationOffset = RNG::generate(0,3);
+	if (_fire)
+		_save->addFireTile(this);
+	updateHotFire();
 }
 
 /**
@@ -784,6 +848,8 @@ void Tile::addSmoke(int smoke)
 		}
 		_animationOffset = RNG::generate(0,3);
 		addOverlap();
+		_save->addSmokeTile(this);
+		updateHotSmoke();
 	}
 }
 
@@ -795,6 +861,9 @@ void Tile::setSmoke(int smoke)
 {
 	_smoke = Clamp(smoke, 0, 255);
 	_animationOffset = RNG::generate(0,3);
+	if (_smoke)
+		_save->addSmokeTile(this);
+	updateHotSmoke();
 }
 
 
@@ -924,6 +993,7 @@ void Tile::prepareNewTurn(bool smokeDamage)
 	if ( _overlaps != 0 && _smoke != 0 && _fire == 0)
 	{
 		_smoke = Clamp((_smoke / _overlaps) - 1, 0, 15);
+		updateHotSmoke();
 	}
 	// if we still have smoke/fire
 	if (_smoke)
@@ -1061,6 +1131,8 @@ void Tile::addOverlap()
 void Tile::setDangerous(bool danger)
 {
 	_cache.danger = danger;
+	if (danger)
+		_save->addDangerousTile(this);
 }
 
 /**
@@ -131,6 +131,14 @@ protected:
 	Sint8 _preview = -1;
 	Uint8 _overlaps = 0;
 
+	/// Copies the terrain level to the battle's compact tile data.
+	void updateHotTerrainLevel();
+	/// Copies the smoke to the battle's compact tile data.
+	void updateHotSmoke();
+	/// Copies the fire to the battle's compact tile data.
+	void updateHotFire();
+	/// Copies the light to the battle's compact tile data.
+	void updateHotLight();
 
 public:
 	/// Creates a tile.
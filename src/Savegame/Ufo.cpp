@@ -202,25 +202,15 @@ void Ufo::finishLoading(const YAML::Node &node, SavedGame &save)
 		{
 			std::string type = dest["type"].as<std::string>();
 			int id = dest["id"].as<int>();
-			bool found = false;
-			for (auto* xbase : *save.getBases())
+			if (Craft *xcraft = save.getCraft(CraftId(type, id)))
 			{
-				for (auto* xcraft : *xbase->getCrafts())
+				if (_dest)
 				{
-					if (xcraft->getId() == id && xcraft->getRules()->getType() == type)
-					{
-						if (_dest)
-						{
-							// this is just a dummy waypoint created during normal loading, not a craft... yet
-							delete _dest;
-							_dest = 0;
-						}
-						setDestination(xcraft);
-						found = true;
-						break;
-					}
+					// this is just a dummy waypoint created during normal loading, not a craft... yet
+					delete _dest;
+					_dest = 0;
 				}
-				if (found) break;
+				setDestination(xcraft);
 			}
 		}
 	}
@@ -234,19 +224,15 @@ void Ufo::finishLoading(const YAML::Node &node, SavedGame &save)
 				int uniqueUfoId = dest["uniqueId"].as<int>(0);
 				if (uniqueUfoId > 0)
 				{
-					for (auto* ufo : *save.getUfos())
+					if (Ufo *ufo = save.getUfoByUniqueId(uniqueUfoId))
 					{
-						if (ufo->getUniqueId() == uniqueUfoId)
+						if (_dest)
 						{
-							if (_dest)
-							{
-								// this is just a dummy waypoint created during normal loading, not a UFO... yet
-								delete _dest;
-								_dest = 0;
-							}
-							setDestination(ufo);
-							break;
+							// this is just a dummy waypoint created during normal loading, not a UFO... yet
+							delete _dest;
+							_dest = 0;
 						}
+						setDestination(ufo);
 					}
 				}
 			}
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "UnitGrid.h"
+#include <algorithm>
+#include "BattleUnit.h"
+#include "Tile.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty grid.
+ * @param units Pointer to the battle's unit list, which sets the order of the results.
+ */
+UnitGrid::UnitGrid(const std::vector<BattleUnit*> *units) : _units(units), _width(0), _height(0)
+{
+}
+
+/**
+ * Removes all the units and sizes the grid to cover a map.
+ * @param mapSizeX Map width in tiles.
+ * @param mapSizeY Map length in tiles.
+ */
+void UnitGrid::reset(int mapSizeX, int mapSizeY)
+{
+	_width = (mapSizeX + CELL_SIZE - 1) / CELL_SIZE;
+	_height = (mapSizeY + CELL_SIZE - 1) / CELL_SIZE;
+	_cells.clear();
+	_cells.resize(_width * _height);
+	_unitCells.clear();
+	_order.clear();
+}
+
+/**
+ * Removes a unit from the cell it's filed under, if any.
+ * @param unit The unit.
+ */
+void UnitGrid::remove(const BattleUnit *unit)
+{
+	auto i = _unitCells.find(unit);
+	if (i != _unitCells.end())
+	{
+		auto& cell = _cells[i->second];
+		cell.erase(std::find(cell.begin(), cell.end(), unit));
+		_unitCells.erase(i);
+	}
+}
+
+/**
+ * Files a unit under the cell of the tile it now stands on.
+ * Big units go by their top left tile like their position.
+ * @param unit The unit.
+ * @param tile The tile, or null if the unit left the map.
+ */
+void UnitGrid::update(BattleUnit *unit, const Tile *tile)
+{
+	int index = -1;
+	if (tile && !_cells.empty())
+	{
+		Position pos = tile->getPosition();
+		index = (pos.y / CELL_SIZE) * _width + pos.x / CELL_SIZE;
+	}
+	auto i = _unitCells.find(unit);
+	if (i != _unitCells.end() && i->second == index)
+	{
+		return;
+	}
+	remove(unit);
+	if (index != -1)
+	{
+		_cells[index].push_back(unit);
+		_unitCells[unit] = index;
+	}
+}
+
+/**
+ * Gets where a unit is in the battle's unit list. The positions are
+ * remembered, and worked out again whenever the list has changed.
+ * @param unit The unit.
+ * @return Index in the list.
+ */
+size_t UnitGrid::getOrder(const BattleUnit *unit) const
+{
+	auto i = _order.find(unit);
+	if (i == _order.end() || i->second >= _units->size() || (*_units)[i->second] != unit)
+	{
+		_order.clear();
+		for (size_t n = 0; n < _units->size(); ++n)
+		{
+			_order[(*_units)[n]] = n;
+		}
+		i = _order.find(unit);
+		if (i == _order.end())
+		{
+			return _units->size();
+		}
+	}
+	return i->second;
+}
+
+/**
+ * Gets all the units filed in the cells within a range of a position.
+ * This includes some units further away, so callers must still check
+ * the distance themselves, but no unit standing in range is left out.
+ * @param center Center position.
+ * @param range Range in tiles.
+ * @param result Vector to fill with the units, in the order of the battle's unit list.
+ */
+void UnitGrid::findInRange(Position center, int range, std::vector<BattleUnit*> &result) const
+{
+	result.clear();
+	if (_cells.empty())
+	{
+		return;
+	}
+	range += MARGIN;
+	const int beginX = std::max((center.x - range) / CELL_SIZE, 0);
+	const int endX = std::min((center.x + range) / CELL_SIZE, _width - 1);
+	const int beginY = std::max((center.y - range) / CELL_SIZE, 0);
+	const int endY = std::min((center.y + range) / CELL_SIZE, _height - 1);
+	for (int y = beginY; y <= endY; ++y)
+	{
+		for (int x = beginX; x <= endX; ++x)
+		{
+			const auto& cell = _cells[y * _width + x];
+			result.insert(result.end(), cell.begin(), cell.end());
+		}
+	}
+	std::sort(result.begin(), result.end(), [&](const BattleUnit *a, const BattleUnit *b) { return getOrder(a) < getOrder(b); });
+}
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <unordered_map>
+#include <vector>
+#include "../Battlescape/Position.h"
+
+namespace OpenXcom
+{
+
+class BattleUnit;
+class Tile;
+
+/**
+ * Files the units standing on the map into a coarse grid of cells,
+ * so code looking for the units around a position doesn't have to go
+ * through every unit of the battle. Kept up to date by BattleUnit::setTile().
+ * Queries return every unit in the cells overlapping the range, in the
+ * same order as the battle's unit list, so callers still do their own
+ * exact checks and get the same results as when looping over all units.
+ */
+class UnitGrid
+{
+private:
+	/// Size of a cell in tiles.
+	static const int CELL_SIZE = 8;
+	/// Extra tiles added to every query, for units half way through a step.
+	static const int MARGIN = 2;
+
+	const std::vector<BattleUnit*> *_units;
+	int _width, _height;
+	std::vector<std::vector<BattleUnit*> > _cells;
+	std::unordered_map<const BattleUnit*, int> _unitCells;
+	mutable std::unordered_map<const BattleUnit*, size_t> _order;
+
+	/// Removes a unit from its cell.
+	void remove(const BattleUnit *unit);
+	/// Gets the position of a unit in the battle's unit list.
+	size_t getOrder(const BattleUnit *unit) const;
+public:
+	/// Creates an empty grid.
+	UnitGrid(const std::vector<BattleUnit*> *units);
+	/// Empties the grid and sizes it for a map.
+	void reset(int mapSizeX, int mapSizeY);
+	/// Files a unit under the tile it stands on.
+	void update(BattleUnit *unit, const Tile *tile);
+	/// Gets the units that may be within a range of a position.
+	void findInRange(Position center, int range, std::vector<BattleUnit*> &result) const;
+};
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * What one unit can see, as bits over the unit and tile indexes
+ * of the battle, so checking and updating it is a bit operation
+ * instead of a search. The units and tiles are still listed in
+ * BattleUnit, since the AI and the UI go through them in the order
+ * they were seen. SavedBattleGame keeps one for every unit it creates.
+ */
+struct UnitVisibility
+{
+	/// Units in view, by unit visibility index.
+	std::vector<Uint64> units;
+	/// Units spotted this turn, by unit visibility index.
+	std::vector<Uint64> spotted;
+	/// Tiles in view, by tile index.
+	std::vector<Uint64> tiles;
+
+	/**
+	 * Sets a bit, making room for it if needed.
+	 * @param bits Bits to change.
+	 * @param i Index of the bit.
+	 * @return True if the bit wasn't set before.
+	 */
+	static bool set(std::vector<Uint64> &bits, size_t i)
+	{
+		size_t word = i / 64;
+		if (word >= bits.size())
+		{
+			bits.resize(word + 1, 0);
+		}
+		Uint64 mask = (Uint64)1 << (i % 64);
+		bool added = (bits[word] & mask) == 0;
+		bits[word] |= mask;
+		return added;
+	}
+
+	/**
+	 * Clears a bit.
+	 * @param bits Bits to change.
+	 * @param i Index of the bit.
+	 * @return True if the bit was set before.
+	 */
+	static bool reset(std::vector<Uint64> &bits, size_t i)
+	{
+		size_t word = i / 64;
+		if (word >= bits.size())
+		{
+			return false;
+		}
+		Uint64 mask = (Uint64)1 << (i % 64);
+		bool removed = (bits[word] & mask) != 0;
+		bits[word] &= ~mask;
+		return removed;
+	}
+
+	/**
+	 * Checks a bit.
+	 * @param bits Bits to check.
+	 * @param i Index of the bit.
+	 * @return True if the bit is set.
+	 */
+	static bool test(const std::vector<Uint64> &bits, size_t i)
+	{
+		size_t word = i / 64;
+		return word < bits.size() && (bits[word] & ((Uint64)1 << (i % 64))) != 0;
+	}
+
+	/**
+	 * Clears all the bits, keeping the memory for next time.
+	 * @param bits Bits to change.
+	 */
+	static void clear(std::vector<Uint64> &bits)
+	{
+		std::fill(bits.begin(), bits.end(), 0);
+	}
+
+	/**
+	 * Counts the bits that are set.
+	 * @param bits Bits to count.
+	 * @return Number of bits set.
+	 */
+	static size_t count(const std::vector<Uint64> &bits)
+	{
+		size_t total = 0;
+		for (Uint64 word : bits)
+		{
+			total += std::bitset<64>(word).count();
+		}
+		return total;
+	}
+};
+
+}
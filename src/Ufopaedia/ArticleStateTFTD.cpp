@@ -77,7 +77,7 @@ namespace OpenXcom
 			else
 				_cursorColor = Mod::BATTLESCAPE_CURSOR;
 
-			setCustomPalette(_game->getMod()->getSurface(defs->image_id)->getPalette(), _cursorColor);
+			setCustomPalette(_game->getMod()->getStateSurface(defs->image_id)->getPalette(), _cursorColor);
 		}
 		else
 		{
@@ -129,7 +129,7 @@ namespace OpenXcom
 		}
 
 		// Step 2: article image (optional)
-		Surface *image = _game->getMod()->getSurface(defs->image_id, false);
+		Surface *image = _game->getMod()->getStateSurface(defs->image_id, false);
 		if (image)
 		{
 			image->blitNShade(_bg, 0, 0);
@@ -53,7 +53,7 @@ namespace OpenXcom
 		// Set palette
 		if (defs->customPalette)
 		{
-			setCustomPalette(_game->getMod()->getSurface(defs->image_id)->getPalette(), Mod::UFOPAEDIA_CURSOR);
+			setCustomPalette(_game->getMod()->getStateSurface(defs->image_id)->getPalette(), Mod::UFOPAEDIA_CURSOR);
 		}
 		else
 		{
@@ -70,7 +70,7 @@ namespace OpenXcom
 		// Set up objects
 		if (!defs->image_id.empty())
 		{
-			_game->getMod()->getSurface(defs->image_id)->blitNShade(_bg, 0, 0);
+			_game->getMod()->getStateSurface(defs->image_id)->blitNShade(_bg, 0, 0);
 		}
 		else
 		{
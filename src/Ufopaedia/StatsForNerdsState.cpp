@@ -216,6 +216,7 @@ void StatsForNerdsState::buildUI(bool debug, bool ids, bool defaults)
 
 	_lstRawData->setColumns(2, 110, 177);
 	_lstRawData->setSelectable(true);
+	_lstRawData->setVirtual(true);
 	_lstRawData->setBackground(_window);
 	_lstRawData->setWordWrap(true);
 
@@ -440,7 +441,7 @@ void StatsForNerdsState::btnPreviewClick(Action *)
 			// we use NEGATIVE soldier IDs to make sure there is not even a theoretical chance of modifying real geoscape soldiers during the preview
 			int newId = -(i + 1);
 			Soldier* soldier = new Soldier(soldierRule, defaultArmor, 0 /*nationality*/, newId);
-			base->getSoldiers()->push_back(soldier);
+			base->addSoldier(soldier);
 			soldier->setName("Position" + std::to_string(newId));
 		}
 	}
@@ -450,16 +451,17 @@ void StatsForNerdsState::btnPreviewClick(Action *)
 		{
 			soldier->setCraft(nullptr);
 		}
-		for (auto* craft : *base->getCrafts())
+		while (!base->getCrafts()->empty())
 		{
+			Craft *craft = base->getCrafts()->back();
+			base->removeCraft(craft, false);
 			delete craft;
 		}
-		base->getCrafts()->clear();
 	}
 	// and finally create the craft we need
 	RuleCraft* craftRule = mod->getCraft(_topicId);
 	Craft* c = new Craft(craftRule, base, RuleCraft::DUMMY_CRAFT_ID); // a negative integer
-	base->getCrafts()->push_back(c);
+	base->addCraft(c);
 	c->setName(tr(craftRule->getType()));
 	int max = craftRule->getMaxUnits();
 	for (auto* soldier : *base->getSoldiers())
@@ -41,6 +41,9 @@ namespace OpenXcom
 
 		_screen = false;
 
+		// article backgrounds, so the first article opens without a stall
+		_game->getMod()->prefetchSurfaces({ "BACK08.SCR", "BACK09.SCR", "BACK10.SCR", "BACK11.SCR", "INTERWIN.DAT", "BASEBITS.PCK", "BIGOBS.PCK" });
+
 		int extraSpace = (_game->getScreen()->getDY() * 2) + 20; // upper extra + lower extra + 20 pixels from the original
 		int maxButtons = (extraSpace / SPACE_PER_BUTTON) + MAX_VANILLA_BUTTONS;
 		_maxButtons = std::min(_cats.size(), (size_t)maxButtons);